@@ -0,0 +1,51 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <unordered_map>
+#include <map>
+
+using namespace Limitless;
+
+TEST_CASE("ContextState cached binds", "[benchmark]") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    BufferBuilder builder;
+    auto uniform = builder.setTarget(Buffer::Type::Uniform)
+                          .setUsage(Buffer::Usage::StaticDraw)
+                          .setAccess(Buffer::MutableAccess::None)
+                          .setData(nullptr)
+                          .setDataSize(256)
+                          .build();
+
+    auto storage = builder.setTarget(Buffer::Type::ShaderStorage)
+                          .build();
+
+    uniform->bindBase(3);
+    storage->bindBase(4);
+
+    // lookups that every bind did before state was cached in flat arrays and thread-local pointer
+    std::unordered_map<GLFWwindow*, ContextState*> state_map {{context, &context}};
+    std::map<std::pair<Buffer::Type, GLuint>, GLuint> point_map {{{Buffer::Type::Uniform, 3}, uniform->getId()}};
+
+    BENCHMARK("map lookups of state and binding point") {
+        return state_map.at(glfwGetCurrentContext()) != nullptr && point_map[{Buffer::Type::Uniform, 3}] == uniform->getId();
+    };
+
+    BENCHMARK("ContextState::getState") {
+        return ContextState::getState(glfwGetCurrentContext());
+    };
+
+    BENCHMARK("Buffer::bind") {
+        uniform->bind();
+    };
+
+    BENCHMARK("Buffer::bindBase") {
+        uniform->bindBase(3);
+        storage->bindBase(4);
+    };
+
+    BENCHMARK("ContextState::enable") {
+        context.enable(Capabilities::DepthTest);
+    };
+}
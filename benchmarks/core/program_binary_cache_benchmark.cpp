@@ -0,0 +1,51 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+
+using namespace Limitless;
+
+namespace {
+    // engine programs compiled on startup before any material
+    void compilePrograms(Context& context) {
+        const auto shader_dir = fs::path{ENGINE_ASSETS_DIR} / "../shaders";
+
+        ShaderCompiler compiler {context};
+        for (const auto* name : { "postprocessing/blur", "postprocessing/brightness", "postprocessing/postprocess", "pipeline/text", "pipeline/text_selection" }) {
+            [[maybe_unused]] auto program = compiler.compile(shader_dir / name);
+        }
+    }
+}
+
+TEST_CASE("Program compilation with binary cache", "[benchmark]") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    if (!ProgramBinaryCache::isSupported()) {
+        return;
+    }
+
+    const auto cache = std::make_shared<ProgramBinaryCache>(fs::temp_directory_path() / "limitless_program_cache_benchmark");
+
+    BENCHMARK("without cache") {
+        compilePrograms(context);
+    };
+
+    ShaderCompiler::setBinaryCache(cache);
+
+    // every program is compiled, linked and stored
+    BENCHMARK("cold cache") {
+        cache->clear();
+        compilePrograms(context);
+    };
+
+    compilePrograms(context);
+
+    BENCHMARK("warm cache") {
+        compilePrograms(context);
+    };
+
+    ShaderCompiler::setBinaryCache(nullptr);
+    cache->clear();
+}
@@ -0,0 +1,53 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/fx/particle.hpp>
+
+using namespace Limitless;
+
+namespace {
+    // per-frame vertex upload of sprite emitter with given particle count
+    std::vector<fx::SpriteParticle> makeParticles(size_t count) {
+        std::vector<fx::SpriteParticle> particles(count);
+        for (size_t i = 0; i < count; ++i) {
+            particles[i].getPosition() = glm::vec3{static_cast<float>(i)};
+        }
+        return particles;
+    }
+}
+
+TEST_CASE("Stream vertex upload: orphaning vs triple buffer", "[benchmark]") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    for (const auto count : {1'000u, 10'000u, 100'000u}) {
+        const auto particles = makeParticles(count);
+        const auto size = particles.size() * sizeof(fx::SpriteParticle);
+
+        BufferBuilder builder;
+        builder.setTarget(Buffer::Type::Array)
+               .setData(nullptr)
+               .setDataSize(size);
+
+        auto orphaning = builder.setUsage(Buffer::Usage::DynamicDraw)
+                                .setAccess(Buffer::MutableAccess::WriteOrphaning)
+                                .build();
+
+        auto triple = builder.buildTriple();
+
+        BENCHMARK("WriteOrphaning, particles " + std::to_string(count)) {
+            orphaning->mapData(particles.data(), size);
+            orphaning->bind();
+            glFlush();
+        };
+
+        BENCHMARK(std::string{triple->isPersistent() ? "persistent" : "unsynchronized"} + " TripleBuffer, particles " + std::to_string(count)) {
+            triple->mapData(particles.data(), size);
+            triple->bind();
+            triple->fence();
+            glFlush();
+        };
+
+        glFinish();
+    }
+}
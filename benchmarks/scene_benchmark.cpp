@@ -0,0 +1,64 @@
+#include "../tests/catch_amalgamated.hpp"
+
+#include <limitless/scene.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/pipeline/shader_pass_types.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Limitless;
+
+namespace {
+    // stands for skeletal animation: walks a chain of bones every update
+    class AnimatedInstance : public AbstractInstance {
+    private:
+        std::array<glm::mat4, 64> bones {};
+        float time {};
+    protected:
+        void calculateBoundingBox() noexcept override {
+            bounding_box = {position, glm::vec3{1.0f}};
+        }
+    public:
+        AnimatedInstance(Lighting* lighting, const glm::vec3& position)
+            : AbstractInstance(lighting, ModelShader::Model, position) {
+        }
+
+        AnimatedInstance* clone() noexcept override {
+            return new AnimatedInstance(*this);
+        }
+
+        void update(Context& context, Camera& camera) override {
+            AbstractInstance::update(context, camera);
+
+            time += 0.016f;
+            auto parent = glm::mat4{1.0f};
+            for (size_t i = 0; i < bones.size(); ++i) {
+                const auto local = glm::rotate(glm::translate(glm::mat4{1.0f}, glm::vec3{0.0f, 0.1f, 0.0f}), time + static_cast<float>(i), glm::vec3{0.0f, 1.0f, 0.0f});
+                parent = parent * local;
+                bones[i] = parent;
+            }
+        }
+
+        using AbstractInstance::draw;
+        void draw(Context&, const Assets&, ShaderPass, ms::Blending, const UniformSetter&) override {}
+    };
+}
+
+TEST_CASE("Scene update scaling over threads", "[benchmark]") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Camera camera {glm::uvec2{1, 1}};
+
+    Scene scene {context};
+    for (size_t i = 0; i < 10'000; ++i) {
+        scene.add<AnimatedInstance>(glm::vec3{static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100)});
+    }
+
+    for (const auto threads : {1u, 2u, 4u, 8u, 16u}) {
+        scene.setUpdateThreadCount(threads);
+
+        BENCHMARK("update 10k animated, threads " + std::to_string(threads)) {
+            scene.update(context, camera);
+            return scene.size();
+        };
+    }
+}
@@ -0,0 +1,99 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/util/aabb_tree.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+using namespace Limitless;
+
+namespace {
+    // scattered boxes on a plane, roughly like props in an open world
+    std::vector<BoundingBox> generateBoxes(size_t count) {
+        std::mt19937 generator {42};
+        const auto extent = std::sqrt(static_cast<float>(count)) * 10.0f;
+        std::uniform_real_distribution<float> position {-extent, extent};
+        std::uniform_real_distribution<float> size {0.5f, 4.0f};
+
+        std::vector<BoundingBox> boxes;
+        boxes.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            boxes.push_back({{position(generator), size(generator), position(generator)}, glm::vec3{size(generator)}});
+        }
+        return boxes;
+    }
+
+    bool overlaps(const BoundingBox& a, const BoundingBox& b) noexcept {
+        const auto distance = glm::abs(a.center - b.center);
+        const auto extent = (a.size + b.size) * 0.5f;
+        return distance.x <= extent.x && distance.y <= extent.y && distance.z <= extent.z;
+    }
+
+    void benchmarkQueries(size_t count) {
+        const auto boxes = generateBoxes(count);
+
+        AABBTree<size_t> tree;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            tree.insert(boxes[i], i);
+        }
+
+        const Frustum frustum {glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                               glm::lookAt(glm::vec3{0.0f, 2.0f, 0.0f}, glm::vec3{1.0f, 2.0f, 0.0f}, glm::vec3{0.0f, 1.0f, 0.0f})};
+        const BoundingBox area {glm::vec3{0.0f}, glm::vec3{50.0f}};
+
+        // both approaches have to agree before their timings mean anything
+        size_t linear_visible {};
+        for (const auto& box : boxes) {
+            linear_visible += frustum.intersects(box);
+        }
+
+        size_t tree_visible {};
+        tree.query(frustum, [&] (size_t i) { tree_visible += frustum.intersects(boxes[i]); });
+        REQUIRE(linear_visible == tree_visible);
+
+        BENCHMARK("frustum linear " + std::to_string(count)) {
+            size_t visible {};
+            for (const auto& box : boxes) {
+                visible += frustum.intersects(box);
+            }
+            return visible;
+        };
+
+        BENCHMARK("frustum tree " + std::to_string(count)) {
+            size_t visible {};
+            tree.query(frustum, [&] (size_t) { ++visible; });
+            return visible;
+        };
+
+        BENCHMARK("box linear " + std::to_string(count)) {
+            size_t found {};
+            for (const auto& box : boxes) {
+                found += overlaps(area, box);
+            }
+            return found;
+        };
+
+        BENCHMARK("box tree " + std::to_string(count)) {
+            size_t found {};
+            tree.query(area, [&] (size_t) { ++found; });
+            return found;
+        };
+
+        BENCHMARK("sphere tree " + std::to_string(count)) {
+            size_t found {};
+            tree.query(glm::vec3{0.0f}, 25.0f, [&] (size_t) { ++found; });
+            return found;
+        };
+
+        BENCHMARK("ray tree " + std::to_string(count)) {
+            size_t found {};
+            tree.raycast(glm::vec3{0.0f, 1.0f, 0.0f}, glm::normalize(glm::vec3{1.0f, 0.0f, 0.5f}), 1000.0f, [&] (size_t, float) { ++found; });
+            return found;
+        };
+    }
+}
+
+TEST_CASE("AABBTree queries against linear scan", "[benchmark]") {
+    SECTION("1k") { benchmarkQueries(1'000); }
+    SECTION("10k") { benchmarkQueries(10'000); }
+    SECTION("100k") { benchmarkQueries(100'000); }
+}
@@ -0,0 +1,67 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/util/job_system.hpp>
+#include <limitless/util/thread_pool.hpp>
+
+using namespace Limitless;
+
+namespace {
+    constexpr size_t job_count = 10'000;
+}
+
+TEST_CASE("JobSystem throughput against ThreadPool", "[benchmark]") {
+    const auto threads = std::max(std::thread::hardware_concurrency(), 2u);
+
+    ThreadPool pool {threads - 1};
+    JobSystem jobs {threads};
+
+    std::atomic<size_t> sum {};
+
+    JobCounter counter;
+    for (size_t i = 0; i < job_count; ++i) {
+        jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.wait(counter);
+    REQUIRE(sum == job_count);
+
+    BENCHMARK("ThreadPool " + std::to_string(job_count) + " jobs") {
+        std::vector<std::future<void>> futures;
+        futures.reserve(job_count);
+        for (size_t i = 0; i < job_count; ++i) {
+            futures.emplace_back(pool.add([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+        return sum.load();
+    };
+
+    BENCHMARK("JobSystem " + std::to_string(job_count) + " jobs") {
+        JobCounter group;
+        for (size_t i = 0; i < job_count; ++i) {
+            jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &group);
+        }
+        jobs.wait(group);
+        return sum.load();
+    };
+
+    BENCHMARK("JobSystem nested " + std::to_string(job_count) + " jobs") {
+        JobCounter group;
+        for (size_t i = 0; i < job_count / 100; ++i) {
+            jobs.run([&] {
+                for (size_t j = 0; j < 100; ++j) {
+                    jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &group);
+                }
+            }, &group);
+        }
+        jobs.wait(group);
+        return sum.load();
+    };
+
+    std::vector<float> data(job_count * 100, 1.0f);
+
+    BENCHMARK("JobSystem parallel_for " + std::to_string(data.size())) {
+        jobs.parallel_for(0, data.size(), 1024, [&] (size_t i) { data[i] = data[i] * 0.5f + 1.0f; });
+        return data[0];
+    };
+}
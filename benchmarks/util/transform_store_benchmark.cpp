@@ -0,0 +1,93 @@
+#include "../../tests/catch_amalgamated.hpp"
+
+#include <limitless/util/transform_store.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <random>
+
+using namespace Limitless;
+
+namespace {
+    struct Transform {
+        glm::vec3 position;
+        glm::quat rotation;
+        glm::vec3 scale;
+    };
+
+    std::vector<Transform> generateTransforms(size_t count) {
+        std::mt19937 generator {42};
+        std::uniform_real_distribution<float> position {-1000.0f, 1000.0f};
+        std::uniform_real_distribution<float> angle {0.0f, 6.28f};
+        std::uniform_real_distribution<float> scale {0.5f, 2.0f};
+
+        std::vector<Transform> transforms;
+        transforms.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            transforms.push_back({
+                {position(generator), position(generator), position(generator)},
+                glm::quat{glm::vec3{angle(generator), angle(generator), angle(generator)}},
+                {scale(generator), scale(generator), scale(generator)}
+            });
+        }
+        return transforms;
+    }
+
+    // what AbstractInstance::calculateModelMatrix does per instance
+    glm::mat4 compose(const Transform& transform) noexcept {
+        return glm::translate(glm::mat4{1.0f}, transform.position) * glm::toMat4(transform.rotation) * glm::scale(glm::mat4{1.0f}, transform.scale);
+    }
+
+    bool equal(const glm::mat4& a, const glm::mat4& b) noexcept {
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                if (std::abs(a[i][j] - b[i][j]) > 1e-3f) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void benchmarkComposition(size_t count) {
+        const auto transforms = generateTransforms(count);
+
+        TransformStore store;
+        std::vector<TransformStore::Handle> handles;
+        for (const auto& transform : transforms) {
+            handles.emplace_back(store.allocate(transform.position, transform.rotation, transform.scale));
+        }
+
+        REQUIRE(store.update() == count);
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(equal(store.getMatrix(handles[i]), compose(transforms[i])));
+        }
+
+        std::vector<glm::mat4> matrices(count);
+
+        BENCHMARK("per instance " + std::to_string(count)) {
+            for (size_t i = 0; i < count; ++i) {
+                matrices[i] = compose(transforms[i]);
+            }
+            return matrices.data();
+        };
+
+        BENCHMARK("store all " + std::to_string(count)) {
+            for (const auto handle : handles) {
+                store.setScale(handle, glm::vec3{1.0f});
+            }
+            return store.update();
+        };
+
+        BENCHMARK("store tenth " + std::to_string(count)) {
+            for (size_t i = 0; i < count; i += 10) {
+                store.setPosition(handles[i], glm::vec3{0.0f});
+            }
+            return store.update();
+        };
+    }
+}
+
+TEST_CASE("TransformStore composition against per instance matrices", "[benchmark]") {
+    SECTION("10k") { benchmarkComposition(10'000); }
+    SECTION("100k") { benchmarkComposition(100'000); }
+}
@@ -25,7 +25,11 @@
 #include <limitless/loaders/material_loader.hpp>
 #include <limitless/fx/modules/mesh_location.hpp>
 #include <limitless/fx/modules/mesh_location_attachment.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/pipeline/shader_warmup.hpp>
 #include <iostream>
+#include <set>
 
 using namespace Limitless;
 
@@ -47,6 +51,7 @@ private:
     ModelInstance* bob;
 
     AssetManager manager {context, assets};
+    ShaderWarmUp warm_up;
 public:
     Game()
         : context {"Limitless-demo", window_size, {{ WindowHint::Resizable, true }}}
@@ -70,6 +75,11 @@ public:
         context.registerObserver(static_cast<MouseMoveObserver*>(this));
         context.registerObserver(static_cast<FramebufferObserver*>(this));
 
+        // linked programs are reused between launches
+        if (ProgramBinaryCache::isSupported()) {
+            ShaderCompiler::setBinaryCache(std::make_shared<ProgramBinaryCache>(fs::temp_directory_path() / "limitless_program_cache"));
+        }
+
         assets.load(context);
 
 //        addModels();
@@ -79,6 +89,19 @@ public:
 //        addWarlocks();
 
         assets.compileShaders(context, render.getSettings());
+
+        // materials with equal features share a variant, so there are fewer variants than materials
+        std::set<uint64_t> variants;
+        size_t material_count {};
+        for (const auto& [name, material] : assets.materials) {
+            variants.emplace(material->getShaderIndex());
+            ++material_count;
+        }
+        std::cout << "materials: " << material_count << ", shader variants: " << variants.size()
+                  << ", material programs: " << assets.shaders.getMaterialShaders().size() << std::endl;
+
+        // draws programs once, so first frames do not wait for driver to compile them
+        warm_up.warm(context, assets);
 //        manager.compileShaders(context, render.getSettings());
 //        manager.wait();
 
@@ -923,6 +946,11 @@ EffectInstance* inst;
             render.getSettings().directional_csm = !render.getSettings().directional_csm;
             render.update(context, assets, scene);
         }
+
+        // rebuilds variants of edited shader files
+        if (key == GLFW_KEY_F5 && state == InputState::Pressed) {
+            assets.reloadShaders(context, render.getSettings());
+        }
     }
 
     void onFramebufferChange(glm::uvec2 size) override {
@@ -978,6 +1006,9 @@ EffectInstance* inst;
 
             updateEffect(delta);
 
+            // programs linked meanwhile and rebuilt by settings changes
+            warm_up.warm(context, assets, milliseconds{2});
+
             render.draw(context, assets, scene, camera);
             text->draw(context, assets);
 
@@ -985,6 +1016,12 @@ EffectInstance* inst;
             context.pollEvents();
             handleInput(delta);
         }
+
+        const auto& stats = context.getShaderStats();
+        std::cout << "first program uses: " << stats.first_uses << ", cold: " << stats.cold_uses
+                  << ", total: " << duration_cast<microseconds>(stats.first_use_time).count() << " us"
+                  << ", max: " << duration_cast<microseconds>(stats.max_first_use).count() << " us"
+                  << ", warmed: " << stats.warmed << " in " << duration_cast<microseconds>(stats.warm_up_time).count() << " us" << std::endl;
     }
 };
 
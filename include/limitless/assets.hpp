@@ -17,6 +17,7 @@ namespace Limitless {
     class FontAtlas;
     class Context;
     class RenderSettings;
+    class GeometryPool;
 
     class Assets {
     protected:
@@ -32,6 +33,9 @@ namespace Limitless {
         ResourceContainer<EffectInstance> effects;
         ResourceContainer<FontAtlas> fonts;
 
+        // static geometry of loaded models
+        std::shared_ptr<GeometryPool> geometry;
+
         explicit Assets(const fs::path& base_dir) noexcept;
         Assets(fs::path base_dir, fs::path shader_dir) noexcept;
 
@@ -47,6 +51,12 @@ namespace Limitless {
 
         void compileShaders(Context& ctx, const RenderSettings& settings);
         void recompileShaders(Context& ctx, const RenderSettings& settings);
+        // recompiles variants whose shader files changed on disk, previous variants are drawn until new ones are linked;
+        // shader errors are reported and previous variants are kept
+        void reloadShaders(Context& ctx, const RenderSettings& settings);
+        // recompiles variants that use defines changed between settings and compiles newly required ones,
+        // previous variants are drawn until new ones are linked
+        void updateShaders(Context& ctx, const RenderSettings& previous, const RenderSettings& settings);
 
         void add(const Assets& other);
 
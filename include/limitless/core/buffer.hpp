@@ -18,7 +18,8 @@ namespace Limitless {
             ShaderStorage = GL_SHADER_STORAGE_BUFFER,
             AtomicCounter = GL_ATOMIC_COUNTER_BUFFER,
             IndirectDraw = GL_DRAW_INDIRECT_BUFFER,
-            IndirectDispatch = GL_DISPATCH_INDIRECT_BUFFER
+            IndirectDispatch = GL_DISPATCH_INDIRECT_BUFFER,
+            Parameter = GL_PARAMETER_BUFFER_ARB
         };
 
         enum class Usage {
@@ -69,8 +70,8 @@ namespace Limitless {
         virtual void bufferSubData(GLintptr offset, size_t sub_size, const void* data) const noexcept = 0;
         virtual void mapData(const void* data, size_t data_size) = 0;
 
-        virtual void bindBufferRangeAs(Type target, GLuint index, GLintptr offset) const noexcept = 0;
-        virtual void bindBufferRange(GLuint index, GLintptr offset) const noexcept = 0;
+        virtual void bindBufferRangeAs(Type target, GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept = 0;
+        virtual void bindBufferRange(GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept = 0;
         virtual void bindBaseAs(Type target, GLuint index) const noexcept = 0;
         virtual void bindBase(GLuint index) const noexcept = 0;
         virtual void bindAs(Type target) const noexcept = 0;
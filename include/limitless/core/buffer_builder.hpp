@@ -1,6 +1,6 @@
 #pragma once
 
-#include <limitless/core/buffer.hpp>
+#include <limitless/core/triple_buffer.hpp>
 #include <memory>
 
 namespace Limitless {
@@ -25,5 +25,7 @@ namespace Limitless {
         std::unique_ptr<Buffer> build();
         // builds indexed buffer for specified context
         std::shared_ptr<Buffer> build(std::string_view name, ContextState& ctx);
+        // builds streaming buffer, usage and access are chosen by TripleBuffer itself
+        std::unique_ptr<TripleBuffer> buildTriple();
     };
 }
@@ -12,6 +12,12 @@ namespace Limitless {
         GLint shader_storage_max_count;
         GLint max_texture_units;
 
+        // offsets of ranges bound to indexed targets
+        GLint uniform_buffer_alignment {256};
+        GLint shader_storage_alignment {256};
+
+        GLint uniform_block_max_size {16384};
+
         GLfloat anisotropic_max {0.0f};
     };
 
@@ -23,6 +29,13 @@ namespace Limitless {
         static inline bool glfw_inited {};
         static inline bool glew_inited {};
 
+        // DSA is core since 4.5, drivers may not list the extension there
+        static inline bool direct_state_access {};
+        // separate vertex attribute format and buffer binding, core since 4.3
+        static inline bool vertex_attrib_binding {};
+        // programs are compiled and linked by driver threads, status is polled without blocking
+        static inline bool parallel_shader_compile {};
+
         static void initializeGLEW();
         static void initializeGLFW();
         static void getExtensions() noexcept;
@@ -39,6 +52,9 @@ namespace Limitless {
         static void defaultHints() noexcept;
         static void printExtensions() noexcept;
         static bool isExtensionSupported(std::string_view name) noexcept;
+        static bool isDirectStateAccessSupported() noexcept { return direct_state_access; }
+        static bool isVertexAttribBindingSupported() noexcept { return vertex_attrib_binding; }
+        static bool isParallelShaderCompileSupported() noexcept { return parallel_shader_compile; }
         static bool checkMinimumRequirements() noexcept;
     };
 }
\ No newline at end of file
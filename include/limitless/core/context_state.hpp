@@ -2,19 +2,24 @@
 
 #include <limitless/core/context_debug.hpp>
 #include <limitless/core/indexed_buffer.hpp>
+#include <limitless/core/texture_binder.hpp>
+#include <limitless/core/vertex_array.hpp>
+#include <limitless/core/ring_buffer.hpp>
+#include <limitless/core/sync.hpp>
 #include <limitless/core/buffer.hpp>
 #include <unordered_map>
 #include <glm/glm.hpp>
+#include <atomic>
+#include <vector>
 #include <mutex>
+#include <array>
 #include <map>
 
-namespace Limitless {
-    struct BindingPoint {
-        Buffer::Type target;
-        GLuint point;
-    };
-    bool operator<(const BindingPoint& a, const BindingPoint& b) noexcept;
+namespace Limitless::ms {
+    class MaterialStorage;
+}
 
+namespace Limitless {
     enum class Clear {
         Color = GL_COLOR_BUFFER_BIT,
         Depth = GL_DEPTH_BUFFER_BIT,
@@ -79,11 +84,29 @@ namespace Limitless {
         Fill = GL_FILL,
     };
 
+    // time of draws with programs used for the first time, drivers often finish compiling programs then
+    struct ShaderStats {
+        // programs drawn by frames for the first time
+        uint64_t first_uses {};
+        // first uses of programs that were not warmed up
+        uint64_t cold_uses {};
+        // time from first use of program until another program is used or frame ends
+        std::chrono::nanoseconds first_use_time {};
+        std::chrono::nanoseconds max_first_use {};
+        // programs drawn by ShaderWarmUp
+        uint64_t warmed {};
+        std::chrono::nanoseconds warm_up_time {};
+    };
+
     class Context;
 
     class ContextState {
     protected:
-        std::unordered_map<Capabilities, bool> capability_map;
+        static constexpr size_t capability_count = 6;
+        static constexpr size_t buffer_target_count = 8;
+
+        // contains [capability index, enabled]
+        std::array<bool, capability_count> capability_map {};
         glm::uvec2 viewport {};
         glm::vec4 clear_color {};
 
@@ -103,24 +126,87 @@ namespace Limitless {
         GLuint vertex_array_id {};
         GLuint framebuffer_id {};
 
-        // contains [target, last buffer id]
-        std::unordered_map<Buffer::Type, GLuint> buffer_target;
-        // contains [binding point, last_buffer_id]
-        std::map<BindingPoint, GLuint> buffer_point;
+        SharedVertexArrays shared_vertex_arrays;
+
+        // contains [target index, last buffer id]
+        std::array<GLuint, buffer_target_count> buffer_target {};
+        // contains [target index][binding point, last buffer id]
+        std::array<std::vector<GLuint>, buffer_target_count> buffer_point;
 
         IndexedBuffer indexed_buffers;
 
+        // per-frame dynamic data, created on first use
+        std::unique_ptr<RingBuffer> ring_buffer;
+
+        // contains [block size, storage shared by material blocks of the size]
+        std::map<size_t, std::weak_ptr<ms::MaterialStorage>> material_storages;
+
+        // fence shared by everything used during current frame, placed when frame ends
+        std::shared_ptr<Fence> frame_fence;
+        SyncStats sync_stats;
+
+        ShaderStats shader_stats;
+        // start of draws with program used for the first time, zero when they are not timed
+        std::chrono::steady_clock::time_point first_use_start {};
+
         GLuint active_texture {};
         // contains [texture_image_unit, texture_id]
-        std::map<GLuint, GLuint> texture_bound;
+        std::vector<GLuint> texture_bound;
+        TextureBinder texture_binder;
         // contains [texture_handle, resident]
         std::map<GLuint64, bool> texture_resident;
 
         ContextState() = default;
         void init() noexcept;
 
+        static constexpr size_t getIndex(Capabilities func) noexcept {
+            switch (func) {
+                case Capabilities::DepthTest: return 0;
+                case Capabilities::Blending: return 1;
+                case Capabilities::ProgramPointSize: return 2;
+                case Capabilities::ScissorTest: return 3;
+                case Capabilities::StencilTest: return 4;
+                case Capabilities::CullFace: return 5;
+            }
+            return 0;
+        }
+
+        static constexpr size_t getIndex(Buffer::Type target) noexcept {
+            switch (target) {
+                case Buffer::Type::Array: return 0;
+                case Buffer::Type::Element: return 1;
+                case Buffer::Type::Uniform: return 2;
+                case Buffer::Type::ShaderStorage: return 3;
+                case Buffer::Type::AtomicCounter: return 4;
+                case Buffer::Type::IndirectDraw: return 5;
+                case Buffer::Type::IndirectDispatch: return 6;
+                case Buffer::Type::Parameter: return 7;
+            }
+            return 0;
+        }
+
+        GLuint& getBufferTarget(Buffer::Type target) noexcept { return buffer_target[getIndex(target)]; }
+        GLuint& getBufferPoint(Buffer::Type target, GLuint index) {
+            auto& points = buffer_point[getIndex(target)];
+            if (index >= points.size()) {
+                points.resize(index + 1, 0);
+            }
+            return points[index];
+        }
+
         static inline std::unordered_map<GLFWwindow*, ContextState*> state_map;
         static inline std::mutex mutex;
+
+        // state of the window that calling thread looked up last time;
+        // generation is changed when map is, so cache never outlives registered state
+        struct CachedState {
+            GLFWwindow* window;
+            ContextState* state;
+            uint64_t generation;
+        };
+        static inline thread_local CachedState cached_state;
+        static inline std::atomic<uint64_t> generation {1};
+
         void swapStateMap(Context& lhs, Context& rhs) noexcept;
         void unregisterState(GLFWwindow* window) noexcept;
         void registerState(GLFWwindow* window) noexcept;
@@ -135,6 +221,8 @@ namespace Limitless {
         friend class TextureBinder;
         friend class Framebuffer;
         friend class DefaultFramebuffer;
+        friend class Fence;
+        friend class ShaderWarmUp;
     public:
         virtual ~ContextState() = default;
 
@@ -163,6 +251,26 @@ namespace Limitless {
         void enable(Capabilities func) noexcept;
 
         auto& getIndexedBuffers() noexcept { return indexed_buffers; }
+        RingBuffer& getRingBuffer();
+
+        // returns storage shared by material blocks of the size, created on first use
+        std::shared_ptr<ms::MaterialStorage> getMaterialStorage(size_t block_size);
+
+        // buffers keep this fence to wait for GPU before overwriting memory used in current frame
+        const std::shared_ptr<Fence>& getFrameFence();
+        // places fence of current frame, next users get new one
+        void fenceFrame() noexcept;
+
+        const auto& getSyncStats() const noexcept { return sync_stats; }
+        void resetSyncStats() noexcept { sync_stats = {}; }
+
+        // starts timing draws with program used for the first time
+        void beginFirstUse(bool warmed) noexcept;
+        // stops timing them, called when another program is used and when frame ends
+        void endFirstUse() noexcept;
+
+        const auto& getShaderStats() const noexcept { return shader_stats; }
+        void resetShaderStats() noexcept { shader_stats = {}; }
 
         const auto& getViewPort() const noexcept { return viewport; }
         const auto& getClearColor() const noexcept { return clear_color; }
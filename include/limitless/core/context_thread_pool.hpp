@@ -4,11 +4,44 @@
 #include <limitless/core/context.hpp>
 
 namespace Limitless {
+    // workers with contexts shared with the one pool is created from
+    //
+    // workers do not wait for their commands to complete, fence is placed after every task instead,
+    // and context that uses results waits for these fences on GPU side by synchronize()
     class ContextThreadPool : public ThreadPool {
     private:
         std::vector<Context> context_workers;
+
+        // fences of finished tasks not yet waited by user context
+        std::vector<GLsync> fences;
+        std::mutex fence_mutex;
+
+        // placed when task returns, so it covers commands of task before its future is ready
+        class TaskFence final {
+        private:
+            ContextThreadPool& pool;
+        public:
+            explicit TaskFence(ContextThreadPool& pool) noexcept : pool {pool} {}
+            ~TaskFence() { pool.placeFence(); }
+
+            TaskFence(const TaskFence&) = delete;
+            TaskFence& operator=(const TaskFence&) = delete;
+        };
+
+        void placeFence();
     public:
         explicit ContextThreadPool(Context& shared, uint32_t pool_size = std::thread::hardware_concurrency());
-        ~ContextThreadPool() override = default;
+        ~ContextThreadPool() override;
+
+        template<typename F, typename... Args>
+        auto add(F&& f, Args&&... args) {
+            return ThreadPool::add([this, f = std::forward<F>(f)] (auto&&... arguments) mutable {
+                const TaskFence fence {*this};
+                return std::invoke(f, std::forward<decltype(arguments)>(arguments)...);
+            }, std::forward<Args>(args)...);
+        }
+
+        // makes commands of current context wait for commands of finished tasks without blocking CPU
+        void synchronize();
     };
-}
\ No newline at end of file
+}
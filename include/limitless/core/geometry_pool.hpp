@@ -0,0 +1,125 @@
+#pragma once
+
+#include <limitless/core/buffer.hpp>
+#include <limitless/core/vertex_array.hpp>
+#include <memory>
+#include <vector>
+#include <map>
+
+namespace Limitless {
+    // sub-allocator of static geometry
+    //
+    // vertices and indices of many meshes live in one large vertex buffer and one index buffer,
+    // every mesh references its ranges by base vertex and first index,
+    // so meshes of the same pool are drawn without rebinds and can be merged into multi draw calls
+    //
+    // free ranges are kept sorted by offset and merged with neighbours when released;
+    // when there is no free range large enough, pool is compacted into new buffers,
+    // which are grown if live geometry does not fit either
+    //
+    // ranges move on compaction, so they are referenced by handle and looked up on draw
+    class GeometryPool final {
+    public:
+        using Handle = uint32_t;
+
+        struct Range {
+            GLuint offset;
+            GLuint count;
+        };
+
+        struct Allocation {
+            Range vertices;
+            Range indices;
+        };
+
+        struct Stats {
+            // in bytes
+            size_t vertex_capacity;
+            size_t vertex_used;
+            size_t index_capacity;
+            size_t index_used;
+
+            uint32_t allocation_count;
+            uint32_t free_range_count;
+            // number of times pool was compacted
+            uint32_t compaction_count;
+        };
+    private:
+        // buffer with sorted list of free ranges
+        struct Arena {
+            std::unique_ptr<Buffer> buffer;
+            // contains [offset, count]
+            std::map<GLuint, GLuint> free;
+            size_t element_size;
+            GLuint capacity;
+            GLuint used;
+
+            bool allocate(GLuint count, GLuint& offset);
+            void release(const Range& range);
+        };
+
+        const VertexFormat& format;
+        Arena vertices;
+        Arena indices;
+
+        std::vector<Allocation> allocations;
+        std::vector<Handle> free_handles;
+        uint32_t compaction_count {};
+
+        void create(Arena& arena, GLuint capacity);
+        void compact(Arena& arena, Range Allocation::* range, GLuint capacity);
+        void reserve(Arena& arena, Range Allocation::* range, GLuint count);
+    public:
+        static constexpr GLuint default_vertex_capacity = 1024 * 1024;
+        static constexpr GLuint default_index_capacity = 3 * 1024 * 1024;
+
+        // storage is created on first allocation
+        explicit GeometryPool(const VertexFormat& format, GLuint vertex_capacity = default_vertex_capacity, GLuint index_capacity = default_index_capacity);
+        ~GeometryPool() = default;
+
+        GeometryPool(const GeometryPool&) = delete;
+        GeometryPool& operator=(const GeometryPool&) = delete;
+
+        // copies geometry into pool, vertices are of format size
+        Handle allocate(const void* vertex_data, GLuint vertex_count, const GLuint* index_data, GLuint index_count);
+        void free(Handle handle);
+
+        // moves all ranges to the beginning of buffers, so free space is one range
+        void defragment();
+
+        // attaches pool buffers to vertex array with pool format at binding zero
+        void attach(VertexArray& vertex_array) const noexcept;
+
+        [[nodiscard]] const Allocation& get(Handle handle) const { return allocations.at(handle); }
+        [[nodiscard]] const auto& getFormat() const noexcept { return format; }
+        [[nodiscard]] const Buffer* getVertexBuffer() const noexcept { return vertices.buffer.get(); }
+        [[nodiscard]] const Buffer* getIndexBuffer() const noexcept { return indices.buffer.get(); }
+        [[nodiscard]] Stats getStats() const noexcept;
+    };
+
+    // owned allocation of geometry pool, freed on destruction
+    class PooledGeometry final {
+    private:
+        std::shared_ptr<GeometryPool> pool;
+        GeometryPool::Handle handle {};
+
+        friend void swap(PooledGeometry& lhs, PooledGeometry& rhs) noexcept;
+    public:
+        PooledGeometry() noexcept = default;
+        PooledGeometry(std::shared_ptr<GeometryPool> pool, const void* vertex_data, GLuint vertex_count, const GLuint* index_data, GLuint index_count);
+        ~PooledGeometry();
+
+        PooledGeometry(const PooledGeometry&) = delete;
+        PooledGeometry& operator=(const PooledGeometry&) = delete;
+
+        PooledGeometry(PooledGeometry&& rhs) noexcept;
+        PooledGeometry& operator=(PooledGeometry&& rhs) noexcept;
+
+        [[nodiscard]] GeometryPool* getPool() const noexcept { return pool.get(); }
+        [[nodiscard]] const auto& get() const { return pool->get(handle); }
+
+        explicit operator bool() const noexcept { return pool != nullptr; }
+    };
+
+    void swap(PooledGeometry& lhs, PooledGeometry& rhs) noexcept;
+}
@@ -18,6 +18,7 @@ namespace Limitless {
         NamedBuffer(NamedBuffer&& rhs) noexcept;
         NamedBuffer& operator=(NamedBuffer&& rhs) noexcept;
 
+        void clearSubData(GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void* data) const noexcept override;
         void clearData(GLenum internalformat, GLenum format, GLenum type, const void* data) const noexcept override;
         void bufferSubData(GLintptr offset, size_t sub_size, const void* data) const noexcept override;
 
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <limitless/core/context_debug.hpp>
+#include <limitless/util/filesystem.hpp>
+#include <vector>
+
+namespace Limitless {
+    class Shader;
+
+    // stores linked programs on disk and restores them without compiling and linking
+    //
+    // program is keyed by hash of its preprocessed sources and of driver vendor, renderer and version,
+    // so edited sources and updated drivers miss the cache; binaries that driver rejects are removed
+    class ProgramBinaryCache final {
+    private:
+        fs::path directory;
+        // hash of driver strings, starting value of program keys
+        uint64_t driver_hash;
+
+        [[nodiscard]] fs::path getPath(uint64_t key) const;
+    public:
+        // requires current context
+        explicit ProgramBinaryCache(fs::path directory);
+
+        // program binaries with at least one binary format
+        static bool isSupported() noexcept;
+
+        [[nodiscard]] uint64_t getKey(const std::vector<Shader>& shaders) const noexcept;
+
+        // returns linked program or zero if there is no valid binary
+        [[nodiscard]] GLuint load(uint64_t key) const;
+        // program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+        void store(uint64_t key, GLuint program_id) const;
+
+        // removes all stored binaries
+        void clear() const;
+
+        [[nodiscard]] const auto& getDirectory() const noexcept { return directory; }
+    };
+}
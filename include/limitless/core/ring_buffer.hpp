@@ -0,0 +1,68 @@
+#pragma once
+
+#include <limitless/core/buffer.hpp>
+#include <limitless/core/sync.hpp>
+#include <memory>
+#include <vector>
+
+namespace Limitless {
+    // allocator of per-frame dynamic data
+    //
+    // single buffer is split into segments, one for every frame in flight;
+    // uploads of the frame are sub-ranges of its segment bound with glBindBufferRange,
+    // fence placed at the end of frame keeps segment from being overwritten until GPU has read it
+    //
+    // storage is persistently mapped if ARB_buffer_storage is supported,
+    // otherwise ranges are mapped unsynchronized one by one
+    class RingBuffer final {
+    public:
+        struct Allocation {
+            const Buffer* buffer {};
+            GLintptr offset {};
+            GLsizeiptr size {};
+            uint64_t frame {};
+        };
+    private:
+        std::unique_ptr<Buffer> buffer;
+        // buffers replaced by growth during frame, ranges in them can still be bound
+        std::vector<std::unique_ptr<Buffer>> retired;
+        std::vector<std::shared_ptr<Fence>> fences;
+
+        uint8_t* persistent_ptr {};
+        size_t segment_size;
+        uint32_t segment {};
+        size_t head {};
+        uint64_t frame {1};
+
+        void create();
+        void grow(size_t required);
+        static size_t getAlignment(Buffer::Type target) noexcept;
+        static size_t alignSegment(size_t size) noexcept;
+    public:
+        static constexpr uint32_t segment_count = 3;
+        static constexpr size_t default_segment_size = 1024 * 1024;
+
+        explicit RingBuffer(size_t segment_size = default_segment_size);
+        ~RingBuffer() = default;
+
+        RingBuffer(const RingBuffer&) = delete;
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        // waits until GPU is done with segment of frame that used it last time
+        void beginFrame();
+        // guards current segment with fence of frame and moves to the next one
+        void endFrame();
+
+        // copies data into current segment aligned for binding to target
+        Allocation upload(Buffer::Type target, const void* data, size_t size);
+        static void bind(const Allocation& allocation, Buffer::Type target, GLuint index) noexcept;
+
+        // allocation stays valid until the end of frame it was made in
+        [[nodiscard]] bool isValid(const Allocation& allocation) const noexcept { return allocation.buffer && allocation.frame == frame; }
+
+        [[nodiscard]] auto getFrame() const noexcept { return frame; }
+        [[nodiscard]] auto getSegmentSize() const noexcept { return segment_size; }
+        [[nodiscard]] auto getUsedSize() const noexcept { return head; }
+        [[nodiscard]] bool isPersistent() const noexcept { return persistent_ptr != nullptr; }
+    };
+}
@@ -3,8 +3,11 @@
 #include <limitless/core/context_debug.hpp>
 
 #include <limitless/util/filesystem.hpp>
+#include <unordered_map>
+#include <functional>
 #include <fstream>
 #include <utility>
+#include <vector>
 
 namespace Limitless {
     class shader_file_not_found : public std::runtime_error {
@@ -38,14 +41,18 @@ namespace Limitless {
         Type type {Type::Vertex};
         GLuint id {};
 
+        // files source is made of
+        std::vector<fs::path> dependencies;
+        // values of keys that are expanded in one pass over source
+        std::unordered_map<std::string, std::string> keys;
+
         void replaceExtensions() noexcept;
         void replaceVersion() noexcept;
-        void replaceIncludes(const fs::path& base_dir);
+        void expandKeys() noexcept;
 
         void checkStatus() const;
 
         Shader() = default;
-        static std::string getSource(const fs::path &filepath);
         friend void swap(Shader& lhs, Shader&rhs) noexcept;
     public:
         using ShaderAction = std::function<void(Shader&)>;
@@ -59,9 +66,15 @@ namespace Limitless {
         Shader& operator=(Shader&&) noexcept;
 
         [[nodiscard]] const auto& getId() const noexcept { return id; }
+        [[nodiscard]] auto getType() const noexcept { return type; }
+        // preprocessed source
+        [[nodiscard]] const auto& getSource() const noexcept { return source; }
+        [[nodiscard]] const auto& getDependencies() const noexcept { return dependencies; }
 
+        // with parallel shader compilation status is checked by program link
         void compile() const;
 
+        // keys set by ShaderAction are replaced all at once when shader is constructed
         void replaceKey(const std::string& key, const std::string& value) noexcept;
     };
 
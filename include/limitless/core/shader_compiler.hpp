@@ -2,12 +2,15 @@
 
 #include <limitless/util/filesystem.hpp>
 #include <functional>
+#include <string_view>
 
 #include <limitless/core/shader.hpp>
+#include <algorithm>
 
 namespace Limitless {
     class ShaderProgram;
     class Context;
+    class ProgramBinaryCache;
 
     class shader_linking_error : public std::runtime_error {
     public:
@@ -18,7 +21,21 @@ namespace Limitless {
     protected:
         std::vector<Shader> shaders;
         static void checkStatus(GLuint program_id);
+        std::shared_ptr<ShaderProgram> link();
         Context& context;
+
+        // shared by all compilers, programs are compiled only if they miss it
+        static inline std::shared_ptr<ProgramBinaryCache> binary_cache;
+
+        // returns programs before driver links them if it compiles in parallel,
+        // users check ShaderProgram::isReady before drawing with them
+        bool background_link {};
+
+        // defines that programs remember if their sources use them,
+        // so only programs that use changed ones are compiled again
+        std::vector<std::string> watched_defines;
+
+        friend class ShaderProgram;
     public:
         explicit ShaderCompiler(Context& ctx);
         virtual ~ShaderCompiler() = default;
@@ -32,5 +49,12 @@ namespace Limitless {
         std::shared_ptr<ShaderProgram> compile(const fs::path& path, const ShaderAction& actions = ShaderAction{});
 
         ShaderCompiler& operator<<(Shader&& shader) noexcept;
+
+        // whether source uses define, its own definition is not counted
+        static bool refersTo(std::string_view source, std::string_view name) noexcept;
+
+        // null disables cache
+        static void setBinaryCache(std::shared_ptr<ProgramBinaryCache> cache) noexcept { binary_cache = std::move(cache); }
+        [[nodiscard]] static const auto& getBinaryCache() noexcept { return binary_cache; }
     };
 }
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <limitless/core/indexed_buffer.hpp>
+#include <limitless/core/uniform_id.hpp>
 #include <vector>
+#include <atomic>
 #include <limitless/shader_storage.hpp>
 
 namespace Limitless::ms {
@@ -14,7 +16,9 @@ namespace Limitless {
     template<typename T> class UniformValue;
     class UniformSampler;
     class Uniform;
+    class Texture;
     class ContextState;
+    class ProgramBinaryCache;
 
     struct shader_program_error : public std::runtime_error {
         explicit shader_program_error(const char* error) noexcept : runtime_error{error} {}
@@ -22,14 +26,53 @@ namespace Limitless {
 
     class ShaderProgram final {
     private:
+        struct UniformSlot {
+            std::string name;
+            GLint location;
+            // last value, created by the first update
+            std::unique_ptr<Uniform> uniform;
+        };
+
         GLuint id{};
-        // stores uniform locations inside the shader
-        std::unordered_map<std::string, GLint> locations;
+        // stores active uniforms of the shader
+        std::vector<UniformSlot> uniforms;
+        // contains [uniform id index, slot index + 1], zero for uniforms shader does not have
+        std::vector<uint32_t> slot_indices;
         // stores indexed buffers binding data
         std::vector<IndexedBufferData> indexed_binds;
-        // stores uniform values
-        std::map<std::string, std::unique_ptr<Uniform>> uniforms;
 
+        // program that is still linked by driver threads, it is set up when link completes
+        // by the context that uses it, compiling context may be gone by then
+        struct PendingLink {
+            std::shared_ptr<ProgramBinaryCache> binary_cache;
+            uint64_t binary_key;
+        };
+        std::unique_ptr<PendingLink> pending;
+        // background link failed, program stays not ready and is not drawn
+        bool failed {};
+
+        // shader files and their includes
+        std::vector<fs::path> dependencies;
+        // render settings defines that sources refer to
+        std::vector<std::string> defines;
+
+        // program compiled with changed defines, it takes place of this one when linked,
+        // so draws keep using outdated program meanwhile
+        // set by compiling threads and taken by the drawing one, so it is accessed atomically
+        std::shared_ptr<ShaderProgram> replacement;
+        std::atomic<bool> outdated {};
+
+        // whether program was drawn by frames and by warm-up
+        bool used {};
+        bool warmed {};
+
+        void finishLink();
+
+        // takes over linked program of replacement, keeps replacement state of this one
+        void adopt(ShaderProgram& linked) noexcept;
+
+        UniformSlot* findSlot(UniformId uniform_id) noexcept;
+        const UniformSlot* findSlot(UniformId uniform_id) const noexcept;
         GLint getUniformLocation(const Uniform& uniform) const noexcept;
 
         void getUniformLocations() noexcept;
@@ -38,14 +81,19 @@ namespace Limitless {
         void bindIndexedBuffers(ContextState& ctx);
         void bindTextures() const noexcept;
 
+        // makes program current and updates its state
+        void apply(ContextState& ctx);
+
         ShaderProgram() noexcept = default;
         ShaderProgram(ContextState& ctx, GLuint id);
+        ShaderProgram(GLuint id, std::unique_ptr<PendingLink> pending) noexcept;
 
         template<typename T> friend class UniformValue;
         friend class UniformSampler;
         friend class ms::MaterialCompiler;
         friend class ShaderCompiler;
         friend class ms::MaterialBuilder;
+        friend class ShaderWarmUp;
         friend void swap(ShaderProgram& lhs, ShaderProgram& rhs) noexcept;
     public:
         ~ShaderProgram();
@@ -57,9 +105,32 @@ namespace Limitless {
         ShaderProgram& operator=(ShaderProgram&& rhs) noexcept;
 
         [[nodiscard]] auto getId() const noexcept { return id; }
+        [[nodiscard]] const auto& getDependencies() const noexcept { return dependencies; }
+        [[nodiscard]] const auto& getDefines() const noexcept { return defines; }
+
+        // marks program to be compiled again
+        void outdate() noexcept { outdated = true; }
+        [[nodiscard]] bool isOutdated() const noexcept { return outdated.load(); }
+
+        // swaps in program once it is linked, references to this program stay valid
+        void replace(std::shared_ptr<ShaderProgram> program) noexcept;
 
+        // checks without blocking whether background link is complete
+        // uniforms cannot be set before that, so draws use another shader meanwhile
+        // failed link is reported once and program is never ready
+        // also swaps in linked replacement
+        [[nodiscard]] bool isReady();
+        [[nodiscard]] auto isFailed() const noexcept { return failed; }
+
+        // waits for link if it is not complete
+        // draws after first use of program are timed in ShaderStats of the context
         void use();
 
+        // updates value of uniform, does nothing if shader does not have it
+        template<typename T>
+        ShaderProgram& setUniform(UniformId uniform_id, const T& value);
+        ShaderProgram& setUniform(UniformId uniform_id, const std::shared_ptr<Texture>& texture);
+
         template<typename T>
         ShaderProgram& operator<<(const UniformValue<T>& uniform) noexcept;
         ShaderProgram& operator<<(const UniformSampler& uniform) noexcept;
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <limitless/util/filesystem.hpp>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+
+namespace Limitless {
+    // shader files read from disk once and shared by all variants compiled from them
+    //
+    // shader source is stored with includes resolved, along with files it consists of;
+    // these lists make include graph, so file changed on disk invalidates only sources that use it
+    class ShaderSourceCache final {
+    public:
+        struct Source {
+            std::string text;
+            // shader file and all files included by it
+            std::vector<fs::path> files;
+        };
+    private:
+        struct File {
+            std::string text;
+            fs::file_time_type time;
+        };
+
+        // keyed by normalized path
+        static inline std::unordered_map<std::string, File> files;
+        static inline std::unordered_map<std::string, Source> sources;
+        static inline std::mutex mutex;
+
+        static const std::string& read(const fs::path& path);
+        static void resolve(std::string& text, const fs::path& base_dir, std::vector<fs::path>& used, const fs::path& shader_path);
+    public:
+        // returns source of shader file with includes resolved against its directory
+        static Source get(const fs::path& path);
+
+        // resolves includes of text that was added to source, included files are added to used
+        static void resolveIncludes(std::string& text, const fs::path& base_dir, std::vector<fs::path>& used, const fs::path& shader_path);
+
+        // drops files modified on disk since they were read and sources that use them, returns these files
+        // missing files are not dropped
+        static std::vector<fs::path> update();
+
+        static void clear() noexcept;
+    };
+}
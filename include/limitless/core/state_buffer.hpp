@@ -1,6 +1,8 @@
 #pragma once
 
 #include <limitless/core/buffer.hpp>
+#include <limitless/core/sync.hpp>
+#include <memory>
 #include <optional>
 
 namespace Limitless {
@@ -14,7 +16,8 @@ namespace Limitless {
 
         // for immutable persistence mapping
         std::optional<void*> persistent_ptr;
-        std::optional<GLsync> sync;
+        // fence of the last frame that used buffer
+        std::shared_ptr<Fence> sync;
 
         virtual void bufferStorage(const void* data);
         virtual void bufferData(const void* data) const noexcept;
@@ -37,8 +40,8 @@ namespace Limitless {
         void bufferSubData(GLintptr offset, size_t sub_size, const void* data) const noexcept override;
         void mapData(const void* data, size_t data_size) override;
 
-        void bindBufferRangeAs(Type target, GLuint index, GLintptr offset) const noexcept override;
-        void bindBufferRange(GLuint index, GLintptr offset) const noexcept override;
+        void bindBufferRangeAs(Type target, GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept override;
+        void bindBufferRange(GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept override;
         void bindBaseAs(Type target, GLuint index) const noexcept override;
         void bindBase(GLuint index) const noexcept override;
         void bindAs(Type target) const noexcept override;
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <limitless/core/context_debug.hpp>
+#include <chrono>
+#include <cstdint>
+
+namespace Limitless {
+    // time CPU spent waiting for GPU to release guarded memory
+    struct SyncStats {
+        // fences waited on
+        uint64_t waits {};
+        // waits that were not signaled on first check
+        uint64_t stalls {};
+        // waits that failed, memory was released without sync
+        uint64_t failures {};
+        std::chrono::nanoseconds stall_time {};
+        std::chrono::nanoseconds max_stall {};
+    };
+
+    // sync object guarding memory read by commands issued before it
+    //
+    // buffers do not create fence for every draw, they share fence of current frame from ContextState;
+    // it is placed once when frame ends or earlier if someone has to wait for it
+    class Fence final {
+    private:
+        GLsync sync {};
+    public:
+        Fence() = default;
+        ~Fence();
+
+        Fence(const Fence&) = delete;
+        Fence& operator=(const Fence&) = delete;
+
+        // inserts sync into command stream, fence covers all commands issued so far
+        void place() noexcept;
+
+        // waits in bounded steps flushing commands, so pending fence is always reached by GPU;
+        // stall time is accounted in SyncStats of current context
+        void wait() noexcept;
+
+        [[nodiscard]] bool isPlaced() const noexcept { return sync != nullptr; }
+    };
+}
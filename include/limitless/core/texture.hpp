@@ -37,6 +37,7 @@ namespace Limitless {
             RGBA8 = GL_RGBA8,
             RGB16F = GL_RGB16F,
             RGBA16F = GL_RGBA16F,
+            R32F = GL_R32F,
 
             sRGB8 = GL_SRGB8,
             sRGBA8 = GL_SRGB8_ALPHA8,
@@ -103,6 +104,10 @@ namespace Limitless {
         };
     private:
         std::optional<fs::path> path;
+
+        // unit assigned by TextureBinder last time
+        mutable GLuint unit_hint {};
+        friend class TextureBinder;
     public:
         Texture() = default;
         virtual ~Texture() = default;
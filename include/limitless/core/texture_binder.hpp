@@ -1,23 +1,41 @@
 #pragma once
 
-#include <limitless/core/extension_texture.hpp>
 #include <limitless/core/texture.hpp>
+#include <cstdint>
 #include <vector>
 
 namespace Limitless {
+    class ContextState;
+
+    // assigns texture units to textures used by shader programs
+    //
+    // units are kept in list from least to most recently used, texture remembers its last unit,
+    // so texture that is still bound costs nothing and unbound one takes least recently used unit;
+    // units used by current set of textures are never evicted by the same set
     class TextureBinder {
     private:
-        //TODO: move to context state
-        static inline GLint current_bind {0};
+        // linked list of units by index
+        std::vector<GLuint> prev;
+        std::vector<GLuint> next;
+        // set of textures that used unit last time
+        std::vector<uint64_t> unit_set;
+        GLuint lru {};
+        GLuint mru {};
+        uint64_t current_set {1};
+
+        void resize(GLuint unit_count);
+        void touch(GLuint unit) noexcept;
+        GLint bindUnit(const std::vector<GLuint>& texture_bound, const Texture& texture);
+
+        friend class ContextState;
     public:
-        // TODO: fix
-//        // binds texture to any unit and returns its index
-//        static GLint bind(Texture& texture) noexcept;
-//
-//        //TODO: returns slot to bind, not binding it itself
-//        static GLint bind(GLenum target, const ExtensionTexture& texture) noexcept;
+        // starts new set of textures that are used together
+        static void begin();
+
+        // binds texture to unit of current set and returns its index
+        static GLint bind(const Texture& texture);
 
-        // binds textures and returns indices to units
+        // binds textures as one set and returns indices to units
         [[nodiscard]] static std::vector<GLint> bind(const std::vector<Texture*>& textures);
     };
-}
\ No newline at end of file
+}
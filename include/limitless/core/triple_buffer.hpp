@@ -1,29 +1,51 @@
 #pragma once
 
 #include <limitless/core/buffer.hpp>
+#include <limitless/core/sync.hpp>
 #include <array>
 #include <memory>
 
 namespace Limitless {
+    // buffer for data that is rewritten every frame
+    //
+    // single storage is split into three regions, every mapData writes the next one after waiting
+    // for the fence of its last use, so GPU keeps reading previous regions while CPU writes;
+    // users draw from current region at getOffset
+    //
+    // storage is persistently mapped if ARB_buffer_storage is supported,
+    // otherwise regions are mapped unsynchronized one by one
     class TripleBuffer : public Buffer {
+    public:
+        static constexpr uint8_t region_count = 3;
     private:
-        std::array<std::shared_ptr<Buffer>, 3> buffers;
-        mutable uint8_t curr_index;
+        std::unique_ptr<Buffer> buffer;
+        std::array<std::shared_ptr<Fence>, region_count> fences;
+        uint8_t* persistent_ptr {};
+        Type target;
+        size_t region_size;
+        uint8_t curr_index {};
+
+        void create(const void* data);
     public:
-        explicit TripleBuffer(decltype(buffers) buffers) noexcept;
+        TripleBuffer(Type target, size_t size, const void* data);
+        ~TripleBuffer() override = default;
 
         void clearSubData(GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void* data) const noexcept override;
         void clearData(GLenum internalformat, GLenum format, GLenum type, const void* data) const noexcept override;
         void bufferSubData(GLintptr offset, size_t sub_size, const void* data) const noexcept override;
         void mapData(const void* data, size_t data_size) override;
 
-        void bindBufferRangeAs(Type target, GLuint index, GLintptr offset) const noexcept override;
-        void bindBufferRange(GLuint index, GLintptr offset) const noexcept override;
+        void bindBufferRangeAs(Type target, GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept override;
+        void bindBufferRange(GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept override;
         void bindBaseAs(Type target, GLuint index) const noexcept override;
         void bindBase(GLuint index) const noexcept override;
         void bindAs(Type target) const noexcept override;
         void bind() const noexcept override;
 
+        // reallocates every region, previous content is lost
+        void resize(size_t size) noexcept override;
+
+        // guards current region until GPU is done with current frame
         void fence() noexcept override;
         void waitFence() noexcept override;
 
@@ -32,8 +54,13 @@ namespace Limitless {
 
         [[nodiscard]] GLuint getId() const noexcept override;
         [[nodiscard]] Type getType() const noexcept override;
+        // size of single region
         [[nodiscard]] size_t getSize() const noexcept override;
         [[nodiscard]] const std::variant<Usage, Storage>& getUsageFlags() const noexcept override;
         [[nodiscard]] const std::variant<MutableAccess, ImmutableAccess>& getAccess() const noexcept override;
+
+        // offset of current region in storage
+        [[nodiscard]] GLintptr getOffset() const noexcept { return static_cast<GLintptr>(curr_index * region_size); }
+        [[nodiscard]] bool isPersistent() const noexcept { return persistent_ptr != nullptr; }
     };
-}
\ No newline at end of file
+}
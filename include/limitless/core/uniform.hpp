@@ -5,6 +5,8 @@
 #include <chrono>
 #include <limitless/core/texture_visitor.hpp>
 #include <limitless/core/context_debug.hpp>
+#include <limitless/core/uniform_id.hpp>
+#include <glm/glm.hpp>
 
 namespace Limitless {
     class Texture;
@@ -27,12 +29,27 @@ namespace Limitless {
         Mat4
     };
 
+    class Uniform;
+
+    // notified when value of uniform changes, so owners of uniforms do not poll them
+    class UniformObserver {
+    public:
+        virtual void onUniformChange(Uniform& uniform) noexcept = 0;
+
+        virtual ~UniformObserver() = default;
+    };
+
     class Uniform {
     protected:
         std::string name;
+        UniformId id;
         UniformType type;
         UniformValueType value_type;
         bool changed;
+        // is not copied, copy belongs to another owner
+        UniformObserver* observer {};
+
+        void notify() noexcept;
 
         friend class UniformSerializer;
 
@@ -44,9 +61,15 @@ namespace Limitless {
         Uniform(std::string name, UniformType type, UniformValueType value_type) noexcept;
         virtual ~Uniform() = default;
 
+        Uniform(const Uniform& rhs);
+        Uniform& operator=(const Uniform&) = delete;
+
+        void setObserver(UniformObserver* _observer) noexcept { observer = _observer; }
+
         [[nodiscard]] auto getType() const noexcept { return type; }
         [[nodiscard]] auto getValueType() const noexcept { return value_type; }
         [[nodiscard]] const auto& getName() const noexcept { return name; }
+        [[nodiscard]] auto getId() const noexcept { return id; }
         [[nodiscard]] virtual bool& getChanged() noexcept { return changed; }
 
         [[nodiscard]] virtual Uniform* clone() noexcept = 0;
@@ -58,7 +81,6 @@ namespace Limitless {
     protected:
         T value;
 
-        constexpr UniformValueType getUniformValueType();
         UniformValue(const std::string& name, UniformType type, const T& value);
         friend class UniformSerializer;
 
@@ -66,6 +88,8 @@ namespace Limitless {
         UniformValue(const std::string& name, const T& value) noexcept;
         ~UniformValue() override = default;
 
+        static constexpr UniformValueType getUniformValueType();
+
         [[nodiscard]] const auto& getValue() const noexcept { return value; }
         void setValue(const T& val) noexcept;
 
@@ -105,6 +129,37 @@ namespace Limitless {
         void set(const ShaderProgram& shader) override;
     };
 
+    template<typename T>
+    constexpr UniformValueType UniformValue<T>::getUniformValueType() {
+        if constexpr (std::is_same<T, int>::value) {
+            return UniformValueType::Int;
+        }
+        else if constexpr (std::is_same<T, unsigned int>::value) {
+            return UniformValueType::Uint;
+        }
+        else if constexpr (std::is_same<T, float>::value) {
+            return UniformValueType::Float;
+        }
+        else if constexpr (std::is_same<T, glm::vec2>::value) {
+            return UniformValueType::Vec2;
+        }
+        else if constexpr (std::is_same<T, glm::vec3>::value) {
+            return UniformValueType::Vec3;
+        }
+        else if constexpr (std::is_same<T, glm::vec4>::value) {
+            return UniformValueType::Vec4;
+        }
+        else if constexpr (std::is_same<T, glm::mat3>::value) {
+            return UniformValueType::Mat3;
+        }
+        else if constexpr (std::is_same<T, glm::mat4>::value) {
+            return UniformValueType::Mat4;
+        }
+        else {
+            static_assert(!std::is_same<T, T>::value, "Unimplemented value type for uniform T.");
+        }
+    }
+
     std::string getUniformDeclaration(const Uniform& uniform) noexcept;
     size_t getUniformSize(const Uniform& uniform);
     size_t getUniformAlignment(const Uniform& uniform);
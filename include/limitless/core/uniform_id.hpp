@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Limitless {
+    // interned uniform name
+    //
+    // every name is mapped to dense index once, programs resolve indices to their uniform slots at link;
+    // ids of per-draw uniforms are meant to be created once and reused, so updates never hash strings
+    class UniformId final {
+    private:
+        uint32_t index;
+    public:
+        explicit UniformId(const std::string& name);
+        explicit UniformId(const char* name) : UniformId{std::string{name}} {}
+
+        [[nodiscard]] auto getIndex() const noexcept { return index; }
+    };
+
+    inline bool operator==(UniformId lhs, UniformId rhs) noexcept { return lhs.getIndex() == rhs.getIndex(); }
+    inline bool operator!=(UniformId lhs, UniformId rhs) noexcept { return !(lhs == rhs); }
+}
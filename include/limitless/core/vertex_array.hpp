@@ -2,6 +2,9 @@
 
 #include <limitless/core/vertex.hpp>
 #include <limitless/core/context_debug.hpp>
+#include <initializer_list>
+#include <memory>
+#include <vector>
 
 namespace Limitless {
     class Buffer;
@@ -15,10 +18,45 @@ namespace Limitless {
         Buffer& buffer;
     };
 
+    struct VertexAttributeFormat {
+        GLuint index;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        GLuint offset;
+    };
+
+    // layout of attributes sourced from one vertex buffer binding
+    // one object per vertex type is shared by all vertex arrays
+    struct VertexFormat {
+        std::vector<VertexAttributeFormat> attributes;
+        GLsizei stride;
+        // per instance data advances every divisor instances
+        GLuint divisor {};
+    };
+
+    [[nodiscard]] const VertexFormat& getVertexFormat(const Vertex&) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const TextVertex&) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const VertexNormal&) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const VertexNormalTangent&) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const VertexPackedNormalTangent&) noexcept;
+
+    // with direct state access vertex array is edited without being bound
+    // and attribute formats are specified separately from buffers they are sourced from
     class VertexArray {
     private:
+        struct VertexBinding {
+            // kept to respecify attribute pointers when DSA is not supported
+            const VertexFormat* format;
+            GLuint buffer;
+            GLintptr offset;
+        };
+
         GLuint id;
         GLuint next_attribute_index;
+        // attached buffers are remembered, so attaching them again costs nothing
+        std::vector<VertexBinding> bindings;
+        GLuint element_buffer {};
 
         explicit VertexArray(GLuint id) noexcept;
         friend void swap(VertexArray& lhs, VertexArray& rhs);
@@ -37,17 +75,42 @@ namespace Limitless {
         void disableAttribute(GLuint index) const noexcept;
         [[nodiscard]] auto getId() const noexcept { return id; }
 
+        // attribute is sourced from its own binding with the same index
         VertexArray& setAttribute(GLuint attr_id, const VertexAttribute& attribute) noexcept;
+        VertexArray& setAttributeDivisor(GLuint attr_id, GLuint divisor) noexcept;
+
+        // specifies attributes of format to be sourced from binding
+        VertexArray& setFormat(GLuint binding, const VertexFormat& format) noexcept;
+        // attaches buffer to binding with specified format
+        VertexArray& setVertexBuffer(GLuint binding, const Buffer& buffer, GLintptr offset = 0) noexcept;
+        VertexArray& setElementBuffer(const Buffer& element_buffer) noexcept;
+
+        // forgets deleted buffer, its id can be reused by another buffer
+        void detach(GLuint buffer) noexcept;
+
+        // returns vertex array of current context shared by all meshes with the same formats of bindings
+        [[nodiscard]] static VertexArray& getShared(std::initializer_list<const VertexFormat*> formats);
 
         VertexArray& operator<<(const Buffer& element_buffer) noexcept;
         // forbidden for indefinite time
 //        VertexArray& operator<<(const VertexAttribute& attribute) noexcept;
-        VertexArray& operator<<(const std::pair<Vertex, Buffer&>& attribute) noexcept;
-        VertexArray& operator<<(const std::pair<TextVertex, Buffer&>& attribute) noexcept;
-        VertexArray& operator<<(const std::pair<VertexNormal, Buffer&>& attribute) noexcept;
-        VertexArray& operator<<(const std::pair<VertexNormalTangent, Buffer&>& attribute) noexcept;
-        VertexArray& operator<<(const std::pair<VertexPackedNormalTangent, Buffer&>& attribute) noexcept;
+
+        // vertex types are sourced from binding zero
+        template<typename T>
+        VertexArray& operator<<(const std::pair<T, Buffer&>& attribute) noexcept {
+            return setFormat(0, getVertexFormat(attribute.first)).setVertexBuffer(0, attribute.second);
+        }
     };
 
     void swap(VertexArray& lhs, VertexArray& rhs);
-}
\ No newline at end of file
+
+    // vertex arrays of one context, one per layout of vertex buffers
+    // meshes of the same layout only attach their buffers before draw
+    class SharedVertexArrays {
+    private:
+        std::vector<std::pair<std::vector<const VertexFormat*>, std::unique_ptr<VertexArray>>> vertex_arrays;
+    public:
+        VertexArray& get(std::initializer_list<const VertexFormat*> formats);
+        void detach(GLuint buffer) noexcept;
+    };
+}
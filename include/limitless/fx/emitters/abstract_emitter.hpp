@@ -1,5 +1,6 @@
 #pragma once
 
+#include <limitless/util/bounding_box.hpp>
 #include <glm/glm.hpp>
 #include <chrono>
 #include <vector>
@@ -37,6 +38,9 @@ namespace Limitless::fx {
         [[nodiscard]] virtual const UniqueEmitterShader& getUniqueShaderType() const noexcept = 0;
         [[nodiscard]] virtual UniqueEmitterRenderer getUniqueRendererType() const noexcept = 0;
 
+        // world-space bounds of alive particles
+        [[nodiscard]] virtual BoundingBox getBoundingBox() const noexcept = 0;
+
         [[nodiscard]] virtual const glm::vec3& getPosition() const noexcept = 0;
         [[nodiscard]] virtual const glm::quat& getRotation() const noexcept = 0;
 
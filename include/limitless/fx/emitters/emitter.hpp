@@ -66,6 +66,8 @@ namespace Limitless::fx {
 
         friend class EffectBuilder;
     public:
+        [[nodiscard]] BoundingBox getBoundingBox() const noexcept override;
+
         [[nodiscard]] const glm::vec3& getPosition() const noexcept override;
         [[nodiscard]] const glm::quat& getRotation() const noexcept override;
 
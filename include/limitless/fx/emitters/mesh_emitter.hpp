@@ -33,6 +33,8 @@ namespace Limitless::fx {
 
         [[nodiscard]] const auto& getParticles() const noexcept { return particles; }
 
+        [[nodiscard]] BoundingBox getBoundingBox() const noexcept override;
+
         [[nodiscard]] auto& getMaterial() noexcept { return *material; }
         [[nodiscard]] const auto& getMesh() const noexcept { return mesh; }
         [[nodiscard]] const auto& getMaterial() const noexcept { return *material; }
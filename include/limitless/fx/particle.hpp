@@ -5,8 +5,7 @@
 #include <vector>
 
 namespace Limitless {
-    class VertexArray;
-    class Buffer;
+    struct VertexFormat;
 }
 
 namespace Limitless::fx {
@@ -204,7 +203,7 @@ namespace Limitless::fx {
         const auto& getEnd() const noexcept { return end; }
     };
 
-    VertexArray& operator<<(VertexArray& vertex_array, const std::pair<SpriteParticle, Buffer&>& attribute) noexcept;
-    VertexArray& operator<<(VertexArray& vertex_array, const std::pair<BeamParticleMapping, Buffer&>& attribute) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const SpriteParticle&) noexcept;
+    [[nodiscard]] const VertexFormat& getVertexFormat(const BeamParticleMapping&) noexcept;
 }
 
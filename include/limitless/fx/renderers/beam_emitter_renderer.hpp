@@ -34,7 +34,14 @@ namespace Limitless::fx {
                 return;
             }
 
-            auto& shader = assets.shaders.get({unique_type, shader_type});
+            auto* program = assets.shaders.find({unique_type, shader_type});
+
+            // particles appear once their shader is compiled and linked
+            if (!program || !program->isReady()) {
+                return;
+            }
+
+            auto& shader = *program;
 
             setBlendingMode(ctx, material.getBlending());
             if (material.getTwoSided()) {
@@ -56,7 +56,14 @@ namespace Limitless::fx {
                 return;
             }
 
-            auto& shader = assets.shaders.get({unique_type, pass});
+            auto* program = assets.shaders.find({unique_type, pass});
+
+            // particles appear once their shader is compiled and linked
+            if (!program || !program->isReady()) {
+                return;
+            }
+
+            auto& shader = *program;
 
             setBlendingMode(ctx, material.getBlending());
             if (material.getTwoSided()) {
@@ -17,7 +17,7 @@ namespace Limitless::fx {
         const UniqueEmitterShader unique_shader;
     public:
         explicit EmitterRenderer(const SpriteEmitter& emitter)
-                : mesh {emitter.getSpawn().max_count * EMITTER_STORAGE_INSTANCE_COUNT, "sprite_emitter", MeshDataType::Dynamic, DrawMode::Points}
+                : mesh {emitter.getSpawn().max_count * EMITTER_STORAGE_INSTANCE_COUNT, "sprite_emitter", MeshDataType::Stream, DrawMode::Points}
                 , unique_shader {emitter.getUniqueShaderType()} {
         }
 
@@ -36,7 +36,14 @@ namespace Limitless::fx {
                 return;
             }
 
-            auto& shader = assets.shaders.get({unique_shader, pass});
+            auto* program = assets.shaders.find({unique_shader, pass});
+
+            // particles appear once their shader is compiled and linked
+            if (!program || !program->isReady()) {
+                return;
+            }
+
+            auto& shader = *program;
 
             setBlendingMode(ctx, material.getBlending());
             if (material.getTwoSided()) {
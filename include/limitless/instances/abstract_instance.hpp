@@ -3,7 +3,9 @@
 #include <limitless/instances/effect_attachable.hpp>
 #include <limitless/instances/light_attachable.hpp>
 #include <limitless/util/bounding_box.hpp>
+#include <limitless/util/transform_store.hpp>
 #include <glm/gtx/quaternion.hpp>
+#include <atomic>
 
 namespace Limitless::ms {
     enum class Blending;
@@ -17,17 +19,40 @@ namespace Limitless {
     class Assets;
     class Context;
     class Camera;
+    class Scene;
+    class RenderQueue;
+    struct DrawItem;
 
     class AbstractInstance : public EffectAttachable, public LightAttachable {
     private:
         static inline uint64_t next_id {};
         uint64_t id;
+
+        // total count of model matrices rebuilt by all instances
+        static inline std::atomic<uint64_t> rebuilt_matrix_count {};
+
+        // leaf in spatial index of the scene
+        int32_t spatial_proxy {-1};
+
+        // entry in transform store of the scene; matrices of attached instances are composed there in batches
+        TransformRef transform;
+
+        // writes transform into the store, deferred while update jobs read it
+        void storeTransform() noexcept;
+
+        friend class Scene;
     protected:
         ModelShader shader_type;
         bool done {};
         bool hidden {};
         bool shadow_cast {true};
 
+        // set when model matrix and bounds have to be recalculated on update
+        bool transform_changed {true};
+
+        // set when bounding box has to be refitted in spatial index
+        bool bounds_changed {true};
+
         glm::vec3 position;
         glm::quat rotation;
         glm::vec3 scale;
@@ -56,7 +81,10 @@ namespace Limitless {
         [[nodiscard]] const auto& getScale() const noexcept { return scale; }
         [[nodiscard]] const auto& getModelMatrix() const noexcept { return model_matrix; }
         [[nodiscard]] auto& getModelMatrix() noexcept { return model_matrix; }
-        [[nodiscard]] const auto& getBoundingBox() noexcept { calculateBoundingBox(); return bounding_box; }
+        [[nodiscard]] bool isTransformChanged() const noexcept { return transform_changed; }
+        [[nodiscard]] static uint64_t getRebuiltMatrixCount() noexcept { return rebuilt_matrix_count.load(std::memory_order_relaxed); }
+        // world-space bounds as of the last update
+        [[nodiscard]] const auto& getBoundingBox() const noexcept { return bounding_box; }
 
         void reveal() noexcept;
         void hide() noexcept;
@@ -71,6 +99,9 @@ namespace Limitless {
 
         void update(Context& context, Camera& camera) override;
 
+        // moves lights attached to the instance and to its effects, not safe to call from update jobs
+        void updateLights() noexcept;
+
         virtual AbstractInstance& setPosition(const glm::vec3& position) noexcept;
         virtual AbstractInstance& setRotation(const glm::quat& rotation) noexcept;
         virtual AbstractInstance& rotateBy(const glm::quat& rotation) noexcept;
@@ -80,5 +111,15 @@ namespace Limitless {
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending);
 
         virtual void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_set) = 0;
+
+        // adds draw item for every visible mesh material layer
+        virtual void collect([[maybe_unused]] RenderQueue& queue) {}
+
+        // draws item previously collected by this instance
+        virtual void drawItem([[maybe_unused]] Context& ctx,
+                              [[maybe_unused]] const Assets& assets,
+                              [[maybe_unused]] ShaderPass shader_type,
+                              [[maybe_unused]] const DrawItem& item,
+                              [[maybe_unused]] const UniformSetter& uniform_set) {}
     };
 }
@@ -31,6 +31,8 @@ namespace Limitless {
         void setRotation(const glm::quat& rotation) noexcept;
         void rotateBy(const glm::quat& rotation) noexcept;
 
+        void updateLights() noexcept;
+
         EffectAttachable() noexcept;
         virtual ~EffectAttachable();
 
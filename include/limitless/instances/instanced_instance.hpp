@@ -1,8 +1,8 @@
 #pragma once
 
 #include <limitless/instances/model_instance.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/context.hpp>
+#include <limitless/pipeline/render_queue.hpp>
 
 namespace Limitless {
     template<typename Instance, typename = void>
@@ -16,73 +16,85 @@ namespace Limitless {
         // contains instanced models
         std::vector<std::unique_ptr<ModelInstance>> instances;
 
-        // contains model matrices for each ModelInstance
-        std::shared_ptr<Buffer> buffer;
-
-        void initializeBuffer(uint32_t count) {
-            BufferBuilder builder;
-            buffer = builder.setTarget(Buffer::Type::ShaderStorage)
-                    .setUsage(Buffer::Usage::DynamicDraw)
-                    .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                    .setData(nullptr)
-                    .setDataSize(sizeof(glm::mat4) * count)
-                    .build("model_buffer", *ContextState::getState(glfwGetCurrentContext()));
-        }
+        // matrices collected during update, uploaded into frame ring buffer on first draw after it
+        std::vector<glm::mat4> matrices;
+        RingBuffer::Allocation allocation;
+        bool buffer_changed {};
 
-        virtual void checkSize() {
-            if (buffer->getSize() < sizeof(glm::mat4) * instances.size()) {
-                buffer->resize(sizeof(glm::mat4) * instances.size());
+        void bindBuffer(Context& ctx) {
+            if (auto& ring = ctx.getRingBuffer(); buffer_changed || !ring.isValid(allocation)) {
+                allocation = ring.upload(Buffer::Type::ShaderStorage, matrices.data(), matrices.size() * sizeof(glm::mat4));
+                buffer_changed = false;
             }
+
+            RingBuffer::bind(allocation, Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
         }
 
+        // merges bounds of visible instances, they are already in world space
         void calculateBoundingBox() noexcept override {
-            assert("RIP");
-        }
+            bool empty = true;
 
-        void updateBuffer(Context& context, Camera& camera) {
-            checkSize();
+            for (const auto& instance : instances) {
+                if (instance->isHidden()) {
+                    continue;
+                }
 
-            std::vector<glm::mat4> data;
-            data.reserve(instances.size());
+                bounding_box = empty ? instance->getBoundingBox() : mergeBoundingBox(bounding_box, instance->getBoundingBox());
+                empty = false;
+            }
 
+            if (empty) {
+                bounding_box = { position, glm::vec3{0.0f} };
+            }
+        }
+
+        // returns whether any of instances has been moved
+        bool updateBuffer(Context& context, Camera& camera) {
+            matrices.clear();
+            matrices.reserve(instances.size());
+
+            bool changed = false;
             for (const auto& instance : instances) {
                 if (instance->isHidden()) {
                     continue;
                 }
 
+                changed |= instance->isTransformChanged();
                 instance->update(context, camera);
 
-                data.emplace_back(instance->getModelMatrix());
+                matrices.emplace_back(instance->getModelMatrix());
             }
 
-            buffer->mapData(data.data(), data.size() * sizeof(glm::mat4));
+            buffer_changed = true;
+
+            return changed;
         }
 
         InstancedInstance(Lighting* lighting, ModelShader shader, const glm::vec3& position, uint32_t count)
                 : AbstractInstance(lighting, shader, position) {
-            initializeBuffer(count);
+            matrices.reserve(count);
         }
 
         explicit InstancedInstance(ModelShader shader, const glm::vec3& position, uint32_t count)
             : AbstractInstance(nullptr, shader, position) {
-            initializeBuffer(count);
+            matrices.reserve(count);
         }
     public:
         InstancedInstance(Lighting* lighting, const glm::vec3& position, uint32_t count = 4)
             : AbstractInstance(lighting, ModelShader::Instanced, position) {
-            initializeBuffer(count);
+            matrices.reserve(count);
         }
 
         explicit InstancedInstance(const glm::vec3& position, uint32_t count = 4)
             : AbstractInstance(nullptr, ModelShader::Instanced, position) {
-            initializeBuffer(count);
+            matrices.reserve(count);
         }
 
         ~InstancedInstance() override = default;
 
         InstancedInstance(const InstancedInstance& rhs)
             : AbstractInstance(nullptr, rhs.shader_type, rhs.position) {
-            initializeBuffer(4);
+            matrices.reserve(rhs.instances.size());
         }
         InstancedInstance(InstancedInstance&&) noexcept = default;
 
@@ -92,10 +104,12 @@ namespace Limitless {
 
         void addInstance(std::unique_ptr<ModelInstance> instance) {
             instances.emplace_back(std::move(instance));
+            transform_changed = true;
         }
 
         void removeInstance(size_t index) {
             instances.erase(instances.begin() + index);
+            transform_changed = true;
         }
 
         auto& getInstances() noexcept { return instances; }
@@ -112,22 +126,57 @@ namespace Limitless {
                 return;
             }
 
+            // instances are updated first, bounds depend on them
+            const auto changed = updateBuffer(context, camera);
+
             AbstractInstance::update(context, camera);
 
-            updateBuffer(context, camera);
+            // instances can move on their own
+            if (changed && !bounds_changed) {
+                calculateBoundingBox();
+                bounds_changed = true;
+            }
         }
 
         void draw(Context& ctx, const Assets& assets, ShaderPass pass, ms::Blending blending, const UniformSetter& uniform_set) override {
-            if (hidden || instances.empty()) {
+            // hidden instances have no matrix in buffer
+            if (hidden || matrices.empty()) {
                 return;
             }
 
-            buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, "model_buffer"));
+            bindBuffer(ctx);
 
             // iterates over all meshes
             for (auto& [name, mesh] : instances[0]->getMeshes()) {
-                mesh.draw_instanced(ctx, assets, pass, shader_type, model_matrix, blending, uniform_set, instances.size());
+                mesh.draw_instanced(ctx, assets, pass, shader_type, model_matrix, blending, uniform_set, static_cast<uint32_t>(matrices.size()));
+            }
+        }
+
+        // meshes of the first instance stand for all of them
+        void collect(RenderQueue& queue) override {
+            if (hidden || instances.empty()) {
+                return;
+            }
+
+            for (auto& [name, mesh] : instances[0]->getMeshes()) {
+                if (mesh.isHidden()) {
+                    continue;
+                }
+
+                for (const auto& [index, material] : mesh.getMaterial()) {
+                    queue.add(*this, mesh, index, *material);
+                }
+            }
+        }
+
+        void drawItem(Context& ctx, const Assets& assets, ShaderPass pass, const DrawItem& item, const UniformSetter& uniform_set) override {
+            if (matrices.empty()) {
+                return;
             }
+
+            bindBuffer(ctx);
+
+            item.mesh->drawLayerInstanced(ctx, assets, pass, shader_type, model_matrix, item.layer, uniform_set, static_cast<uint32_t>(matrices.size()));
         }
     };
 
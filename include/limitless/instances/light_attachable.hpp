@@ -24,11 +24,18 @@ namespace Limitless {
         };
 
         std::vector<LightAttachment<PointLight>> point_lights;
+
+        // instances may be moved from update jobs, lights are moved later by the scene
+        glm::vec3 light_position {};
+        bool lights_moved {};
     protected:
         void setPosition(const glm::vec3& position) noexcept;
         void setRotation(const glm::quat& rotation) noexcept;
         void rotateBy(const glm::quat& rotation) noexcept;
 
+        // moves attached lights to the last set position
+        void updateLights() noexcept;
+
         explicit LightAttachable(Lighting* _lighting) noexcept;
         LightAttachable() = default;
         virtual ~LightAttachable();
@@ -22,6 +22,7 @@ namespace Limitless {
         MeshInstance(const MeshInstance&) = default;
         MeshInstance(MeshInstance&&) = default;
 
+        [[nodiscard]] const auto& getMesh() const noexcept { return mesh; }
         [[nodiscard]] const auto& getMaterial() const noexcept { return material; }
         [[nodiscard]] auto& getMaterial() noexcept { return material; }
         [[nodiscard]] bool isHidden() const noexcept { return hidden; }
@@ -45,5 +46,23 @@ namespace Limitless {
                             ms::Blending blending,
                             const UniformSetter& uniform_setter,
                             uint32_t count);
+
+        // draws single material layer regardless of its blending
+        void drawLayer(Context& ctx,
+                       const Assets& assets,
+                       ShaderPass pass,
+                       ModelShader model,
+                       const glm::mat4& model_matrix,
+                       uint64_t layer,
+                       const UniformSetter& uniform_setter);
+
+        void drawLayerInstanced(Context& ctx,
+                                const Assets& assets,
+                                ShaderPass pass,
+                                ModelShader model,
+                                const glm::mat4& model_matrix,
+                                uint64_t layer,
+                                const UniformSetter& uniform_setter,
+                                uint32_t count);
     };
 }
\ No newline at end of file
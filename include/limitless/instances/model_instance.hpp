@@ -37,5 +37,8 @@ namespace Limitless {
 
         using AbstractInstance::draw;
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_setter) override;
+
+        void collect(RenderQueue& queue) override;
+        void drawItem(Context& ctx, const Assets& assets, ShaderPass shader_type, const DrawItem& item, const UniformSetter& uniform_setter) override;
     };
 }
\ No newline at end of file
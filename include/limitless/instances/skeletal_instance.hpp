@@ -2,13 +2,16 @@
 
 #include <limitless/instances/model_instance.hpp>
 #include <limitless/models/skeletal_model.hpp>
+#include <limitless/core/ring_buffer.hpp>
 #include <chrono>
 
 namespace Limitless {
     class SkeletalInstance final : public ModelInstance {
     private:
         std::vector<glm::mat4> bone_transform;
-        std::shared_ptr<Buffer> bone_buffer;
+
+        // bones are uploaded into frame ring buffer on first draw of frame, so that update does not touch the context
+        RingBuffer::Allocation bones;
 
         const Animation* animation {};
         bool paused {};
@@ -17,7 +20,7 @@ namespace Limitless {
         std::chrono::duration<double> animation_duration;
 
         void calculateBoundingBox() noexcept override;
-        void initializeBuffer();
+        void bindBones(Context& ctx);
 
         const AnimationNode* findAnimationNode(const Bone& bone) const noexcept;
     public:
@@ -60,5 +63,6 @@ namespace Limitless {
 
         using AbstractInstance::draw;
         void draw(Context& ctx, const Assets& assets, ShaderPass shader_type, ms::Blending blending, const UniformSetter& uniform_setter) override;
+        void drawItem(Context& ctx, const Assets& assets, ShaderPass shader_type, const DrawItem& item, const UniformSetter& uniform_setter) override;
     };
 }
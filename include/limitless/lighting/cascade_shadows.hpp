@@ -42,6 +42,9 @@ namespace Limitless {
         std::shared_ptr<Buffer> light_buffer;
         std::vector<glm::mat4> light_space;
 
+        // shadow casters that intersect corresponding cascade
+        std::vector<Instances> casters;
+
         void initBuffers(Context& context);
         void updateFrustums(Context& ctx, const Camera& camera);
         void updateLightMatrices(const DirectionalLight& light);
@@ -51,12 +54,13 @@ namespace Limitless {
 
         void update(Context& ctx, const RenderSettings& settings);
 
-        void draw(Instances& instances,
-                  const DirectionalLight& light,
-                  Context& ctx, const
-                  Assets& assets,
-                  const Camera& camera,
-                  fx::EffectRenderer* renderer);
+        // updates cascade matrices and collects casters for each cascade from the scene
+        void update(Context& ctx, const Camera& camera, const DirectionalLight& light, const Scene& scene);
+
+        [[nodiscard]] const auto& getCasters() const noexcept { return casters; }
+        [[nodiscard]] auto getSplitCount() const noexcept { return split_count; }
+
+        void draw(Context& ctx, const Assets& assets, fx::EffectRenderer* renderer);
         void setUniform(ShaderProgram& sh) const;
         void mapData() const;
     };
@@ -8,10 +8,8 @@ namespace Limitless {
 
     class Lighting final {
     private:
-        std::shared_ptr<Buffer> buffer;
         Context& context;
 
-        void createLightBuffer();
         void updateLightBuffer();
     public:
         // ambient lighting
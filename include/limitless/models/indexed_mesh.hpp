@@ -27,13 +27,12 @@ namespace Limitless {
                                             .build();
                     break;
                 case MeshDataType::Stream:
-//                    indices_buffer = builder.setUsage(Buffer::Storage::DynamicCoherentWrite)
-//                                            .setAccess(Buffer::ImmutableAccess::WriteCoherent)
-//                                            .buildTriple();
+                    // only vertices are streamed, indices are applied to current region with base vertex
+                    indices_buffer = builder.setUsage(Buffer::Storage::Static)
+                                            .setAccess(Buffer::ImmutableAccess::None)
+                                            .build();
                     break;
             }
-
-            this->vertex_array << *indices_buffer;
         }
 
         [[nodiscard]] constexpr GLenum getIndicesType() const noexcept {
@@ -47,12 +46,36 @@ namespace Limitless {
                 static_assert(!std::is_same<T1, T1>::value, "Wrong type for indices");
             }
         }
+    protected:
+        void attachBuffers(VertexArray& vertex_array) const noexcept override {
+            Mesh<T>::attachBuffers(vertex_array);
+            if (indices_buffer) {
+                vertex_array.setElementBuffer(*indices_buffer);
+            }
+        }
+
+        [[nodiscard]] const void* getFirstIndex() const noexcept {
+            return this->geometry ? reinterpret_cast<const void*>(this->geometry.get().indices.offset * sizeof(T1)) : nullptr; // NOLINT(performance-no-int-to-ptr)
+        }
+
+        void fence() const noexcept {
+            Mesh<T>::fence();
+            if (indices_buffer) {
+                indices_buffer->fence();
+            }
+        }
     public:
         IndexedMesh(std::vector<T>&& vertices, std::vector<T1>&& indices, std::string name, MeshDataType data_type, DrawMode draw_mode)
             : Mesh<T>{std::move(vertices), std::move(name), data_type, draw_mode}, indices{std::move(indices)} {
             initialize();
         }
 
+        // static mesh placed in geometry pool together with its indices, pool stores GLuint indices only
+        template<typename I = T1, typename = std::enable_if_t<std::is_same_v<I, GLuint>>>
+        IndexedMesh(std::vector<T>&& vertices, std::vector<T1>&& _indices, std::string name, DrawMode draw_mode, std::shared_ptr<GeometryPool> pool)
+            : Mesh<T>{std::move(vertices), std::move(name), draw_mode, std::move(pool), _indices}, indices{std::move(_indices)} {
+        }
+
         ~IndexedMesh() override = default;
 
         IndexedMesh(const IndexedMesh&) noexcept = delete;
@@ -62,30 +85,27 @@ namespace Limitless {
         IndexedMesh& operator=(IndexedMesh&&) noexcept = default;
 
         void draw() const noexcept override {
-            this->vertex_array.bind();
+            this->bindVertexArray();
 
-            glDrawElements(static_cast<GLenum>(this->draw_mode), indices.size(), getIndicesType(), nullptr);
+            glDrawElementsBaseVertex(static_cast<GLenum>(this->draw_mode), indices.size(), getIndicesType(), getFirstIndex(), this->getFirstVertex());
 
-            this->vertex_buffer->fence();
-            indices_buffer->fence();
+            fence();
         }
 
         void draw(DrawMode mode) const noexcept override {
-            this->vertex_array.bind();
+            this->bindVertexArray();
 
-            glDrawElements(static_cast<GLenum>(mode), indices.size(), getIndicesType(), nullptr);
+            glDrawElementsBaseVertex(static_cast<GLenum>(mode), indices.size(), getIndicesType(), getFirstIndex(), this->getFirstVertex());
 
-            this->vertex_buffer->fence();
-            indices_buffer->fence();
+            fence();
         }
 
         void draw_instanced(DrawMode mode, size_t count) const noexcept override {
-            this->vertex_array.bind();
+            this->bindVertexArray();
 
-            glDrawElementsInstanced(static_cast<GLenum>(mode), indices.size(), getIndicesType(), nullptr, count);
+            glDrawElementsInstancedBaseVertex(static_cast<GLenum>(mode), indices.size(), getIndicesType(), getFirstIndex(), count, this->getFirstVertex());
 
-            this->vertex_buffer->fence();
-            indices_buffer->fence();
+            fence();
         }
 
         auto& getIndices() noexcept { return indices; }
@@ -3,13 +3,18 @@
 #include <limitless/models/abstract_mesh.hpp>
 #include <limitless/core/vertex_array.hpp>
 #include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/geometry_pool.hpp>
+#include <stdexcept>
 
 namespace Limitless {
     template<typename T>
     class Mesh : public AbstractMesh {
     protected:
         std::unique_ptr<Buffer> vertex_buffer;
-        VertexArray vertex_array;
+        // vertex_buffer of stream meshes, they are drawn from its current region
+        TripleBuffer* stream {};
+        // range of geometry pool that static meshes can be placed in instead of own buffers
+        PooledGeometry geometry;
         std::vector<T> vertices;
 
         MeshDataType data_type;
@@ -35,20 +40,52 @@ namespace Limitless {
                                             .setAccess(Buffer::MutableAccess::WriteOrphaning)
                                             .build();
                     break;
-                case MeshDataType::Stream:
-//                    vertex_buffer = builder .setUsage(Buffer::Storage::DynamicCoherentWrite)
-//                                            .setAccess(Buffer::ImmutableAccess::WriteCoherent)
-//                                            .buildTriple();
-//TODO:
+                case MeshDataType::Stream: {
+                    auto triple = builder.buildTriple();
+                    stream = triple.get();
+                    vertex_buffer = std::move(triple);
                     break;
+                }
             }
-
-            vertex_array << std::pair<T, Buffer&>(T{}, *vertex_buffer);
         }
 
         void calculateBoundingBox() {
             bounding_box = Limitless::calculateBoundingBox(vertices);
         }
+    protected:
+        [[nodiscard]] GLint getFirstVertex() const noexcept {
+            if (geometry) {
+                return static_cast<GLint>(geometry.get().vertices.offset);
+            }
+            return stream ? static_cast<GLint>(stream->getOffset() / sizeof(T)) : 0;
+        }
+
+        // fences are not needed for pooled meshes, they are never updated
+        void fence() const noexcept {
+            if (vertex_buffer) {
+                vertex_buffer->fence();
+            }
+        }
+
+        // vertex array is shared by all meshes of the same layout in current context
+        [[nodiscard]] virtual VertexArray& getVertexArray() const {
+            return VertexArray::getShared({&getVertexFormat(T{})});
+        }
+
+        virtual void attachBuffers(VertexArray& vertex_array) const noexcept {
+            if (geometry) {
+                geometry.getPool()->attach(vertex_array);
+            } else {
+                vertex_array.setVertexBuffer(0, *vertex_buffer);
+            }
+        }
+
+        // consecutive draws of meshes with the same buffers do not rebind anything
+        void bindVertexArray() const {
+            auto& vertex_array = getVertexArray();
+            vertex_array.bind();
+            attachBuffers(vertex_array);
+        }
     public:
         Mesh(std::vector<T>&& _vertices, std::string _name, MeshDataType _data_type, DrawMode _draw_mode)
             : vertices {std::move(_vertices)}
@@ -70,6 +107,21 @@ namespace Limitless {
             calculateBoundingBox();
         }
 
+        // static mesh placed in pool, indices are allocated together with vertices
+        Mesh(std::vector<T>&& _vertices, std::string _name, DrawMode _draw_mode, std::shared_ptr<GeometryPool> pool, const std::vector<GLuint>& indices = {})
+            : vertices {std::move(_vertices)}
+            , data_type {MeshDataType::Static}
+            , draw_mode {_draw_mode}
+            , name {std::move(_name)} {
+
+            if (&pool->getFormat() != &getVertexFormat(T{})) {
+                throw std::logic_error{"Geometry pool format differs from mesh vertex format"};
+            }
+
+            geometry = {std::move(pool), vertices.data(), static_cast<GLuint>(vertices.size()), indices.data(), static_cast<GLuint>(indices.size())};
+            calculateBoundingBox();
+        }
+
         ~Mesh() override = default;
 
         Mesh(const Mesh&) = delete;
@@ -83,11 +135,11 @@ namespace Limitless {
                 return;
             }
 
-            vertex_array.bind();
+            bindVertexArray();
 
-            glDrawArrays(static_cast<GLenum>(draw_mode), 0, vertices.size());
+            glDrawArrays(static_cast<GLenum>(draw_mode), getFirstVertex(), vertices.size());
 
-            vertex_buffer->fence();
+            fence();
         }
 
         void draw(DrawMode mode) const noexcept override {
@@ -95,11 +147,11 @@ namespace Limitless {
                 return;
             }
 
-            vertex_array.bind();
+            bindVertexArray();
 
-            glDrawArrays(static_cast<GLenum>(mode), 0, vertices.size());
+            glDrawArrays(static_cast<GLenum>(mode), getFirstVertex(), vertices.size());
 
-            vertex_buffer->fence();
+            fence();
         }
 
         void draw_instanced(DrawMode mode, size_t count) const noexcept override {
@@ -107,20 +159,20 @@ namespace Limitless {
                 return;
             }
 
-            vertex_array.bind();
+            bindVertexArray();
 
-            glDrawArraysInstanced(static_cast<GLenum>(mode), 0, vertices.size(), count);
+            glDrawArraysInstanced(static_cast<GLenum>(mode), getFirstVertex(), vertices.size(), count);
 
-            vertex_buffer->fence();
+            fence();
         }
 
+        // not available for pooled meshes
         template<typename Vertices>
         void updateVertices(Vertices&& new_vertices) {
             vertices = std::forward<Vertices>(new_vertices);
 
             if (vertices.size() * sizeof(T) > vertex_buffer->getSize()) {
                 vertex_buffer->resize(vertices.size() * sizeof(T));
-                vertex_array << std::pair<T, Buffer&>(T{}, *vertex_buffer);
             }
 
             vertex_buffer->mapData(vertices.data(), sizeof(T) * vertices.size());
@@ -131,5 +183,7 @@ namespace Limitless {
         [[nodiscard]] std::string& getName() noexcept override { return name; }
         [[nodiscard]] const auto& getVertices() const noexcept { return vertices; }
         [[nodiscard]] DrawMode getDrawMode() const noexcept override { return draw_mode; }
+        [[nodiscard]] auto getDataType() const noexcept { return data_type; }
+        [[nodiscard]] const auto& getGeometry() const noexcept { return geometry; }
     };
 }
\ No newline at end of file
@@ -30,6 +30,14 @@ namespace Limitless {
         }
     };
 
+    inline const VertexFormat& getVertexFormat(const VertexBoneWeight&) noexcept {
+        static const VertexFormat format {{
+            { 4, VertexBoneWeight::BONE_COUNT, GL_INT, GL_FALSE, offsetof(VertexBoneWeight, bone_index) },
+            { 5, VertexBoneWeight::BONE_COUNT, GL_FLOAT, GL_FALSE, offsetof(VertexBoneWeight, weight) },
+        }, sizeof(VertexBoneWeight) };
+        return format;
+    }
+
     template<typename T, typename T1>
     class SkinnedMesh : public IndexedMesh<T, T1> {
     private:
@@ -44,10 +52,17 @@ namespace Limitless {
                                  .setData(bone_weights.data())
                                  .setDataSize(bone_weights.size() * sizeof(VertexBoneWeight))
                                  .build();
-
-            this->vertex_array.setAttribute(4, VertexAttribute{VertexBoneWeight::BONE_COUNT, GL_INT, GL_FALSE, sizeof(VertexBoneWeight), (GLvoid*)offsetof(VertexBoneWeight, bone_index), *bone_buffer});
-            this->vertex_array.setAttribute(5, VertexAttribute{VertexBoneWeight::BONE_COUNT, GL_FLOAT, GL_FALSE, sizeof(VertexBoneWeight), (GLvoid*)offsetof(VertexBoneWeight, weight), *bone_buffer});
         };
+    protected:
+        // bone weights are sourced from second binding
+        [[nodiscard]] VertexArray& getVertexArray() const override {
+            return VertexArray::getShared({&getVertexFormat(T{}), &getVertexFormat(VertexBoneWeight{})});
+        }
+
+        void attachBuffers(VertexArray& vertex_array) const noexcept override {
+            IndexedMesh<T, T1>::attachBuffers(vertex_array);
+            vertex_array.setVertexBuffer(1, *bone_buffer);
+        }
     public:
         SkinnedMesh(std::vector<T>&& vertices, std::vector<T1>&& indices, std::vector<VertexBoneWeight>&& bones, std::string material, MeshDataType data_type, DrawMode draw_mode)
             : IndexedMesh<T, T1>{std::move(vertices), std::move(indices), std::move(material), data_type, draw_mode}, bone_weights{std::move(bones)} {
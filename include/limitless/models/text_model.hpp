@@ -1,15 +1,14 @@
 #include <limitless/core/vertex_array.hpp>
+#include <limitless/core/triple_buffer.hpp>
 #include <limitless/core/vertex.hpp>
 #include <memory>
 #include <vector>
 
 namespace Limitless {
-    class Buffer;
-
+    // text is rebuilt on change and streamed through triple buffer
     class TextModel {
     private:
-        VertexArray vertex_array;
-        std::shared_ptr<Buffer> buffer;
+        std::unique_ptr<TripleBuffer> buffer;
         std::vector<TextVertex> vertices;
 
         void initialize(size_t count);
@@ -5,6 +5,7 @@
 #include <limitless/ms/property.hpp>
 #include <limitless/ms/blending.hpp>
 #include <limitless/ms/shading.hpp>
+#include <limitless/ms/material_storage.hpp>
 
 #include <unordered_map>
 #include <glm/glm.hpp>
@@ -12,10 +13,6 @@
 #include <vector>
 #include <map>
 
-namespace Limitless {
-    class Buffer;
-}
-
 namespace Limitless::ms {
     class material_property_not_found : public std::runtime_error {
     public:
@@ -47,8 +44,14 @@ namespace Limitless::ms {
         // contains ModelShader type for which this material is used
         ModelShaders model_shaders;
 
-        // opengl buffer that stores properties
-        std::shared_ptr<Buffer> material_buffer;
+        // place of properties in buffer shared with other materials
+        std::unique_ptr<MaterialBlock> block;
+
+        // time uniforms change every frame
+        bool animated {};
+
+        // samplers are set per material, so its draws are not batched with other materials
+        bool textured {};
 
         // properties offsets in the buffer
         std::unordered_map<std::string, uint64_t> uniform_offsets;
@@ -69,10 +72,13 @@ namespace Limitless::ms {
         std::string tessellation_snippet;
 
         template<typename V>
-        void map(std::vector<std::byte>& block, const Uniform& uniform) const;
-        void map(std::vector<std::byte>& block, Uniform& uniform);
+        void map(std::byte* block, const Uniform& uniform) const;
+        void map(std::byte* block, Uniform& uniform);
         void map();
 
+        // subscribes block to changes of uniforms
+        void observe();
+
         friend void swap(Material&, Material&) noexcept;
         Material() = default;
 
@@ -130,7 +136,9 @@ namespace Limitless::ms {
         [[nodiscard]] const auto& getFragmentSnippet() const noexcept { return fragment_snippet; }
         [[nodiscard]] const auto& getGlobalSnippet() const noexcept { return global_snippet; }
         [[nodiscard]] const auto& getTessellationSnippet() const noexcept { return tessellation_snippet; }
-        [[nodiscard]] const auto& getMaterialBuffer() const noexcept { return material_buffer; }
+        [[nodiscard]] const auto& getBlock() const noexcept { return *block; }
+        [[nodiscard]] const auto& getUniformOffsets() const noexcept { return uniform_offsets; }
+        [[nodiscard]] auto isTextured() const noexcept { return textured; }
         [[nodiscard]] const auto& getProperties() const noexcept { return properties; }
         [[nodiscard]] const auto& getUniforms() const noexcept { return uniforms; }
 
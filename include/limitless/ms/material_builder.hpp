@@ -31,7 +31,7 @@ namespace Limitless::ms {
 
         Assets& assets;
 
-        [[nodiscard]] UniqueMaterial getMaterialType() const noexcept;
+        [[nodiscard]] UniqueMaterial getMaterialType() const;
         void initializeMaterialBuffer();
         void checkRequirements();
         void setMaterialIndex();
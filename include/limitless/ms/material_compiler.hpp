@@ -19,9 +19,16 @@ namespace Limitless::ms {
 
         static std::string getCustomMaterialScalarUniforms(const Material& material) noexcept;
         static std::string getCustomMaterialSamplerUniforms(const Material& material) noexcept;
+        // layout of material block in batched programs, see MaterialStorage
+        static std::string getMaterialBatchPadding(const Material& material);
+        static std::string getMaterialBatchMembers(const Material& material);
         std::string getMaterialDefines(const Material& material) noexcept;
         static std::string getModelDefines(const ModelShader& type);
 
+        static bool hasPBRProperties(const Material& material) noexcept;
+        // render settings defines that programs of material can use
+        static std::vector<std::string> getWatchedDefines(const Material& material);
+
         void replaceMaterialSettings(Shader& shader, const Material& material, ModelShader model_shader) noexcept;
         void replaceRenderSettings(Shader& src) noexcept;
     public:
@@ -30,5 +37,8 @@ namespace Limitless::ms {
 
         using ShaderCompiler::compile;
         void compile(const Material& material, ShaderPass pass_shader, ModelShader model_shader);
+
+        // returns defines that differ between settings, programs that use them have to be compiled again
+        static std::vector<std::string> getChangedDefines(const RenderSettings& lhs, const RenderSettings& rhs);
     };
 }
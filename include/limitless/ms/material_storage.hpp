@@ -0,0 +1,99 @@
+#pragma once
+
+#include <limitless/core/uniform.hpp>
+#include <memory>
+#include <vector>
+#include <mutex>
+
+namespace Limitless {
+    class Buffer;
+}
+
+namespace Limitless::ms {
+    // data blocks of all materials with the same block size packed into one uniform buffer
+    //
+    // material block is bound as range of the shared buffer, so materials do not own buffer objects
+    // and switching between them does not switch buffers;
+    // blocks are written into client copy and changed bytes are uploaded as one range before next bind;
+    // storages are kept by context, see ContextState::getMaterialStorage
+    //
+    // batched shaders declare material block as array of batch size and index it per draw,
+    // so draws of different materials are submitted together with one range bound for all of them;
+    // stride is a multiple of 16 to match std140 array stride of the block
+    //
+    // blocks may be allocated and freed by loading threads while context thread writes and binds them,
+    // so client copy is changed only under lock
+    class MaterialStorage final {
+    private:
+        mutable std::mutex mutex;
+
+        std::shared_ptr<Buffer> buffer;
+        std::vector<std::byte> data;
+        std::vector<uint32_t> free_slots;
+        size_t block_size;
+        // block size aligned to uniform buffer offset alignment
+        size_t stride;
+        // count of blocks in range bound for batched draws
+        uint32_t batch_size;
+        uint32_t slot_count {};
+
+        // [begin, end) bytes of client copy that differ from buffer
+        size_t dirty_begin {};
+        size_t dirty_end {};
+
+        void upload();
+    public:
+        explicit MaterialStorage(size_t block_size);
+        ~MaterialStorage() = default;
+
+        MaterialStorage(const MaterialStorage&) = delete;
+        MaterialStorage& operator=(const MaterialStorage&) = delete;
+
+        uint32_t allocate();
+        void free(uint32_t slot) noexcept;
+
+        // copies block into client copy, it is uploaded on next bind
+        void write(uint32_t slot, const std::byte* block);
+
+        void bind(uint32_t slot, GLuint binding_point);
+
+        // binds blocks [slot, slot + batch size), batched draws index them from slot
+        void bindBatch(uint32_t slot, GLuint binding_point);
+
+        [[nodiscard]] auto getBlockSize() const noexcept { return block_size; }
+        [[nodiscard]] auto getStride() const noexcept { return stride; }
+        [[nodiscard]] auto getBatchSize() const noexcept { return batch_size; }
+        [[nodiscard]] uint32_t getSlotCount() const;
+        [[nodiscard]] const auto& getBuffer() const noexcept { return buffer; }
+    };
+
+    // slot of one material in storage
+    // uniforms of material report their changes here, so material is remapped only after a change
+    class MaterialBlock final : public UniformObserver {
+    private:
+        std::shared_ptr<MaterialStorage> storage;
+        uint32_t slot;
+        // block is mapped here and copied into storage at once
+        std::vector<std::byte> data;
+        bool changed {true};
+    public:
+        explicit MaterialBlock(std::shared_ptr<MaterialStorage> storage);
+        ~MaterialBlock() override;
+
+        MaterialBlock(const MaterialBlock&) = delete;
+        MaterialBlock& operator=(const MaterialBlock&) = delete;
+
+        void onUniformChange([[maybe_unused]] Uniform& uniform) noexcept override { changed = true; }
+
+        // returns data of block to be mapped and resets change
+        std::byte* write() noexcept;
+        // copies mapped data into storage
+        void commit() { storage->write(slot, data.data()); }
+
+        void bind(GLuint binding_point) const { storage->bind(slot, binding_point); }
+
+        [[nodiscard]] auto isChanged() const noexcept { return changed; }
+        [[nodiscard]] auto getSlot() const noexcept { return slot; }
+        [[nodiscard]] const auto& getStorage() const noexcept { return storage; }
+    };
+}
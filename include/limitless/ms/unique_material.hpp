@@ -3,12 +3,23 @@
 #include <limitless/ms/property.hpp>
 #include <limitless/ms/shading.hpp>
 
+#include <string>
 #include <set>
 
 namespace Limitless::ms {
+    // everything that material puts into shader source
+    // materials with equal keys share compiled shaders
     struct UniqueMaterial {
         std::set<Property> properties;
         Shading shading;
+
+        std::string vertex_snippet;
+        std::string fragment_snippet;
+        std::string global_snippet;
+        std::string tessellation_snippet;
+
+        // declarations of custom uniforms
+        std::string uniforms;
     };
     bool operator<(const UniqueMaterial&, const UniqueMaterial&) noexcept;
-}
\ No newline at end of file
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <limitless/pipeline/render_queue.hpp>
+#include <limitless/pipeline/gpu_culling.hpp>
+#include <limitless/core/geometry_pool.hpp>
+#include <limitless/core/context_debug.hpp>
+#include <unordered_map>
+#include <memory>
+
+namespace Limitless {
+    class AbstractMesh;
+    class UniformSetter;
+    class Context;
+    class Assets;
+    class Camera;
+    class Buffer;
+    enum class ShaderPass;
+
+    // draws runs of render queue items that share program as single glMultiDrawElementsIndirect call
+    //
+    // static indexed meshes are drawn from geometry pool they were loaded into,
+    // others are copied into own pool of renderer on first use and freed when they are gone;
+    // every draw gets its command in indirect buffer and its model matrix in batch_buffer SSBO;
+    // shader finds its draw by per-instance draw_id attribute that starts at command's baseInstance
+    //
+    // materials without samplers that share program and material storage are drawn in one run,
+    // their blocks are bound as one range and every draw indexes block of its material in it
+    //
+    // with gpu culling batched draws are culled by compute shader and the rest on cpu,
+    // so CullingPass is not needed
+    class BatchRenderer final {
+    private:
+        // layout of GL DrawElementsIndirectCommand
+        struct Command {
+            GLuint count;
+            GLuint instance_count;
+            GLuint first_index;
+            GLint base_vertex;
+            GLuint base_instance;
+        };
+
+        // std430 layout of BatchedDraw in batched_buffer.glsl
+        // material index is the slot of draw material counted from the first slot of run
+        struct Draw {
+            glm::mat4 model;
+            GLuint material_index;
+            GLuint padding[3];
+        };
+
+        // meshes that cannot be batched are kept too, so they are checked only once
+        struct Entry {
+            std::weak_ptr<AbstractMesh> mesh;
+            // copy of geometry when mesh is not pooled
+            PooledGeometry copy;
+            // geometry of mesh or its copy
+            const PooledGeometry* geometry;
+            bool batchable;
+        };
+
+        // consecutive items of bucket with compatible materials and the same pool drawn either with one call or one by one
+        struct Run {
+            const DrawItem* first;
+            uint32_t count;
+            uint32_t first_command;
+            // number among batched runs
+            uint32_t index;
+            // lowest material slot of items, range of material blocks is bound from it
+            uint32_t first_slot;
+            bool batched;
+        };
+
+        std::unordered_map<const AbstractMesh*, Entry> entries;
+        std::shared_ptr<GeometryPool> geometry_pool;
+        std::unique_ptr<Buffer> draw_id_buffer;
+        bool entries_added {};
+
+        // per bucket data
+        std::unique_ptr<Buffer> command_buffer;
+        std::shared_ptr<Buffer> draw_buffer;
+        std::vector<Command> commands;
+        std::vector<Draw> draws;
+        std::vector<Run> runs;
+
+        std::unique_ptr<GpuCulling> culling;
+
+        bool isBatchable(const DrawItem& item, const Assets& assets, ShaderPass pass);
+
+        [[nodiscard]] const GeometryPool* getPool(const DrawItem& item) const;
+
+        void initialize(Context& ctx);
+        void removeExpired();
+        void upload();
+        void submit(Context& ctx, const Assets& assets, ShaderPass pass, const Run& run, const UniformSetter& setter);
+    public:
+        // culling is enabled only if supported
+        explicit BatchRenderer(bool gpu_culling = false, bool occlusion_culling = false);
+        ~BatchRenderer();
+
+        BatchRenderer(const BatchRenderer&) = delete;
+        BatchRenderer& operator=(const BatchRenderer&) = delete;
+
+        // multi draw indirect with base instance and SSBO
+        static bool isSupported() noexcept;
+
+        // draws whole bucket in its order, items that cannot be batched are drawn as usual
+        void draw(Context& ctx, const Assets& assets, ShaderPass pass, const Camera& camera, RenderQueue::Bucket bucket, const UniformSetter& setter);
+
+        [[nodiscard]] auto* getCulling() noexcept { return culling.get(); }
+        [[nodiscard]] auto getCommandCount() const noexcept { return commands.size(); }
+        [[nodiscard]] auto getMeshCount() const noexcept { return entries.size(); }
+        [[nodiscard]] const auto* getGeometryPool() const noexcept { return geometry_pool.get(); }
+    };
+}
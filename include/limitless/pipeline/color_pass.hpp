@@ -7,11 +7,18 @@ namespace Limitless::ms {
 }
 
 namespace Limitless {
+    class RenderQueue;
+    class BatchRenderer;
+
+    // draws bucket of render queue with specified blending
     class ColorPass final : public RenderPass {
     private:
+        const RenderQueue& queue;
+        BatchRenderer* batches;
         ms::Blending blending;
     public:
-        explicit ColorPass(RenderPass* prev, ms::Blending blending);
+        // batches are optional, without them every item is drawn separately
+        ColorPass(RenderPass* prev, const RenderQueue& queue, BatchRenderer* batches, ms::Blending blending);
         ~ColorPass() override = default;
 
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, const UniformSetter& setter) override;
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <limitless/pipeline/render_pass.hpp>
+
+namespace Limitless {
+    // replaces instances passed to subsequent passes with ones that intersect camera frustum
+    // queries spatial index of the scene, so it can be added anywhere after SceneUpdatePass
+    class CullingPass final : public RenderPass {
+    private:
+        uint64_t total_count {};
+        uint64_t visible_count {};
+    public:
+        explicit CullingPass(RenderPass* prev) noexcept;
+        ~CullingPass() override = default;
+
+        [[nodiscard]] auto getTotalCount() const noexcept { return total_count; }
+        [[nodiscard]] auto getVisibleCount() const noexcept { return visible_count; }
+
+        void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <limitless/pipeline/render_pass.hpp>
+
+namespace Limitless {
+    class GpuCulling;
+
+    // reduces depth of the frame into pyramid that GpuCulling tests draws against in the next frame
+    // should be added after opaque ColorPass, so that depth contains only occluders
+    class DepthPyramidPass final : public RenderPass {
+    private:
+        GpuCulling& culling;
+    public:
+        DepthPyramidPass(RenderPass* prev, GpuCulling& culling) noexcept;
+        ~DepthPyramidPass() override = default;
+
+        void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, const UniformSetter& setter) override;
+    };
+}
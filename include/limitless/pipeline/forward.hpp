@@ -1,18 +1,22 @@
 #pragma once
 
 #include <limitless/pipeline/pipeline.hpp>
+#include <limitless/pipeline/render_settings.hpp>
 
 namespace Limitless {
     class ContextEventObserver;
-    class RenderSettings;
 
     class Forward final : public Pipeline {
     private:
+        // settings passes are created with
+        RenderSettings applied_settings;
+
         void create(ContextEventObserver& ctx, const RenderSettings& settings);
     public:
         explicit Forward(ContextEventObserver& ctx, const RenderSettings& settings);
         ~Forward() override = default;
 
+        // recreates only passes that depend on changed settings, framebuffers and shadow maps of others are kept
         void update(ContextEventObserver& ctx, Scene& scene, const RenderSettings& settings) override;
     };
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <limitless/util/bounding_box.hpp>
+#include <limitless/core/context_debug.hpp>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace Limitless {
+    class Context;
+    class Camera;
+    class Assets;
+    class Buffer;
+    class Texture;
+
+    // culls indirect draw commands with compute shader
+    //
+    // every draw has its bounds, the run it belongs to and the first command slot of that run;
+    // draws that intersect camera frustum (and optionally are not hidden behind depth of previous frame)
+    // are compacted to the beginning of their run in output buffer, the rest of run is left empty
+    class GpuCulling final {
+    private:
+        // std430 layout of CullDraw in culling.cs
+        struct Draw {
+            glm::vec3 center;
+            GLuint run;
+            glm::vec3 extent;
+            GLuint first;
+        };
+
+        std::vector<Draw> draws;
+
+        std::shared_ptr<Buffer> draw_buffer;
+        std::shared_ptr<Buffer> output_buffer;
+        std::shared_ptr<Buffer> count_buffer;
+
+        // max depth pyramid of previous frame and matrix it was rendered with
+        std::shared_ptr<Texture> depth_pyramid;
+        glm::mat4 pyramid_view_projection {1.0f};
+        GLsizei pyramid_levels {};
+        bool occlusion;
+
+        void initialize(Context& ctx);
+        void reserve(size_t run_count);
+    public:
+        explicit GpuCulling(bool occlusion);
+        ~GpuCulling();
+
+        GpuCulling(const GpuCulling&) = delete;
+        GpuCulling& operator=(const GpuCulling&) = delete;
+
+        // compute shaders with SSBO, depth pyramid needs image store and immutable textures as well
+        static bool isSupported() noexcept;
+
+        // indirect count lets draws skip empty tail of runs
+        static bool isCountSupported() noexcept;
+
+        void clear() noexcept;
+        void add(const BoundingBox& box, uint32_t run, uint32_t first_command);
+
+        // dispatches culling of added draws, commands contain input command for every draw in the same order
+        void cull(Context& ctx, const Assets& assets, const Camera& camera, const Buffer& commands, size_t run_count);
+
+        // reduces depth of finished frame for occlusion culling in the next one
+        void updateDepthPyramid(Context& ctx, const Assets& assets, const std::shared_ptr<Texture>& depth, const Camera& camera);
+
+        [[nodiscard]] auto& getOutput() const noexcept { return *output_buffer; }
+        [[nodiscard]] auto& getCounts() const noexcept { return *count_buffer; }
+        [[nodiscard]] bool isOcclusionEnabled() const noexcept { return occlusion; }
+        [[nodiscard]] auto getDrawCount() const noexcept { return draws.size(); }
+    };
+}
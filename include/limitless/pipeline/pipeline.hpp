@@ -2,6 +2,7 @@
 
 #include <limitless/pipeline/render_pass.hpp>
 
+#include <algorithm>
 #include <vector>
 #include <memory>
 
@@ -12,6 +13,31 @@ namespace Limitless {
     class Pipeline {
     protected:
         std::vector<std::unique_ptr<RenderPass>> passes;
+
+        // passes of the previous configuration, which are kept by update if settings they depend on are the same
+        std::vector<std::unique_ptr<RenderPass>> previous;
+
+        // takes next pass of the type from previous configuration or adds new one if there is none
+        template<typename Pass, typename... Args>
+        Pass& reuse(Args&&... args) {
+            const auto found = std::find_if(previous.begin(), previous.end(), [] (const auto& pass) { return dynamic_cast<Pass*>(pass.get()); });
+            if (found == previous.end()) {
+                return add<Pass>(std::forward<Args>(args)...);
+            }
+
+            auto* pass = static_cast<Pass*>(found->release());
+            previous.erase(found);
+
+            pass->setPrevious(passes.empty() ? nullptr : passes.back().get());
+            passes.emplace_back(pass);
+            return *pass;
+        }
+
+        // destroys previous passes of the type, so they are created again
+        template<typename Pass>
+        void discard() {
+            previous.erase(std::remove_if(previous.begin(), previous.end(), [] (const auto& pass) { return dynamic_cast<Pass*>(pass.get()); }), previous.end());
+        }
     public:
         Pipeline() = default;
         virtual ~Pipeline() = default;
@@ -26,6 +52,8 @@ namespace Limitless {
 
         virtual void update(ContextEventObserver& ctx, Scene& scene, const RenderSettings& settings);
 
+        [[nodiscard]] const auto& getPasses() const noexcept { return passes; }
+
         void clear();
         void draw(Context& context, const Assets& assets, Scene& scene, Camera& camera);
     };
@@ -19,6 +19,9 @@ namespace Limitless {
         explicit RenderPass(RenderPass *pass) noexcept;
         virtual ~RenderPass() = default;
 
+        // relinks pass when pipeline is rebuilt around it
+        void setPrevious(RenderPass* pass) noexcept;
+
         virtual RenderTarget& getTarget();
         virtual void addSetter(UniformSetter& setter);
         virtual void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera);
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace Limitless::ms {
+    enum class Blending;
+    class Material;
+}
+
+namespace Limitless {
+    class AbstractInstance;
+    class MeshInstance;
+    class Camera;
+
+    // single material layer of an instance mesh
+    struct DrawItem {
+        AbstractInstance* instance;
+        MeshInstance* mesh;
+        const ms::Material* material;
+        uint64_t layer;
+    };
+
+    // flat list of draw items ordered by packed 64-bit keys
+    //
+    // key layout, from the most significant bit:
+    //   blending (3) | shader (21) | material (16) | depth (24)              - opaque, additive, modulate
+    //   blending (3) | inverted depth (24) | shader (21) | material (16)     - translucent
+    //
+    // so that every blending gets a contiguous bucket; opaque is drawn front to back grouped by state,
+    // order independent blendings only by state and translucent back to front
+    class RenderQueue final {
+    private:
+        static constexpr uint32_t blending_count = 8;
+
+        struct Entry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        std::vector<DrawItem> items;
+        std::vector<Entry> entries;
+        std::vector<Entry> scratch;
+        std::vector<DrawItem> sorted;
+
+        // [begin, end) of sorted items for every blending
+        std::array<uint32_t, blending_count + 1> buckets {};
+
+        glm::vec3 camera_position {};
+        glm::vec3 camera_front {};
+
+        [[nodiscard]] uint64_t makeKey(const AbstractInstance& instance, const ms::Material& material) const noexcept;
+    public:
+        class Bucket {
+        private:
+            const DrawItem* first;
+            const DrawItem* last;
+        public:
+            Bucket(const DrawItem* first, const DrawItem* last) noexcept : first {first}, last {last} {}
+
+            [[nodiscard]] auto begin() const noexcept { return first; }
+            [[nodiscard]] auto end() const noexcept { return last; }
+            [[nodiscard]] auto size() const noexcept { return static_cast<size_t>(last - first); }
+            [[nodiscard]] bool empty() const noexcept { return first == last; }
+        };
+
+        RenderQueue() = default;
+        ~RenderQueue() = default;
+
+        // clears queue keeping its memory, depth is measured along camera view direction
+        void begin(const Camera& camera);
+
+        void add(AbstractInstance& instance, MeshInstance& mesh, uint64_t layer, const ms::Material& material);
+
+        // orders all items with radix sort on their keys
+        void sort();
+
+        [[nodiscard]] Bucket getBucket(ms::Blending blending) const noexcept;
+        [[nodiscard]] auto size() const noexcept { return items.size(); }
+    };
+}
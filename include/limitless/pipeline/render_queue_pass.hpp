@@ -0,0 +1,28 @@
+#pragma once
+
+#include <limitless/pipeline/render_pass.hpp>
+#include <limitless/pipeline/render_queue.hpp>
+#include <limitless/pipeline/batch_renderer.hpp>
+
+namespace Limitless {
+    class RenderSettings;
+
+    // builds and sorts render queue of instances passed to it once per frame
+    // should be added after CullingPass, ColorPass consumes the queue by blending
+    class RenderQueuePass final : public RenderPass {
+    private:
+        RenderQueue queue;
+
+        // shared by color passes, created only when batching is enabled
+        std::unique_ptr<BatchRenderer> batches;
+    public:
+        RenderQueuePass(RenderPass* prev, const RenderSettings& settings);
+        ~RenderQueuePass() override = default;
+
+        [[nodiscard]] auto& getQueue() noexcept { return queue; }
+        [[nodiscard]] const auto& getQueue() const noexcept { return queue; }
+        [[nodiscard]] auto* getBatches() noexcept { return batches.get(); }
+
+        void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
+    };
+}
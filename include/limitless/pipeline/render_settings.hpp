@@ -20,6 +20,14 @@ namespace Limitless {
         bool physically_based_render = true;
         bool normal_mapping = true;
 
+        // draws static meshes that share material with single multi draw indirect call
+        bool batching = true;
+
+        // culls batched draws with compute shader instead of CullingPass
+        bool gpu_culling = false;
+        // also culls draws hidden behind depth of the previous frame
+        bool occlusion_culling = false;
+
         // lighting settings
         // static constexpr auto MAX_POINT_LIGHTS_INFLUENCE {-1}; // -1 for unlimited
         // static constexpr auto HIGH_DYNAMIC_RANGE {true};
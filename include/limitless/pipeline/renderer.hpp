@@ -18,6 +18,8 @@ namespace Limitless {
     class Renderer final {
     private:
         RenderSettings settings;
+        // settings pipeline and shaders are built with, update rebuilds what differs from them
+        RenderSettings applied_settings;
         std::unique_ptr<Pipeline> pipeline;
     public:
         Renderer(std::unique_ptr<Pipeline> pipeline, const RenderSettings& settings);
@@ -1,12 +1,10 @@
 #pragma once
 
-#include <memory>
 #include <glm/glm.hpp>
 
 namespace Limitless {
     class Context;
     class Camera;
-    class Buffer;
 
     struct SceneData {
         glm::mat4 projection {1.0f};
@@ -15,13 +13,13 @@ namespace Limitless {
         glm::vec4 camera_position {};
     };
 
+    // uploads scene data into frame ring buffer every frame
     class SceneDataStorage final {
     private:
         SceneData scene_data;
-        std::shared_ptr<Buffer> buffer;
     public:
-        explicit SceneDataStorage(Context& context);
-        ~SceneDataStorage();
+        SceneDataStorage() = default;
+        ~SceneDataStorage() = default;
 
         SceneDataStorage(const SceneDataStorage&) = delete;
         SceneDataStorage(SceneDataStorage&&) = delete;
@@ -18,7 +18,8 @@ namespace Limitless {
         Skeletal,
         Instanced,
         SkeletalInstanced,
-        Effect
+        Effect,
+        Batched
     };
 
     using PassShaders = std::set<ShaderPass>;
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <limitless/pipeline/shader_pass_types.hpp>
+#include <limitless/core/framebuffer.hpp>
+#include <limitless/core/buffer.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Limitless::ms {
+    class Material;
+}
+
+namespace Limitless {
+    class Context;
+    class Assets;
+    class ShaderProgram;
+
+    // draws compiled programs once into small offscreen framebuffer,
+    // so drivers finish compiling them before frames use them
+    //
+    // draw uses blending, culling and depth state that passes set for material of the program,
+    // and target of the same formats, because drivers compile variants for these too;
+    // vertices of listed programs are taken from cube mesh and draw covers a single pixel;
+    // model, bone and batch buffers that instances bind themselves are replaced by zeroed storage buffer
+    //
+    // programs are warmed in order of listed materials, then of passes, then of model shaders;
+    // ShaderStats of the context tell how many first uses of programs were cold and how long they took
+    class ShaderWarmUp final {
+    public:
+        struct Entry {
+            std::shared_ptr<ShaderProgram> program;
+            ShaderPass pass;
+            ModelShader model;
+            const ms::Material* material;
+            // sprite emitters are drawn as points
+            bool points;
+        };
+    private:
+        Framebuffer target;
+        // shadow maps do not have color attachment
+        Framebuffer depth_target;
+        // bound in place of storage buffers of instanced, skeletal and batched models
+        std::unique_ptr<Buffer> placeholder;
+
+        // materials warmed first, in listed order
+        std::vector<std::string> materials;
+        // passes that are warmed, in order of priority
+        std::vector<ShaderPass> passes {ShaderPass::Forward, ShaderPass::DirectionalShadow, ShaderPass::Skybox};
+        ModelShaders models {ModelShader::Model, ModelShader::Skeletal, ModelShader::Instanced,
+                             ModelShader::SkeletalInstanced, ModelShader::Effect, ModelShader::Batched};
+
+        static void setState(Context& ctx, const Entry& entry);
+        void draw(Context& ctx, const Assets& assets, const Entry& entry);
+    public:
+        // requires current context
+        ShaderWarmUp();
+        ~ShaderWarmUp() = default;
+
+        ShaderWarmUp& setMaterials(std::vector<std::string> names);
+        ShaderWarmUp& setPasses(std::vector<ShaderPass> passes);
+        ShaderWarmUp& setModelShaders(ModelShaders models);
+
+        // stored programs of listed passes and model shaders, in order they are warmed
+        [[nodiscard]] std::vector<Entry> getEntries(const Assets& assets) const;
+
+        // draws programs that were neither warmed nor used yet until budget runs out
+        // should be called when compiling threads are done; programs that are still linked are skipped
+        // viewport, capabilities, depth, culling and blending state of context are restored after drawing
+        // returns whether all listed programs are warm
+        bool warm(Context& ctx, const Assets& assets, std::chrono::nanoseconds budget = std::chrono::nanoseconds::max());
+    };
+}
@@ -19,6 +19,8 @@ namespace Limitless {
         DirectionalShadowPass(RenderPass* prev, Context& ctx, const RenderSettings& settings, fx::EffectRenderer& renderer);
         ~DirectionalShadowPass() override = default;
 
+        [[nodiscard]] const auto& getShadows() const noexcept { return shadows; }
+
         void addSetter(UniformSetter& setter) override;
         void update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) override;
         void draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, const UniformSetter& setter) override;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <limitless/lighting/lighting.hpp>
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/util/aabb_tree.hpp>
+#include <limitless/util/job_system.hpp>
 #include <stdexcept>
 #include <unordered_map>
 #include <memory>
@@ -16,10 +19,36 @@ namespace Limitless {
     public:
         Lighting lighting;
     private:
+        // translation, rotation and scale of all instances in contiguous arrays
+        TransformStore transforms;
+
         std::unordered_map<uint64_t, std::unique_ptr<AbstractInstance>> instances;
         std::shared_ptr<Skybox> skybox;
 
+        // spatial index over instance bounds, refitted during update
+        AABBTree<AbstractInstance*> tree;
+
+        // count of model matrices rebuilt during last update
+        uint64_t rebuilt_matrix_count {};
+
+        // workers for parallel update; instances are updated on the calling thread if there are none
+        std::unique_ptr<JobSystem> update_jobs;
+        uint32_t update_thread_count {1};
+
+        // instances to update, models go before effects
+        std::vector<AbstractInstance*> update_models;
+        std::vector<AbstractInstance*> update_effects;
+
+        void updateInstances(const std::vector<AbstractInstance*>& list, Context& context, Camera& camera);
+
+        // finishes update of instance with what is not safe to do from update jobs
+        void updateSerial(AbstractInstance& instance);
+
         void removeDeadInstances() noexcept;
+        void attach(AbstractInstance& instance);
+        void detach(AbstractInstance& instance) noexcept;
+        void updateSpatialIndex(AbstractInstance& instance);
+        void removeFromSpatialIndex(AbstractInstance& instance) noexcept;
     public:
         explicit Scene(Context& context);
         virtual ~Scene() = default;
@@ -31,6 +60,11 @@ namespace Limitless {
         T& add(T* instance) noexcept {
             static_assert(std::is_base_of_v<AbstractInstance, T>, "Typename type must be base of AbstractInstance");
 
+            // instance may be a clone of another one that is already indexed
+            instance->spatial_proxy = AABBTree<AbstractInstance*>::null_node;
+            instance->bounds_changed = true;
+            attach(*instance);
+
             instances.emplace(instance->getId(), instance);
             return *instance;
         }
@@ -40,6 +74,7 @@ namespace Limitless {
             static_assert(std::is_base_of_v<AbstractInstance, T>, "Typename type must be base of AbstractInstance");
 
             T* instance = new T(&lighting, std::forward<Args>(args)...);
+            attach(*instance);
             instances.emplace(instance->getId(), instance);
             return *instance;
         }
@@ -57,6 +92,12 @@ namespace Limitless {
 
         void update(Context& context, Camera& camera);
 
+        // count of threads used by update including the calling one
+        // instance updates must not touch the context when it is greater than one
+        // instances moved during update keep their own matrices, the store gets their transforms after the jobs
+        void setUpdateThreadCount(uint32_t count);
+        [[nodiscard]] auto getUpdateThreadCount() const noexcept { return update_thread_count; }
+
         auto begin() noexcept { return instances.begin(); }
         auto begin() const noexcept { return instances.begin(); }
 
@@ -68,6 +109,37 @@ namespace Limitless {
 
         auto size() const noexcept { return instances.size(); }
 
+        // spatial queries reflect instance transforms as of the last update
+        // callback is called with AbstractInstance&
+        template<typename F>
+        void query(const Frustum& frustum, F&& callback) const {
+            tree.query(frustum, [&] (AbstractInstance* instance) { callback(*instance); });
+        }
+
+        template<typename F>
+        void query(const BoundingBox& box, F&& callback) const {
+            tree.query(box, [&] (AbstractInstance* instance) { callback(*instance); });
+        }
+
+        template<typename F>
+        void query(const glm::vec3& center, float radius, F&& callback) const {
+            tree.query(center, radius, [&] (AbstractInstance* instance) { callback(*instance); });
+        }
+
+        // callback is called with AbstractInstance& and distance to its bounds along the ray
+        template<typename F>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, F&& callback) const {
+            tree.raycast(origin, direction, max_distance, [&] (AbstractInstance* instance, float distance) { callback(*instance, distance); });
+        }
+
+        Instances query(const Frustum& frustum) const;
+        Instances query(const BoundingBox& box) const;
+        Instances query(const glm::vec3& center, float radius) const;
+
+        [[nodiscard]] const auto& getSpatialIndex() const noexcept { return tree; }
+        [[nodiscard]] const auto& getTransforms() const noexcept { return transforms; }
+        [[nodiscard]] auto getRebuiltMatrixCount() const noexcept { return rebuilt_matrix_count; }
+
         #ifdef NDEBUG
                 template<typename T>
                 T& get(uint64_t id) {
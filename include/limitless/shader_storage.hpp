@@ -5,7 +5,7 @@
 #include <limitless/util/filesystem.hpp>
 #include <unordered_map>
 #include <memory>
-#include <mutex>
+#include <shared_mutex>
 #include <map>
 
 namespace Limitless {
@@ -37,7 +37,8 @@ namespace Limitless {
         std::map<ShaderKey, std::shared_ptr<ShaderProgram>> material_shaders;
         std::map<fx::UniqueEmitterShaderKey, std::shared_ptr<ShaderProgram>> emitters;
 
-        mutable std::mutex mutex;
+        // programs are looked up every draw and added rarely by compiling threads
+        mutable std::shared_mutex mutex;
     public:
         ShaderStorage() = default;
         ~ShaderStorage() = default;
@@ -48,21 +49,41 @@ namespace Limitless {
         ShaderProgram& get(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const;
         ShaderProgram& get(const fx::UniqueEmitterShaderKey& emitter_type) const;
 
+        // returns null while program is not stored yet, e.g. when it is compiled by another thread;
+        // outdated programs are returned, they still draw until replaced
+        ShaderProgram* find(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const noexcept;
+        ShaderProgram* find(const fx::UniqueEmitterShaderKey& emitter_type) const noexcept;
+
         void add(std::string name, std::shared_ptr<ShaderProgram> program);
+
+        // materials and emitters with equal keys have equal programs,
+        // so program of the same key compiled concurrently is dropped;
+        // outdated program is replaced once new one is linked
         void add(ShaderPass material_type, ModelShader model_type, uint64_t material_index, std::shared_ptr<ShaderProgram> program);
         void add(const fx::UniqueEmitterShaderKey& emitter_type, std::shared_ptr<ShaderProgram> program);
 
         bool contains(const std::string& name) noexcept;
-        bool contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) noexcept;
+        // outdated programs are not counted, so they are compiled again
+        bool contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const noexcept;
         bool contains(const fx::UniqueEmitterShaderKey& emitter_type) noexcept;
 
         const auto& getCommonShaders() const noexcept { return shaders; }
         const auto& getMaterialShaders() const noexcept { return material_shaders; }
         const auto& getEmitterShaders() const noexcept { return emitters; }
 
+        // copies taken under lock, safe to iterate while compiling threads add programs
+        std::map<ShaderKey, std::shared_ptr<ShaderProgram>> copyMaterialShaders() const;
+        std::map<fx::UniqueEmitterShaderKey, std::shared_ptr<ShaderProgram>> copyEmitterShaders() const;
+
         void add(const ShaderStorage& other);
 
         void clearMaterialShaders();
         void clearEffectShaders();
+
+        // marks material and emitter programs built from any of files outdated, they draw until compiled again
+        void outdateDependent(const std::vector<fs::path>& files);
+
+        // marks material and emitter programs that use any of defines outdated, they draw until compiled again
+        void outdate(const std::vector<std::string>& defines);
     };
 }
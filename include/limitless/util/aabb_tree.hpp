@@ -0,0 +1,469 @@
+#pragma once
+
+#include <limitless/util/bounding_box.hpp>
+#include <limitless/util/frustum.hpp>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <array>
+
+namespace Limitless {
+    // dynamic bounding volume hierarchy
+    // leaves store fattened boxes, so small movements do not change tree structure
+    // tree is kept balanced by rotations on insertion and removal
+    template<typename T>
+    class AABBTree {
+    public:
+        static constexpr int32_t null_node = -1;
+    private:
+        static constexpr size_t MAX_STACK_SIZE = 256;
+
+        // traversal stack, spills to heap when a degenerate tree is deeper than the fixed part
+        class Stack {
+        private:
+            std::array<int32_t, MAX_STACK_SIZE> fixed;
+            std::vector<int32_t> spilled;
+            size_t size {};
+        public:
+            void push(int32_t index) {
+                if (size < fixed.size()) {
+                    fixed[size] = index;
+                } else {
+                    spilled.emplace_back(index);
+                }
+                ++size;
+            }
+
+            int32_t pop() noexcept {
+                --size;
+                if (size < fixed.size()) {
+                    return fixed[size];
+                }
+                const auto index = spilled.back();
+                spilled.pop_back();
+                return index;
+            }
+
+            [[nodiscard]] bool empty() const noexcept { return size == 0; }
+        };
+
+        struct Node {
+            glm::vec3 min {};
+            glm::vec3 max {};
+            T data {};
+
+            // next free node when node is not used
+            int32_t parent {null_node};
+            int32_t left {null_node};
+            int32_t right {null_node};
+            // leaf has 0 height, free node has -1
+            int32_t height {-1};
+
+            [[nodiscard]] bool isLeaf() const noexcept { return left == null_node; }
+        };
+
+        std::vector<Node> nodes;
+        int32_t root {null_node};
+        int32_t free_list {null_node};
+        size_t count {};
+
+        // extent added to the leaf box on each side
+        float margin;
+
+        static float area(const glm::vec3& min, const glm::vec3& max) noexcept {
+            const auto d = max - min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        static bool overlaps(const Node& node, const glm::vec3& min, const glm::vec3& max) noexcept {
+            return node.min.x <= max.x && node.max.x >= min.x &&
+                   node.min.y <= max.y && node.max.y >= min.y &&
+                   node.min.z <= max.z && node.max.z >= min.z;
+        }
+
+        static bool contains(const Node& node, const glm::vec3& min, const glm::vec3& max) noexcept {
+            return node.min.x <= min.x && node.min.y <= min.y && node.min.z <= min.z &&
+                   node.max.x >= max.x && node.max.y >= max.y && node.max.z >= max.z;
+        }
+
+        static BoundingBox toBox(const Node& node) noexcept {
+            return { (node.min + node.max) * 0.5f, node.max - node.min };
+        }
+
+        int32_t allocate() {
+            if (free_list == null_node) {
+                nodes.emplace_back();
+                return static_cast<int32_t>(nodes.size() - 1);
+            }
+
+            const auto index = free_list;
+            free_list = nodes[index].parent;
+            nodes[index] = Node{};
+            return index;
+        }
+
+        void release(int32_t index) noexcept {
+            nodes[index].parent = free_list;
+            nodes[index].height = -1;
+            nodes[index].data = T{};
+            free_list = index;
+        }
+
+        void fit(int32_t index) noexcept {
+            auto& node = nodes[index];
+            const auto& left = nodes[node.left];
+            const auto& right = nodes[node.right];
+
+            node.min = glm::min(left.min, right.min);
+            node.max = glm::max(left.max, right.max);
+            node.height = 1 + std::max(left.height, right.height);
+        }
+
+        // rotates subtree if it is imbalanced, returns new subtree root
+        int32_t balance(int32_t a) noexcept {
+            if (nodes[a].isLeaf() || nodes[a].height < 2) {
+                return a;
+            }
+
+            const auto b = nodes[a].left;
+            const auto c = nodes[a].right;
+            const auto diff = nodes[c].height - nodes[b].height;
+
+            if (diff > 1) {
+                return rotate(a, c);
+            }
+
+            if (diff < -1) {
+                return rotate(a, b);
+            }
+
+            return a;
+        }
+
+        // raises higher child up in place of a
+        int32_t rotate(int32_t a, int32_t high) noexcept {
+            const auto f = nodes[high].left;
+            const auto g = nodes[high].right;
+
+            // a becomes child of high
+            nodes[high].left = a;
+            nodes[high].parent = nodes[a].parent;
+            nodes[a].parent = high;
+
+            if (nodes[high].parent != null_node) {
+                auto& parent = nodes[nodes[high].parent];
+                (parent.left == a ? parent.left : parent.right) = high;
+            } else {
+                root = high;
+            }
+
+            // the higher grandchild stays with high, the lower one replaces high under a
+            const auto keep = nodes[f].height > nodes[g].height ? f : g;
+            const auto move = keep == f ? g : f;
+
+            nodes[high].right = keep;
+            (nodes[a].left == high ? nodes[a].left : nodes[a].right) = move;
+            nodes[move].parent = a;
+
+            fit(a);
+            fit(high);
+
+            return high;
+        }
+
+        // refits and rebalances ancestors starting from index
+        void refit(int32_t index) noexcept {
+            while (index != null_node) {
+                index = balance(index);
+                fit(index);
+                index = nodes[index].parent;
+            }
+        }
+
+        void insertLeaf(int32_t leaf) {
+            if (root == null_node) {
+                root = leaf;
+                nodes[root].parent = null_node;
+                return;
+            }
+
+            // finds best sibling using surface area heuristic
+            const auto leaf_min = nodes[leaf].min;
+            const auto leaf_max = nodes[leaf].max;
+            auto index = root;
+
+            while (!nodes[index].isLeaf()) {
+                const auto& node = nodes[index];
+                const auto node_area = area(node.min, node.max);
+                const auto combined_area = area(glm::min(node.min, leaf_min), glm::max(node.max, leaf_max));
+
+                // cost of creating new parent here and pushing leaf further down
+                const auto cost = 2.0f * combined_area;
+                const auto inheritance = 2.0f * (combined_area - node_area);
+
+                const auto child_cost = [&] (int32_t child) {
+                    const auto& c = nodes[child];
+                    const auto enlarged = area(glm::min(c.min, leaf_min), glm::max(c.max, leaf_max));
+                    return c.isLeaf() ? enlarged + inheritance : enlarged - area(c.min, c.max) + inheritance;
+                };
+
+                const auto cost_left = child_cost(node.left);
+                const auto cost_right = child_cost(node.right);
+
+                if (cost < cost_left && cost < cost_right) {
+                    break;
+                }
+
+                index = cost_left < cost_right ? node.left : node.right;
+            }
+
+            const auto sibling = index;
+            const auto old_parent = nodes[sibling].parent;
+            const auto new_parent = allocate();
+
+            nodes[new_parent].parent = old_parent;
+            nodes[new_parent].left = sibling;
+            nodes[new_parent].right = leaf;
+            nodes[sibling].parent = new_parent;
+            nodes[leaf].parent = new_parent;
+
+            if (old_parent != null_node) {
+                auto& parent = nodes[old_parent];
+                (parent.left == sibling ? parent.left : parent.right) = new_parent;
+            } else {
+                root = new_parent;
+            }
+
+            refit(new_parent);
+        }
+
+        void removeLeaf(int32_t leaf) noexcept {
+            if (leaf == root) {
+                root = null_node;
+                return;
+            }
+
+            const auto parent = nodes[leaf].parent;
+            const auto grand_parent = nodes[parent].parent;
+            const auto sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+            if (grand_parent != null_node) {
+                auto& gp = nodes[grand_parent];
+                (gp.left == parent ? gp.left : gp.right) = sibling;
+                nodes[sibling].parent = grand_parent;
+                release(parent);
+                refit(grand_parent);
+            } else {
+                root = sibling;
+                nodes[sibling].parent = null_node;
+                release(parent);
+            }
+        }
+
+        template<typename Test, typename F>
+        void traverse(Test&& test, F&& callback) const {
+            if (root == null_node) {
+                return;
+            }
+
+            Stack stack;
+            stack.push(root);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.pop()];
+
+                if (!test(node)) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.data);
+                } else {
+                    stack.push(node.left);
+                    stack.push(node.right);
+                }
+            }
+        }
+
+        template<typename F>
+        void collect(int32_t index, F& callback) const {
+            Stack stack;
+            stack.push(index);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.pop()];
+
+                if (node.isLeaf()) {
+                    callback(node.data);
+                } else {
+                    stack.push(node.left);
+                    stack.push(node.right);
+                }
+            }
+        }
+    public:
+        explicit AABBTree(float _margin = 0.1f) noexcept
+            : margin {_margin} {
+        }
+
+        // returns proxy that identifies the leaf
+        int32_t insert(const BoundingBox& box, T data) {
+            const auto leaf = allocate();
+            auto& node = nodes[leaf];
+
+            node.min = box.center - box.size * 0.5f - glm::vec3{margin};
+            node.max = box.center + box.size * 0.5f + glm::vec3{margin};
+            node.data = std::move(data);
+            node.height = 0;
+
+            insertLeaf(leaf);
+            ++count;
+
+            return leaf;
+        }
+
+        void remove(int32_t proxy) noexcept {
+            assert(proxy >= 0 && static_cast<size_t>(proxy) < nodes.size() && nodes[proxy].isLeaf());
+
+            removeLeaf(proxy);
+            release(proxy);
+            --count;
+        }
+
+        // returns true if leaf was reinserted; nothing changes while box stays inside the fattened one
+        bool update(int32_t proxy, const BoundingBox& box) {
+            assert(proxy >= 0 && static_cast<size_t>(proxy) < nodes.size() && nodes[proxy].isLeaf());
+
+            const auto min = box.center - box.size * 0.5f;
+            const auto max = box.center + box.size * 0.5f;
+
+            if (contains(nodes[proxy], min, max)) {
+                return false;
+            }
+
+            removeLeaf(proxy);
+
+            nodes[proxy].min = min - glm::vec3{margin};
+            nodes[proxy].max = max + glm::vec3{margin};
+
+            insertLeaf(proxy);
+            return true;
+        }
+
+        void clear() noexcept {
+            nodes.clear();
+            root = null_node;
+            free_list = null_node;
+            count = 0;
+        }
+
+        [[nodiscard]] const T& getData(int32_t proxy) const noexcept { return nodes[proxy].data; }
+        [[nodiscard]] BoundingBox getFatBox(int32_t proxy) const noexcept { return toBox(nodes[proxy]); }
+        [[nodiscard]] auto getHeight() const noexcept { return root == null_node ? 0 : nodes[root].height; }
+        [[nodiscard]] auto size() const noexcept { return count; }
+        [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+        // calls callback(const T&) for every leaf that overlaps box
+        template<typename F>
+        void query(const BoundingBox& box, F&& callback) const {
+            const auto min = box.center - box.size * 0.5f;
+            const auto max = box.center + box.size * 0.5f;
+
+            traverse([&] (const Node& node) { return overlaps(node, min, max); }, callback);
+        }
+
+        // calls callback(const T&) for every leaf that overlaps sphere
+        template<typename F>
+        void query(const glm::vec3& center, float radius, F&& callback) const {
+            traverse([&] (const Node& node) {
+                const auto closest = glm::clamp(center, node.min, node.max);
+                const auto d = closest - center;
+                return glm::dot(d, d) <= radius * radius;
+            }, callback);
+        }
+
+        // calls callback(const T&) for every leaf that intersects frustum; fully visible subtrees are not tested further
+        template<typename F>
+        void query(const Frustum& frustum, F&& callback) const {
+            if (root == null_node) {
+                return;
+            }
+
+            Stack stack;
+            stack.push(root);
+
+            while (!stack.empty()) {
+                const auto index = stack.pop();
+                const auto& node = nodes[index];
+                const auto box = toBox(node);
+
+                if (!frustum.intersects(box)) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.data);
+                } else if (frustum.contains(box)) {
+                    collect(index, callback);
+                } else {
+                    stack.push(node.left);
+                    stack.push(node.right);
+                }
+            }
+        }
+
+        // calls callback(const T&, float distance) for every leaf hit by ray within max_distance
+        template<typename F>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float max_distance, F&& callback) const {
+            const auto inv = 1.0f / direction;
+
+            const auto hit = [&] (const Node& node, float& distance) {
+                auto t_enter = 0.0f;
+                auto t_exit = max_distance;
+
+                for (int axis = 0; axis < 3; ++axis) {
+                    // ray parallel to slab never crosses it, 0 * inf would give NaN
+                    if (direction[axis] == 0.0f) {
+                        if (origin[axis] < node.min[axis] || origin[axis] > node.max[axis]) {
+                            return false;
+                        }
+                        continue;
+                    }
+
+                    const auto t0 = (node.min[axis] - origin[axis]) * inv[axis];
+                    const auto t1 = (node.max[axis] - origin[axis]) * inv[axis];
+                    t_enter = std::max(t_enter, std::min(t0, t1));
+                    t_exit = std::min(t_exit, std::max(t0, t1));
+                }
+
+                distance = t_enter;
+                return t_enter <= t_exit;
+            };
+
+            if (root == null_node) {
+                return;
+            }
+
+            Stack stack;
+            stack.push(root);
+
+            while (!stack.empty()) {
+                const auto& node = nodes[stack.pop()];
+
+                float distance {};
+                if (!hit(node, distance)) {
+                    continue;
+                }
+
+                if (node.isLeaf()) {
+                    callback(node.data, distance);
+                } else {
+                    stack.push(node.left);
+                    stack.push(node.right);
+                }
+            }
+        }
+    };
+}
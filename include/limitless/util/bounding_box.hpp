@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/functions.hpp>
 #include <vector>
+#include <limits>
 
 namespace Limitless {
     struct BoundingBox {
@@ -13,7 +14,7 @@ namespace Limitless {
     template<typename V>
     inline BoundingBox calculateBoundingBox(const std::vector<V>& vertices) {
         auto min = glm::vec3{ std::numeric_limits<float>::max() };
-        auto max = glm::vec3{ std::numeric_limits<float>::min() };
+        auto max = glm::vec3{ std::numeric_limits<float>::lowest() };
 
         for (const auto& v : vertices) {
             const glm::vec3 position = v.getPosition();
@@ -36,4 +37,19 @@ namespace Limitless {
 
         return { center, size };
     }
+
+    // world-space box enclosing transformed box (Arvo's method)
+    inline BoundingBox transformBoundingBox(const BoundingBox& box, const glm::mat4& matrix) noexcept {
+        const auto center = glm::vec3{matrix * glm::vec4{box.center, 1.0f}};
+        const auto extent = box.size * 0.5f;
+
+        glm::vec3 world_extent;
+        for (int i = 0; i < 3; ++i) {
+            world_extent[i] = glm::abs(matrix[0][i]) * extent.x +
+                              glm::abs(matrix[1][i]) * extent.y +
+                              glm::abs(matrix[2][i]) * extent.z;
+        }
+
+        return { center, world_extent * 2.0f };
+    }
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <limitless/util/bounding_box.hpp>
+#include <glm/glm.hpp>
+#include <array>
+
+namespace Limitless {
+    // view volume represented by six inward-facing planes (xyz - normal, w - distance)
+    class Frustum {
+    private:
+        std::array<glm::vec4, 6> planes;
+    public:
+        // extracts planes from combined projection * view matrix
+        explicit Frustum(const glm::mat4& matrix) noexcept {
+            const auto row = [&] (int i) { return glm::vec4{matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]}; };
+
+            planes[0] = row(3) + row(0); // left
+            planes[1] = row(3) - row(0); // right
+            planes[2] = row(3) + row(1); // bottom
+            planes[3] = row(3) - row(1); // top
+            planes[4] = row(3) + row(2); // near
+            planes[5] = row(3) - row(2); // far
+
+            for (auto& plane : planes) {
+                plane /= glm::length(glm::vec3{plane});
+            }
+        }
+
+        [[nodiscard]] const auto& getPlanes() const noexcept { return planes; }
+
+        [[nodiscard]] bool contains(const glm::vec3& point) const noexcept {
+            for (const auto& plane : planes) {
+                if (glm::dot(glm::vec3{plane}, point) + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool intersects(const glm::vec3& center, float radius) const noexcept {
+            for (const auto& plane : planes) {
+                if (glm::dot(glm::vec3{plane}, center) + plane.w < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // conservative test: box is rejected only if it lies entirely behind one of the planes
+        [[nodiscard]] bool intersects(const BoundingBox& box) const noexcept {
+            const auto extent = box.size * 0.5f;
+
+            for (const auto& plane : planes) {
+                const auto normal = glm::vec3{plane};
+                const auto radius = glm::dot(extent, glm::abs(normal));
+
+                if (glm::dot(normal, box.center) + plane.w < -radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // box lies entirely in front of every plane
+        [[nodiscard]] bool contains(const BoundingBox& box) const noexcept {
+            const auto extent = box.size * 0.5f;
+
+            for (const auto& plane : planes) {
+                const auto normal = glm::vec3{plane};
+                const auto radius = glm::dot(extent, glm::abs(normal));
+
+                if (glm::dot(normal, box.center) + plane.w < radius) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+}
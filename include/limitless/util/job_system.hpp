@@ -0,0 +1,226 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
+#include <utility>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <new>
+
+namespace Limitless {
+    // move-only callable that keeps small functors inline, larger ones are allocated on the heap
+    class Task final {
+    private:
+        static constexpr size_t capacity = 48;
+
+        alignas(std::max_align_t) unsigned char storage[capacity];
+        void (*call)(void*) {};
+        // moves functor from src to dst, destroys src if dst is null
+        void (*manage)(void* dst, void* src) noexcept {};
+
+        template<typename F>
+        static constexpr bool is_inline = sizeof(F) <= capacity && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+
+        void reset() noexcept {
+            if (manage) {
+                manage(nullptr, storage);
+                manage = nullptr;
+                call = nullptr;
+            }
+        }
+    public:
+        Task() noexcept = default;
+
+        template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f) { // NOLINT(google-explicit-constructor)
+            using Functor = std::decay_t<F>;
+
+            if constexpr (is_inline<Functor>) {
+                new (storage) Functor(std::forward<F>(f));
+                call = [] (void* data) { (*static_cast<Functor*>(data))(); };
+                manage = [] (void* dst, void* src) noexcept {
+                    auto* functor = static_cast<Functor*>(src);
+                    if (dst) {
+                        new (dst) Functor(std::move(*functor));
+                    }
+                    functor->~Functor();
+                };
+            } else {
+                new (storage) Functor*(new Functor(std::forward<F>(f)));
+                call = [] (void* data) { (**static_cast<Functor**>(data))(); };
+                manage = [] (void* dst, void* src) noexcept {
+                    auto* functor = *static_cast<Functor**>(src);
+                    if (dst) {
+                        new (dst) Functor*(functor);
+                    } else {
+                        delete functor;
+                    }
+                };
+            }
+        }
+
+        ~Task() { reset(); }
+
+        Task(Task&& other) noexcept {
+            *this = std::move(other);
+        }
+
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.manage) {
+                    other.manage(storage, other.storage);
+                    call = other.call;
+                    manage = other.manage;
+                    other.call = nullptr;
+                    other.manage = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        explicit operator bool() const noexcept { return call != nullptr; }
+
+        void operator()() { call(storage); }
+    };
+
+    // tracks completion of a group of jobs; jobs spawned from a job with the same counter extend the group
+    class JobCounter final {
+    private:
+        std::atomic<uint32_t> pending {};
+
+        // first exception thrown by a job of the group, rethrown by wait
+        std::atomic<bool> failed {};
+        std::exception_ptr error;
+
+        friend class JobSystem;
+    public:
+        JobCounter() = default;
+        ~JobCounter() = default;
+
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] bool isDone() const noexcept { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    // work-stealing scheduler
+    // every thread owns a deque: it pushes and pops jobs at the back, idle threads steal from the front of others
+    // the thread that created the system is a worker too and executes jobs while it waits for a counter
+    class JobSystem final {
+    private:
+        struct Job {
+            Task task;
+            JobCounter* counter {};
+        };
+
+        // ring buffer of jobs, grows when full
+        struct alignas(64) Queue {
+            std::mutex mutex;
+            std::vector<Job> jobs;
+            size_t head {};
+            size_t count {};
+
+            void push(Job&& job);
+            bool popBack(Job& job);
+            bool popFront(Job& job);
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> threads;
+
+        // queued and not yet taken jobs, lets idle workers sleep
+        std::atomic<size_t> queued {};
+        std::atomic<uint32_t> sleeping {};
+        std::atomic<bool> stop {};
+        std::mutex sleep_mutex;
+        std::condition_variable sleep_condition;
+
+        // queue for threads that do not belong to the system
+        std::atomic<uint32_t> next_foreign {};
+
+        // first exception thrown by a job run without counter, rethrown on the creating thread
+        std::atomic<bool> detached_failed {};
+        std::mutex error_mutex;
+        std::exception_ptr detached_error;
+        std::thread::id owner;
+
+        uint32_t currentIndex() const noexcept;
+        bool take(uint32_t index, Job& job);
+        void execute(Job& job) noexcept;
+        void work(uint32_t index);
+    public:
+        // thread_count includes the creating thread
+        explicit JobSystem(uint32_t thread_count = std::thread::hardware_concurrency());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        [[nodiscard]] auto getThreadCount() const noexcept { return static_cast<uint32_t>(queues.size()); }
+
+        // counter is incremented now and decremented when the task is done
+        void run(Task task, JobCounter* counter = nullptr);
+
+        // executes queued jobs until all jobs of the counter are done; rethrows first exception of the group
+        // on the creating thread, then rethrows exception of a job run without counter
+        void wait(JobCounter& counter);
+
+        // rethrows first exception thrown by a job run without counter since the last call
+        void rethrowDetached();
+
+        // calls f(i) for every i in [begin, end) in chunks of at least grain indices and waits for them
+        template<typename F>
+        void parallel_for(size_t begin, size_t end, size_t grain, F&& f) {
+            if (begin >= end) {
+                return;
+            }
+
+            grain = std::max<size_t>(grain, 1);
+            const auto count = end - begin;
+
+            // a few chunks per thread balance uneven work without flooding the queues
+            const auto chunk = std::max(grain, count / (getThreadCount() * 4) + 1);
+
+            JobCounter counter;
+            for (auto first = begin + chunk; first < end; first += chunk) {
+                const auto last = std::min(first + chunk, end);
+                run([&f, first, last] {
+                    for (auto i = first; i < last; ++i) {
+                        f(i);
+                    }
+                }, &counter);
+            }
+
+            // first chunk on this thread, its exception still has to wait for the others
+            std::exception_ptr error;
+            try {
+                for (auto i = begin; i < std::min(begin + chunk, end); ++i) {
+                    f(i);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            try {
+                wait(counter);
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace Limitless {
+    // composes count matrices translation * rotation * scale from separate component streams
+    // rotation is given as (x, y, z, w) quaternion components
+    void composeTransforms(const float* px, const float* py, const float* pz,
+                           const float* qx, const float* qy, const float* qz, const float* qw,
+                           const float* sx, const float* sy, const float* sz,
+                           glm::mat4* out, size_t count) noexcept;
+
+    // contiguous structure-of-arrays storage for instance transforms
+    // components are kept densely packed, handles stay valid across removals of other entries
+    class TransformStore {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle null_handle = ~Handle {0};
+    private:
+        static constexpr size_t batch = 4;
+
+        // translation, rotation and scale components
+        std::vector<float> px, py, pz;
+        std::vector<float> qx, qy, qz, qw;
+        std::vector<float> sx, sy, sz;
+
+        std::vector<glm::mat4> matrices;
+
+        // per entry; set when it has to be recomposed
+        // batches with any dirty entry are recomposed whole
+        std::vector<uint8_t> dirty;
+
+        // handle -> dense index and back
+        std::vector<uint32_t> sparse;
+        std::vector<Handle> handles;
+        std::vector<Handle> free_handles;
+
+        // set while update jobs read entries, nothing may change them then
+        bool locked {};
+
+        void markDirty(uint32_t index) noexcept { dirty[index] = 1; }
+        void resize(size_t size);
+    public:
+        TransformStore() = default;
+        ~TransformStore() = default;
+
+        TransformStore(const TransformStore&) = delete;
+        TransformStore& operator=(const TransformStore&) = delete;
+
+        Handle allocate(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+        void release(Handle handle) noexcept;
+        void clear() noexcept;
+
+        void setPosition(Handle handle, const glm::vec3& position) noexcept;
+        void setRotation(Handle handle, const glm::quat& rotation) noexcept;
+        void setScale(Handle handle, const glm::vec3& scale) noexcept;
+
+        [[nodiscard]] glm::vec3 getPosition(Handle handle) const noexcept;
+        [[nodiscard]] glm::quat getRotation(Handle handle) const noexcept;
+        [[nodiscard]] glm::vec3 getScale(Handle handle) const noexcept;
+
+        // matrix as of the last update
+        [[nodiscard]] const glm::mat4& getMatrix(Handle handle) const noexcept { return matrices[sparse[handle]]; }
+        [[nodiscard]] bool isDirty(Handle handle) const noexcept { return dirty[sparse[handle]]; }
+
+        [[nodiscard]] const auto& getMatrices() const noexcept { return matrices; }
+        [[nodiscard]] bool isLocked() const noexcept { return locked; }
+
+        // owners defer their changes while the store is locked
+        void lock() noexcept { locked = true; }
+        void unlock() noexcept { locked = false; }
+        [[nodiscard]] auto size() const noexcept { return handles.size(); }
+
+        // recomposes matrices of changed entries, returns count of changed entries
+        // clean entries sharing a batch with changed ones are recomposed too but not counted
+        size_t update() noexcept;
+    };
+
+    // entry of a store owned by somebody else
+    // copies are detached, so that cloned instances never write into the entry of the original
+    struct TransformRef {
+        TransformStore* store {};
+        TransformStore::Handle handle {TransformStore::null_handle};
+
+        // changed while the store was locked, written once it is unlocked
+        bool pending {};
+
+        TransformRef() = default;
+        TransformRef(const TransformRef&) noexcept {}
+        TransformRef& operator=(const TransformRef&) noexcept { return *this; }
+
+        explicit operator bool() const noexcept { return store != nullptr; }
+    };
+}
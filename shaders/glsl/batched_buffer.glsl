@@ -0,0 +1,12 @@
+// index of draw command, fed per instance starting at its baseInstance
+layout(location = 6) in int draw_id;
+
+struct BatchedDraw {
+    mat4 model;
+    // block of draw material in range bound for the run
+    uint material_index;
+};
+
+layout(std430) buffer batch_buffer {
+    BatchedDraw draws[];
+};
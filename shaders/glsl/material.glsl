@@ -1,4 +1,9 @@
+// batched draws of different materials index their blocks in array
+#if defined(BATCHED_MODEL)
+struct MaterialBlock {
+#else
 layout(std140) uniform material_buffer {
+#endif
     #if defined(MATERIAL_COLOR)
         vec4 material_color;
     #endif
@@ -63,11 +68,24 @@ layout(std140) uniform material_buffer {
 
     Limitless::CustomMaterialScalarUniforms
 
+#if defined(BATCHED_MODEL)
+    // pads block to stride of material storage
+    Limitless::MaterialBatchPadding
+};
+
+layout(std140) uniform material_buffer {
+    MaterialBlock materials[MATERIAL_BATCH_SIZE];
+};
+
+// members are read by name, index of draw material is passed from vertex shader
+Limitless::MaterialBatchMembers
+#else
     // for tricky cases
     // when there are no samplers
     // and bindless texture is present
     bool empty;
 };
+#endif
 
 #if !defined(BINDLESS_TEXTURE)
     #if defined(MATERIAL_DIFFUSE)
@@ -0,0 +1,115 @@
+Limitless::GLSL_VERSION
+Limitless::Extensions
+#extension GL_ARB_compute_shader : require
+
+layout(local_size_x = 64) in;
+
+struct Command {
+    uint count;
+    uint instance_count;
+    uint first_index;
+    int base_vertex;
+    uint base_instance;
+};
+
+struct CullDraw {
+    vec3 center;
+    uint run;
+    vec3 extent;
+    uint first;
+};
+
+layout(std430) readonly buffer cull_draws {
+    CullDraw draws[];
+};
+
+layout(std430) readonly buffer cull_input {
+    Command input_commands[];
+};
+
+layout(std430) writeonly buffer cull_output {
+    Command output_commands[];
+};
+
+layout(std430) buffer cull_counts {
+    uint visible_counts[];
+};
+
+uniform mat4 view_projection;
+uniform uint draw_count;
+
+// hierarchical depth of previous frame
+uniform int occlusion;
+uniform sampler2D depth_pyramid;
+uniform int pyramid_levels;
+uniform mat4 pyramid_view_projection;
+
+bool isInsideFrustum(vec3 center, vec3 extent) {
+    mat4 m = transpose(view_projection);
+    vec4 planes[6] = vec4[6](m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2]);
+
+    for (int i = 0; i < 6; ++i) {
+        vec3 normal = planes[i].xyz;
+        float radius = dot(extent, abs(normal));
+
+        if (dot(normal, center) + planes[i].w < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool isOccluded(vec3 center, vec3 extent) {
+    vec3 uv_min = vec3(1.0);
+    vec3 uv_max = vec3(0.0);
+
+    for (int i = 0; i < 8; ++i) {
+        vec3 corner = center + extent * vec3((i & 1) != 0 ? 1.0 : -1.0, (i & 2) != 0 ? 1.0 : -1.0, (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = pyramid_view_projection * vec4(corner, 1.0);
+
+        // crosses near plane of previous frame, so its depth is unknown
+        if (clip.w <= 0.0) {
+            return false;
+        }
+
+        vec3 ndc = clamp(clip.xyz / clip.w * 0.5 + 0.5, 0.0, 1.0);
+        uv_min = min(uv_min, ndc);
+        uv_max = max(uv_max, ndc);
+    }
+
+    // level where box covers at most 2x2 texels
+    vec2 size = (uv_max.xy - uv_min.xy) * vec2(textureSize(depth_pyramid, 0));
+    int level = clamp(int(ceil(log2(max(max(size.x, size.y), 1.0)))), 0, pyramid_levels - 1);
+
+    ivec2 level_size = textureSize(depth_pyramid, level);
+    ivec2 from = clamp(ivec2(uv_min.xy * vec2(level_size)), ivec2(0), level_size - 1);
+    ivec2 to = clamp(ivec2(uv_max.xy * vec2(level_size)), ivec2(0), level_size - 1);
+
+    float depth = max(max(texelFetch(depth_pyramid, from, level).r, texelFetch(depth_pyramid, ivec2(to.x, from.y), level).r),
+                      max(texelFetch(depth_pyramid, ivec2(from.x, to.y), level).r, texelFetch(depth_pyramid, to, level).r));
+
+    return uv_min.z > depth;
+}
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+
+    if (index >= draw_count) {
+        return;
+    }
+
+    CullDraw draw = draws[index];
+
+    if (!isInsideFrustum(draw.center, draw.extent)) {
+        return;
+    }
+
+    if (occlusion != 0 && isOccluded(draw.center, draw.extent)) {
+        return;
+    }
+
+    // survivors are compacted to the beginning of their run
+    uint slot = atomicAdd(visible_counts[draw.run], 1u);
+    output_commands[draw.first + slot] = input_commands[index];
+}
@@ -0,0 +1,35 @@
+Limitless::GLSL_VERSION
+Limitless::Extensions
+#extension GL_ARB_compute_shader : require
+#extension GL_ARB_shader_image_load_store : require
+
+layout(local_size_x = 8, local_size_y = 8) in;
+
+uniform sampler2D source;
+uniform int source_level;
+
+layout(r32f) uniform writeonly image2D destination;
+
+// every texel keeps the farthest depth of source texels it covers
+void main() {
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+
+    // every level halves the previous one, starting from half of depth buffer
+    ivec2 source_size = textureSize(source, source_level);
+    ivec2 destination_size = max(source_size / 2, ivec2(1));
+
+    if (any(greaterThanEqual(texel, destination_size))) {
+        return;
+    }
+    ivec2 from = texel * source_size / destination_size;
+    ivec2 to = min(((texel + 1) * source_size + destination_size - 1) / destination_size, source_size);
+
+    float depth = 0.0;
+    for (int y = from.y; y < to.y; ++y) {
+        for (int x = from.x; x < to.x; ++x) {
+            depth = max(depth, texelFetch(source, ivec2(x, y), source_level).r);
+        }
+    }
+
+    imageStore(destination, texel, vec4(depth));
+}
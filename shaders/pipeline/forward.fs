@@ -20,6 +20,10 @@ in vertex_data {
     vec2 uv;
 } in_data;
 
+#if defined(BATCHED_MODEL)
+    flat in uint batched_material_index;
+#endif
+
 #include "../glsl/scene.glsl"
 #include "../glsl/material.glsl"
 
@@ -39,6 +39,9 @@ out vertex_data {
 
 #if defined(INSTANCED_MODEL)
     #include "../glsl/instanced_buffer.glsl"
+#elif defined(BATCHED_MODEL)
+    #include "../glsl/batched_buffer.glsl"
+    flat out uint batched_material_index;
 #else
     uniform mat4 model;
 #endif
@@ -48,6 +51,9 @@ void main() {
 
     #if defined(INSTANCED_MODEL) || defined(SKELETAL_INSTANCED_MODEL)
         mat4 model_matrix = models[gl_InstanceID];
+    #elif defined(BATCHED_MODEL)
+        mat4 model_matrix = draws[draw_id].model;
+        batched_material_index = draws[draw_id].material_index;
     #else
         mat4 model_matrix = model;
     #endif
@@ -4,23 +4,30 @@
 #include <limitless/ms/material_compiler.hpp>
 #include <limitless/fx/effect_compiler.hpp>
 #include <limitless/skybox/skybox.hpp>
+#include <limitless/pipeline/batch_renderer.hpp>
+#include <limitless/core/geometry_pool.hpp>
+#include <limitless/core/shader_source_cache.hpp>
+#include <limitless/core/shader_compiler.hpp>
 
 #include <limitless/models/sphere.hpp>
 #include <limitless/models/quad.hpp>
 #include <limitless/models/cube.hpp>
 #include <limitless/models/plane.hpp>
 #include <utility>
+#include <iostream>
 
 using namespace Limitless;
 
 Assets::Assets(const fs::path& _base_dir) noexcept
 	: base_dir {_base_dir}
-	, shader_dir {_base_dir / "../shaders"} {
+	, shader_dir {_base_dir / "../shaders"}
+	, geometry {std::make_shared<GeometryPool>(getVertexFormat(VertexNormalTangent{}))} {
 }
 
 Assets::Assets(fs::path _base_dir, fs::path _shader_dir) noexcept
     : base_dir {std::move(_base_dir)}
-    , shader_dir {std::move(_shader_dir)} {
+    , shader_dir {std::move(_shader_dir)}
+    , geometry {std::make_shared<GeometryPool>(getVertexFormat(VertexNormalTangent{}))} {
 }
 
 void Assets::load(Context& context) {
@@ -83,6 +90,36 @@ void Assets::recompileShaders(Context& ctx, const RenderSettings& settings) {
     compileShaders(ctx, settings);
 }
 
+void Assets::reloadShaders(Context& ctx, const RenderSettings& settings) {
+    const auto changed = ShaderSourceCache::update();
+    if (changed.empty()) {
+        return;
+    }
+
+    // programs keep drawing until recompiled ones replace them
+    shaders.outdateDependent(changed);
+
+    // broken edit does not stop the application, programs of failed variants stay outdated
+    // and are compiled again by the next reload
+    try {
+        compileShaders(ctx, settings);
+    } catch (const shader_file_not_found& e) {
+        std::cerr << "Failed to reload shaders, file not found: " << e.what() << std::endl;
+    } catch (const shader_include_not_found& e) {
+        std::cerr << "Failed to reload shaders: " << e.what() << std::endl;
+    } catch (const shader_compilation_error& e) {
+        std::cerr << "Failed to reload shaders: " << e.what() << std::endl;
+    } catch (const shader_linking_error& e) {
+        std::cerr << "Failed to reload shaders: " << e.what() << std::endl;
+    }
+}
+
+void Assets::updateShaders(Context& ctx, const RenderSettings& previous, const RenderSettings& settings) {
+    shaders.outdate(ms::MaterialCompiler::getChangedDefines(previous, settings));
+
+    compileShaders(ctx, settings);
+}
+
 void Assets::compileMaterial(Context& ctx, const RenderSettings& settings, const std::shared_ptr<ms::Material>& material) {
     ms::MaterialCompiler compiler {ctx, *this, settings};
 
@@ -98,6 +135,13 @@ void Assets::compileMaterial(Context& ctx, const RenderSettings& settings, const
             }
         }
     }
+
+    // static models are also drawn in batches, tessellated ones are not
+    if (settings.batching && BatchRenderer::isSupported() && material->getModelShaders().count(ModelShader::Model) && !material->contains(ms::Property::TessellationFactor)) {
+        if (!shaders.contains(settings.renderer, ModelShader::Batched, material->getShaderIndex())) {
+            compiler.compile(*material, settings.renderer, ModelShader::Batched);
+        }
+    }
 }
 
 PassShaders Assets::getRequiredPassShaders(const RenderSettings& settings) {
@@ -42,7 +42,7 @@ BufferBuilder& BufferBuilder::setDataSize(size_t _size) {
 }
 
 std::unique_ptr<Buffer> BufferBuilder::build() {
-    if (ContextInitializer::isExtensionSupported("GL_ARB_direct_state_access")) {
+    if (ContextInitializer::isDirectStateAccessSupported()) {
         // building DSA buffer
         if (std::holds_alternative<Buffer::Usage>(usage) && std::holds_alternative<Buffer::MutableAccess>(access)) {
             // building mutable buffer
@@ -77,6 +77,10 @@ std::unique_ptr<Buffer> BufferBuilder::build() {
     }
 }
 
+std::unique_ptr<TripleBuffer> BufferBuilder::buildTriple() {
+    return std::make_unique<TripleBuffer>(target, size, data);
+}
+
 // builds indexed buffer for specified context
 std::shared_ptr<Buffer> BufferBuilder::build(std::string_view name, ContextState& ctx) {
     std::shared_ptr<Buffer> buffer = build();
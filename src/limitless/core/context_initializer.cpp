@@ -65,6 +65,22 @@ void ContextInitializer::getExtensions() noexcept {
         const auto name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
         extensions.emplace_back(name);
     }
+
+    GLint major = 0, minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+    direct_state_access = major > 4 || (major == 4 && minor >= 5) || isExtensionSupported("GL_ARB_direct_state_access");
+    vertex_attrib_binding = major > 4 || (major == 4 && minor >= 3) || isExtensionSupported("GL_ARB_vertex_attrib_binding");
+
+    // lets driver use as many compiler threads as it has
+    if (isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallel_shader_compile = true;
+    } else if (isExtensionSupported("GL_ARB_parallel_shader_compile")) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        parallel_shader_compile = true;
+    }
 }
 
 bool ContextInitializer::isExtensionSupported(std::string_view name) noexcept {
@@ -75,6 +91,12 @@ void ContextInitializer::getLimits() noexcept {
     glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &limits.uniform_buffer_max_count);
     glGetIntegerv(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, &limits.shader_storage_max_count);
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &limits.max_texture_units);
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &limits.uniform_buffer_alignment);
+    glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &limits.uniform_block_max_size);
+
+    if (isExtensionSupported("GL_ARB_shader_storage_buffer_object")) {
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &limits.shader_storage_alignment);
+    }
 
     if (isExtensionSupported("GL_EXT_texture_filter_anisotropic")) {
         glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &limits.anisotropic_max);
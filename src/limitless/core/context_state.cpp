@@ -1,35 +1,38 @@
 #include <limitless/core/context_state.hpp>
 #include <limitless/core/context_initializer.hpp>
 #include <limitless/core/context.hpp>
+#include <limitless/ms/material_storage.hpp>
+#include <algorithm>
 
 using namespace Limitless;
 
-bool Limitless::operator<(const BindingPoint& a, const BindingPoint& b) noexcept
-{
-    return (a.target == b.target) ? a.point < b.point : a.target < b.target;
-}
-
 void ContextState::init() noexcept {
-    for (GLint i = 0; i < ContextInitializer::limits.max_texture_units; ++i) {
-        texture_bound.emplace(i, 0);
-    }
+    texture_bound.assign(ContextInitializer::limits.max_texture_units, 0);
+    texture_binder.resize(ContextInitializer::limits.max_texture_units);
+
+    buffer_point[getIndex(Buffer::Type::Uniform)].assign(ContextInitializer::limits.uniform_buffer_max_count, 0);
+    buffer_point[getIndex(Buffer::Type::ShaderStorage)].assign(ContextInitializer::limits.shader_storage_max_count, 0);
 }
 
 void ContextState::registerState(GLFWwindow* window) noexcept {
     std::unique_lock lock{mutex};
 
     state_map.emplace(window, this);
+    ++generation;
 }
 
 void ContextState::unregisterState(GLFWwindow* window) noexcept {
     std::unique_lock lock{mutex};
 
     state_map.erase(window);
+    ++generation;
 }
 
 void ContextState::swapStateMap(Context& lhs, Context& rhs) noexcept {
     std::unique_lock lock{mutex};
 
+    ++generation;
+
     // we do not register nullptr window at context default construct, so have to check
     // try to understand that is going on here
     // love implicit casts ;)
@@ -49,6 +52,64 @@ void ContextState::swapStateMap(Context& lhs, Context& rhs) noexcept {
     }
 }
 
+RingBuffer& ContextState::getRingBuffer() {
+    if (!ring_buffer) {
+        ring_buffer = std::make_unique<RingBuffer>();
+    }
+
+    return *ring_buffer;
+}
+
+std::shared_ptr<ms::MaterialStorage> ContextState::getMaterialStorage(size_t block_size) {
+    auto& storage = material_storages[block_size];
+    if (auto shared = storage.lock(); shared) {
+        return shared;
+    }
+
+    auto shared = std::make_shared<ms::MaterialStorage>(block_size);
+    storage = shared;
+    return shared;
+}
+
+const std::shared_ptr<Fence>& ContextState::getFrameFence() {
+    if (!frame_fence) {
+        frame_fence = std::make_shared<Fence>();
+    }
+
+    return frame_fence;
+}
+
+void ContextState::fenceFrame() noexcept {
+    // nothing has used fence of this frame
+    if (!frame_fence) {
+        return;
+    }
+
+    frame_fence->place();
+    frame_fence.reset();
+}
+
+void ContextState::beginFirstUse(bool warmed) noexcept {
+    ++shader_stats.first_uses;
+    if (!warmed) {
+        ++shader_stats.cold_uses;
+    }
+
+    first_use_start = std::chrono::steady_clock::now();
+}
+
+void ContextState::endFirstUse() noexcept {
+    if (first_use_start == std::chrono::steady_clock::time_point{}) {
+        return;
+    }
+
+    const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - first_use_start);
+    shader_stats.first_use_time += time;
+    shader_stats.max_first_use = std::max(shader_stats.max_first_use, time);
+
+    first_use_start = {};
+}
+
 void ContextState::clearColor(const glm::vec4& color) noexcept {
     if (clear_color != color) {
         clear_color = color;
@@ -83,16 +144,16 @@ void ContextState::setLineWidth(float width) noexcept {
 }
 
 void ContextState::enable(Capabilities func) noexcept {
-    if (!capability_map[func]) {
+    if (auto& enabled = capability_map[getIndex(func)]; !enabled) {
         glEnable(static_cast<GLenum>(func));
-        capability_map[func] = true;
+        enabled = true;
     }
 }
 
 void ContextState::disable(Capabilities func) noexcept {
-    if (capability_map[func]) {
+    if (auto& enabled = capability_map[getIndex(func)]; enabled) {
         glDisable(static_cast<GLenum>(func));
-        capability_map[func] = false;
+        enabled = false;
     }
 }
 
@@ -131,12 +192,22 @@ void ContextState::setFrontFace(FrontFace mode) noexcept {
     }
 }
 
+// called on every bind, so map is looked up only when thread changes window or contexts are registered
 ContextState* ContextState::getState(GLFWwindow* window) noexcept {
-    try {
-        return state_map.at(window);
-    } catch (...) {
-        return nullptr;
+    const auto current = generation.load(std::memory_order_acquire);
+
+    if (cached_state.window == window && cached_state.generation == current) {
+        return cached_state.state;
     }
+
+    std::unique_lock lock{mutex};
+
+    const auto found = state_map.find(window);
+    auto* state = found != state_map.end() ? found->second : nullptr;
+
+    cached_state = {window, state, current};
+
+    return state;
 }
 
 void ContextState::setPolygonMode(CullFace face, PolygonMode mode) noexcept {
@@ -148,7 +219,7 @@ void ContextState::setPolygonMode(CullFace face, PolygonMode mode) noexcept {
 }
 
 bool ContextState::hasState(GLFWwindow* window) noexcept {
-    return window ? state_map.find(window) != state_map.end() : false;
+    return window ? getState(window) != nullptr : false;
 }
 
 void ContextState::setScissorTest(glm::uvec2 origin, glm::uvec2 size) noexcept {
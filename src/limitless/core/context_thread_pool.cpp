@@ -27,18 +27,39 @@ ContextThreadPool::ContextThreadPool(Context& shared, uint32_t pool_size)
                 }
 
                 task();
-
-                // explicitly share state between contexts
-                {
-                    // make sure that all commands in a queue
-                    glFlush();
-
-                    // make sure that all commands are finished
-                    glFinish();
-                }
             }
         };
 
         threads.emplace_back(std::move(lambda));
     }
 }
+
+ContextThreadPool::~ContextThreadPool() {
+    // workers place fences until they are stopped
+    joinAll();
+
+    for (const auto fence : fences) {
+        glDeleteSync(fence);
+    }
+}
+
+void ContextThreadPool::placeFence() {
+    const auto fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // fence has to be flushed to be waited in another context
+    glFlush();
+
+    std::unique_lock lock(fence_mutex);
+    fences.emplace_back(fence);
+}
+
+void ContextThreadPool::synchronize() {
+    std::unique_lock lock(fence_mutex);
+
+    for (const auto fence : fences) {
+        glWaitSync(fence, 0, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+    }
+
+    fences.clear();
+}
@@ -0,0 +1,243 @@
+#include <limitless/core/geometry_pool.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    void copyBufferSubData(const Buffer& src, const Buffer& dst, GLintptr src_offset, GLintptr dst_offset, GLsizeiptr size) noexcept {
+        if (ContextInitializer::isDirectStateAccessSupported()) {
+            glCopyNamedBufferSubData(src.getId(), dst.getId(), src_offset, dst_offset, size);
+        } else {
+            // copy targets are not cached by context state
+            glBindBuffer(GL_COPY_READ_BUFFER, src.getId());
+            glBindBuffer(GL_COPY_WRITE_BUFFER, dst.getId());
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, src_offset, dst_offset, size);
+        }
+    }
+}
+
+// first fit, the rest of range stays free
+bool GeometryPool::Arena::allocate(GLuint count, GLuint& offset) {
+    for (auto it = free.begin(); it != free.end(); ++it) {
+        if (it->second < count) {
+            continue;
+        }
+
+        offset = it->first;
+
+        const auto rest = it->second - count;
+        free.erase(it);
+        if (rest != 0) {
+            free.emplace(offset + count, rest);
+        }
+
+        used += count;
+        return true;
+    }
+
+    return false;
+}
+
+// merges range with adjacent free ranges
+void GeometryPool::Arena::release(const Range& range) {
+    auto offset = range.offset;
+    auto count = range.count;
+
+    auto next = free.lower_bound(offset);
+    if (next != free.end() && offset + count == next->first) {
+        count += next->second;
+        next = free.erase(next);
+    }
+
+    if (next != free.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            count += prev->second;
+            free.erase(prev);
+        }
+    }
+
+    free.emplace(offset, count);
+    used -= range.count;
+}
+
+GeometryPool::GeometryPool(const VertexFormat& _format, GLuint vertex_capacity, GLuint index_capacity)
+    : format {_format}
+    , vertices {nullptr, {}, static_cast<size_t>(_format.stride), vertex_capacity, 0}
+    , indices {nullptr, {}, sizeof(GLuint), index_capacity, 0} {
+}
+
+void GeometryPool::create(Arena& arena, GLuint capacity) {
+    // index buffer is edited through array target too,
+    // because binding element target changes element buffer of bound vertex array
+    BufferBuilder builder;
+    arena.buffer = builder.setTarget(Buffer::Type::Array)
+                          .setUsage(Buffer::Storage::Dynamic)
+                          .setAccess(Buffer::ImmutableAccess::None)
+                          .setData(nullptr)
+                          .setDataSize(capacity * arena.element_size)
+                          .build();
+
+    arena.capacity = capacity;
+    arena.used = 0;
+    arena.free.clear();
+    arena.free.emplace(0, capacity);
+}
+
+void GeometryPool::compact(Arena& arena, Range Allocation::* range, GLuint capacity) {
+    const auto old = std::move(arena.buffer);
+    create(arena, capacity);
+
+    // copies are done by GPU, so geometry is not read back
+    GLuint head = 0;
+    for (auto& allocation : allocations) {
+        auto& [offset, count] = allocation.*range;
+        if (count == 0) {
+            continue;
+        }
+
+        copyBufferSubData(*old, *arena.buffer,
+                          static_cast<GLintptr>(offset * arena.element_size),
+                          static_cast<GLintptr>(head * arena.element_size),
+                          static_cast<GLsizeiptr>(count * arena.element_size));
+        offset = head;
+        head += count;
+    }
+
+    arena.used = head;
+    arena.free.clear();
+    if (head < capacity) {
+        arena.free.emplace(head, capacity - head);
+    }
+
+    ++compaction_count;
+}
+
+void GeometryPool::reserve(Arena& arena, Range Allocation::* range, GLuint count) {
+    if (!arena.buffer) {
+        create(arena, std::max(arena.capacity, count));
+        return;
+    }
+
+    const auto fits = std::any_of(arena.free.begin(), arena.free.end(), [&] (const auto& free) { return free.second >= count; });
+    if (fits) {
+        return;
+    }
+
+    // fragmented space is enough after compaction, otherwise storage grows
+    const auto capacity = arena.capacity - arena.used >= count ? arena.capacity : std::max(arena.capacity * 2, arena.used + count);
+    compact(arena, range, capacity);
+}
+
+GeometryPool::Handle GeometryPool::allocate(const void* vertex_data, GLuint vertex_count, const GLuint* index_data, GLuint index_count) {
+    Allocation allocation {};
+
+    if (vertex_count != 0) {
+        reserve(vertices, &Allocation::vertices, vertex_count);
+        vertices.allocate(vertex_count, allocation.vertices.offset);
+        allocation.vertices.count = vertex_count;
+
+        vertices.buffer->bufferSubData(static_cast<GLintptr>(allocation.vertices.offset * vertices.element_size), vertex_count * vertices.element_size, vertex_data);
+    }
+
+    if (index_count != 0) {
+        reserve(indices, &Allocation::indices, index_count);
+        indices.allocate(index_count, allocation.indices.offset);
+        allocation.indices.count = index_count;
+
+        indices.buffer->bufferSubData(static_cast<GLintptr>(allocation.indices.offset * indices.element_size), index_count * indices.element_size, index_data);
+    }
+
+    if (!free_handles.empty()) {
+        const auto handle = free_handles.back();
+        free_handles.pop_back();
+        allocations[handle] = allocation;
+        return handle;
+    }
+
+    allocations.emplace_back(allocation);
+    return static_cast<Handle>(allocations.size() - 1);
+}
+
+void GeometryPool::free(Handle handle) {
+    auto& allocation = allocations.at(handle);
+
+    if (allocation.vertices.count != 0) {
+        vertices.release(allocation.vertices);
+    }
+
+    if (allocation.indices.count != 0) {
+        indices.release(allocation.indices);
+    }
+
+    allocation = {};
+    free_handles.emplace_back(handle);
+}
+
+void GeometryPool::defragment() {
+    // compacted arena has its only free range at the end
+    const auto fragmented = [] (const Arena& arena) {
+        return arena.buffer && !arena.free.empty() && (arena.free.size() > 1 || arena.free.begin()->first != arena.used);
+    };
+
+    if (fragmented(vertices)) {
+        compact(vertices, &Allocation::vertices, vertices.capacity);
+    }
+
+    if (fragmented(indices)) {
+        compact(indices, &Allocation::indices, indices.capacity);
+    }
+}
+
+void GeometryPool::attach(VertexArray& vertex_array) const noexcept {
+    if (vertices.buffer) {
+        vertex_array.setVertexBuffer(0, *vertices.buffer);
+    }
+
+    if (indices.buffer) {
+        vertex_array.setElementBuffer(*indices.buffer);
+    }
+}
+
+GeometryPool::Stats GeometryPool::getStats() const noexcept {
+    return {
+        vertices.buffer ? vertices.capacity * vertices.element_size : 0,
+        vertices.used * vertices.element_size,
+        indices.buffer ? indices.capacity * indices.element_size : 0,
+        indices.used * indices.element_size,
+        static_cast<uint32_t>(allocations.size() - free_handles.size()),
+        static_cast<uint32_t>(vertices.free.size() + indices.free.size()),
+        compaction_count
+    };
+}
+
+PooledGeometry::PooledGeometry(std::shared_ptr<GeometryPool> _pool, const void* vertex_data, GLuint vertex_count, const GLuint* index_data, GLuint index_count)
+    : pool {std::move(_pool)}
+    , handle {pool->allocate(vertex_data, vertex_count, index_data, index_count)} {
+}
+
+PooledGeometry::~PooledGeometry() {
+    if (pool) {
+        pool->free(handle);
+    }
+}
+
+PooledGeometry::PooledGeometry(PooledGeometry&& rhs) noexcept : PooledGeometry() {
+    swap(*this, rhs);
+}
+
+PooledGeometry& PooledGeometry::operator=(PooledGeometry&& rhs) noexcept {
+    swap(*this, rhs);
+    return *this;
+}
+
+void Limitless::swap(PooledGeometry& lhs, PooledGeometry& rhs) noexcept {
+    using std::swap;
+
+    swap(lhs.pool, rhs.pool);
+    swap(lhs.handle, rhs.handle);
+}
@@ -53,6 +53,10 @@ void NamedBuffer::bufferSubData(GLintptr offset, size_t sub_size, const void* da
     glNamedBufferSubData(id, offset, sub_size, data);
 }
 
+void NamedBuffer::clearSubData(GLenum internalformat, GLintptr offset, GLsizeiptr sub_size, GLenum format, GLenum type, const void* data) const noexcept {
+    glClearNamedBufferSubData(id, internalformat, offset, sub_size, format, type, data);
+}
+
 void NamedBuffer::clearData(GLenum internalformat, GLenum format, GLenum type, const void* data) const noexcept {
     glClearNamedBufferData(id, internalformat, format, type, data);
 }
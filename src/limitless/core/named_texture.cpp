@@ -12,12 +12,7 @@ NamedTexture::NamedTexture(GLenum _target) noexcept : target{_target} {
 NamedTexture::~NamedTexture() {
     if (id != 0) {
         if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-            auto& target_map = state->texture_bound;
-
-            std::for_each(target_map.begin(), target_map.end(), [&] (auto& state) {
-                auto& [s_unit, s_id] = state;
-                if (s_id == id) s_id = 0;
-            });
+            std::replace(state->texture_bound.begin(), state->texture_bound.end(), id, 0u);
 
             glDeleteTextures(1, &id);
         }
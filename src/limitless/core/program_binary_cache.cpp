@@ -0,0 +1,159 @@
+#include <limitless/core/program_binary_cache.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/shader.hpp>
+#include <functional>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint32_t binary_magic = 0x4c505242; // LPRB
+    constexpr auto binary_extension = ".bin";
+
+    // FNV-1a, keys have to be the same between runs
+    constexpr uint64_t hash_seed = 0xcbf29ce484222325ULL;
+
+    uint64_t hash(uint64_t value, std::string_view data) noexcept {
+        for (const auto c : data) {
+            value ^= static_cast<uint8_t>(c);
+            value *= 0x100000001b3ULL;
+        }
+        return value;
+    }
+
+    std::string_view getString(GLenum name) noexcept {
+        const auto* str = reinterpret_cast<const char*>(glGetString(name));
+        return str ? str : "";
+    }
+
+    struct BinaryHeader {
+        uint32_t magic;
+        GLenum format;
+        uint64_t key;
+        uint64_t size;
+    };
+}
+
+ProgramBinaryCache::ProgramBinaryCache(fs::path _directory)
+    : directory {std::move(_directory)}
+    , driver_hash {hash_seed} {
+    for (const auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        driver_hash = hash(driver_hash, getString(name));
+    }
+
+    fs::create_directories(directory);
+}
+
+bool ProgramBinaryCache::isSupported() noexcept {
+    if (!ContextInitializer::isExtensionSupported("GL_ARB_get_program_binary")) {
+        return false;
+    }
+
+    GLint format_count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    return format_count > 0;
+}
+
+fs::path ProgramBinaryCache::getPath(uint64_t key) const {
+    std::stringstream name;
+    name << std::hex << key << binary_extension;
+    return directory / name.str();
+}
+
+uint64_t ProgramBinaryCache::getKey(const std::vector<Shader>& shaders) const noexcept {
+    auto key = driver_hash;
+
+    for (const auto& shader : shaders) {
+        const auto type = std::to_string(static_cast<GLenum>(shader.getType()));
+        key = hash(key, type);
+        key = hash(key, shader.getSource());
+    }
+
+    return key;
+}
+
+GLuint ProgramBinaryCache::load(uint64_t key) const {
+    const auto path = getPath(key);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    BinaryHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    std::vector<char> binary;
+    if (file && header.magic == binary_magic && header.key == key) {
+        binary.resize(header.size);
+        file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+    }
+
+    const auto complete = file && !binary.empty();
+    file.close();
+
+    if (!complete) {
+        fs::remove(path);
+        return 0;
+    }
+
+    const auto program_id = glCreateProgram();
+    glProgramBinary(program_id, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    // binary of another driver version or corrupted file
+    GLint link_status = GL_FALSE;
+    glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
+    if (!link_status) {
+        glDeleteProgram(program_id);
+        fs::remove(path);
+        return 0;
+    }
+
+    return program_id;
+}
+
+void ProgramBinaryCache::store(uint64_t key, GLuint program_id) const {
+    GLint size = 0;
+    glGetProgramiv(program_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0) {
+        return;
+    }
+
+    std::vector<char> binary(size);
+    BinaryHeader header {binary_magic, 0, key, 0};
+    glGetProgramBinary(program_id, size, &size, &header.format, binary.data());
+    header.size = static_cast<uint64_t>(size);
+
+    // programs can be compiled by several threads, so file is written aside and renamed
+    const auto path = getPath(key);
+    auto temporary = path;
+    temporary += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+    bool written;
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(binary.data(), size);
+        written = static_cast<bool>(file);
+    }
+
+    std::error_code error;
+    if (written) {
+        fs::rename(temporary, path, error);
+    }
+
+    if (!written || error) {
+        fs::remove(temporary, error);
+    }
+}
+
+void ProgramBinaryCache::clear() const {
+    for (const auto& entry : fs::directory_iterator(directory)) {
+        if (entry.path().extension() == binary_extension) {
+            fs::remove(entry.path());
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include <limitless/core/ring_buffer.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/context_state.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    constexpr size_t min_alignment = sizeof(float) * 4;
+}
+
+RingBuffer::RingBuffer(size_t _segment_size)
+    : fences(segment_count)
+    , segment_size {alignSegment(_segment_size)} {
+    create();
+}
+
+void RingBuffer::create() {
+    BufferBuilder builder;
+    builder.setTarget(Buffer::Type::Array)
+           .setData(nullptr)
+           .setDataSize(segment_size * segment_count);
+
+    if (ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage")) {
+        buffer = builder.setUsage(Buffer::Storage::DynamicCoherentWrite)
+                        .setAccess(Buffer::ImmutableAccess::WriteCoherent)
+                        .build();
+
+        persistent_ptr = static_cast<uint8_t*>(buffer->mapBufferRange(0, static_cast<GLsizeiptr>(segment_size * segment_count)));
+    } else {
+        // fences are the only guard of ranges, so driver does not have to sync them
+        buffer = builder.setUsage(Buffer::Usage::StreamDraw)
+                        .setAccess(Buffer::MutableAccess::WriteUnsync)
+                        .build();
+
+        persistent_ptr = nullptr;
+    }
+}
+
+void RingBuffer::grow(size_t required) {
+    // previous ranges of this frame are still bound to old buffer
+    retired.emplace_back(std::move(buffer));
+
+    // new storage has not been used by GPU yet
+    for (auto& fence : fences) {
+        fence.reset();
+    }
+
+    segment_size = alignSegment(std::max(segment_size * 2, required));
+    head = 0;
+
+    create();
+}
+
+size_t RingBuffer::getAlignment(Buffer::Type target) noexcept {
+    switch (target) {
+        case Buffer::Type::Uniform:
+            return std::max<size_t>(ContextInitializer::limits.uniform_buffer_alignment, min_alignment);
+        case Buffer::Type::ShaderStorage:
+            return std::max<size_t>(ContextInitializer::limits.shader_storage_alignment, min_alignment);
+        default:
+            return min_alignment;
+    }
+}
+
+// segments start at offsets suitable for any target
+size_t RingBuffer::alignSegment(size_t size) noexcept {
+    const auto alignment = std::max(getAlignment(Buffer::Type::Uniform), getAlignment(Buffer::Type::ShaderStorage));
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+void RingBuffer::beginFrame() {
+    if (auto& fence = fences[segment]; fence) {
+        fence->wait();
+        fence.reset();
+    }
+
+    head = 0;
+    retired.clear();
+}
+
+void RingBuffer::endFrame() {
+    // end of frame places single fence shared with buffers drawn during it
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        fences[segment] = state->getFrameFence();
+        state->fenceFrame();
+    }
+
+    segment = (segment + 1) % segment_count;
+    ++frame;
+}
+
+RingBuffer::Allocation RingBuffer::upload(Buffer::Type target, const void* data, size_t size) {
+    const auto alignment = getAlignment(target);
+
+    // empty ranges cannot be bound
+    const auto reserved = std::max(size, min_alignment);
+
+    auto offset = (head + alignment - 1) / alignment * alignment;
+    if (offset + reserved > segment_size) {
+        grow(reserved);
+        offset = 0;
+    }
+
+    const auto absolute = segment * segment_size + offset;
+
+    if (size != 0) {
+        if (persistent_ptr) {
+            std::memcpy(persistent_ptr + absolute, data, size);
+        } else {
+            std::memcpy(buffer->mapBufferRange(static_cast<GLintptr>(absolute), static_cast<GLsizeiptr>(size)), data, size);
+            buffer->unmapBuffer();
+        }
+    }
+
+    head = offset + reserved;
+
+    return {buffer.get(), static_cast<GLintptr>(absolute), static_cast<GLsizeiptr>(reserved), frame};
+}
+
+void RingBuffer::bind(const Allocation& allocation, Buffer::Type target, GLuint index) noexcept {
+    allocation.buffer->bindBufferRangeAs(target, index, allocation.offset, allocation.size);
+}
@@ -1,7 +1,8 @@
 #include <limitless/core/shader.hpp>
 #include <limitless/core/context_initializer.hpp>
+#include <limitless/core/shader_source_cache.hpp>
 #include <string>
-#include <sstream>
+#include <cctype>
 
 using namespace Limitless;
 
@@ -27,19 +28,22 @@ namespace {
 Shader::Shader(fs::path _path, Type _type, const ShaderAction& action)
     : path{std::move(_path)}
     , type{_type} {
-    source = getSource(path);
+    // files are read once for all variants
+    auto [text, files] = ShaderSourceCache::get(path);
+    source = std::move(text);
+    dependencies = std::move(files);
 
     replaceVersion();
     replaceExtensions();
-    replaceIncludes(path.parent_path());
 
     if (action) {
         action(*this);
     }
 
-    // includes can appear in other includes that were added by ShaderActions
-    // so replace one more time
-    replaceIncludes(path.parent_path());
+    expandKeys();
+
+    // includes can appear in code that was added by ShaderActions
+    ShaderSourceCache::resolveIncludes(source, path.parent_path(), dependencies, path);
 
     id = glCreateShader(static_cast<GLenum>(type));
 }
@@ -81,16 +85,53 @@ void Shader::replaceVersion() noexcept {
 }
 
 void Shader::replaceKey(const std::string& key, const std::string& value) noexcept {
-    size_t found = 0;
+    keys.emplace(key, value);
+
+    // keys replaced after construction are expanded right away
+    if (id != 0) {
+        expandKeys();
+    }
+}
+
+void Shader::expandKeys() noexcept {
+    static constexpr std::string_view prefix = "Limitless::";
+
+    if (keys.empty()) {
+        return;
+    }
+
+    std::string expanded;
+    expanded.reserve(source.size());
+
+    size_t position = 0;
     for (;;) {
-        found = source.find(key, found);
+        const auto found = source.find(prefix, position);
 
         if (found == std::string::npos) {
             break;
         }
 
-        source.replace(found, key.length(), value);
+        auto end = found + prefix.length();
+        while (end < source.size() && (std::isalnum(static_cast<unsigned char>(source[end])) || source[end] == '_')) {
+            ++end;
+        }
+
+        expanded.append(source, position, found - position);
+
+        // unknown keys are left for later replacement
+        if (auto value = keys.find(source.substr(found, end - found)); value != keys.end()) {
+            expanded.append(value->second);
+        } else {
+            expanded.append(source, found, end - found);
+        }
+
+        position = end;
     }
+
+    expanded.append(source, position, std::string::npos);
+
+    source = std::move(expanded);
+    keys.clear();
 }
 
 void Shader::replaceExtensions() noexcept {
@@ -117,59 +158,16 @@ void Shader::replaceExtensions() noexcept {
     replaceKey(extensions_key, extensions);
 }
 
-std::string Shader::getSource(const fs::path& filepath) {
-    try {
-        std::ifstream file(filepath);
-        std::string file_source;
-
-        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-        if (file.good()) {
-            std::stringstream stream;
-            stream << file.rdbuf();
-
-            file_source = stream.str();
-        }
-
-        return file_source;
-    } catch (...) {
-        throw shader_file_not_found(filepath.string());
-    }
-}
-
-void Shader::replaceIncludes(const fs::path& base_dir) {
-    static constexpr std::string_view include = "#include";
-
-    size_t found = 0;
-    for (;;) {
-        found = source.find(include, found);
-
-        if (found == std::string::npos) {
-            break;
-        }
-
-        size_t beg = found + include.length() + 2;
-        size_t end = source.find('"', beg);
-        size_t name_length = end - beg;
-
-        std::string file_name = source.substr(beg, name_length);
-
-        try {
-            const auto& include_src = getSource(base_dir / file_name);
-            source.replace(found, include.length() + 3 + name_length, include_src);
-        } catch (const shader_file_not_found& not_found) {
-            throw shader_include_not_found("Failed to resolve include for " + path.string() + ": " + not_found.what());
-        }
-    }
-}
-
 void Shader::compile() const {
     const auto* src = source.data();
 
     glShaderSource(id, 1, &src, nullptr);
     glCompileShader(id);
 
-    checkStatus();
+    // parallel compilation is not waited here, errors are reported when program is linked
+    if (!ContextInitializer::isParallelShaderCompileSupported()) {
+        checkStatus();
+    }
 }
 
 void Limitless::swap(Shader &lhs, Shader &rhs) noexcept {
@@ -179,6 +177,8 @@ void Limitless::swap(Shader &lhs, Shader &rhs) noexcept {
     swap(lhs.path, rhs.path);
     swap(lhs.type, rhs.type);
     swap(lhs.id, rhs.id);
+    swap(lhs.dependencies, rhs.dependencies);
+    swap(lhs.keys, rhs.keys);
 }
 
 Shader::Shader(Shader&& rhs) noexcept : Shader() {
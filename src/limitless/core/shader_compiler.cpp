@@ -1,8 +1,11 @@
 #include <limitless/core/shader_compiler.hpp>
 
 #include <fstream>
+#include <cctype>
 #include <limitless/core/context.hpp>
 #include <limitless/core/shader_program.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <limitless/core/context_initializer.hpp>
 
 using namespace Limitless;
 
@@ -20,6 +23,27 @@ ShaderCompiler::ShaderCompiler(Context& _context)
     : context {_context} {
 }
 
+bool ShaderCompiler::refersTo(std::string_view source, std::string_view name) noexcept {
+    constexpr std::string_view directive = "#define";
+    const auto identifier = [] (char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; };
+
+    for (auto pos = source.find(name); pos != std::string_view::npos; pos = source.find(name, pos + 1)) {
+        const auto end = pos + name.size();
+        if ((pos != 0 && identifier(source[pos - 1])) || (end < source.size() && identifier(source[end]))) {
+            continue;
+        }
+
+        const auto last = pos == 0 ? std::string_view::npos : source.find_last_not_of(" \t", pos - 1);
+        if (last != std::string_view::npos && last + 1 >= directive.size() && source.substr(last + 1 - directive.size(), directive.size()) == directive) {
+            continue;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
 void ShaderCompiler::checkStatus(const GLuint program_id) {
     GLint link_status;
     glGetProgramiv(program_id, GL_LINK_STATUS, &link_status);
@@ -31,6 +55,26 @@ void ShaderCompiler::checkStatus(const GLuint program_id) {
         std::string log;
         log.resize(log_size);
         glGetProgramInfoLog(program_id, log_size, &log_size, log.data());
+        log.resize(log_size);
+
+        // compile status of shaders is not checked when they are compiled in parallel
+        GLint shader_count = 0;
+        glGetProgramiv(program_id, GL_ATTACHED_SHADERS, &shader_count);
+
+        std::vector<GLuint> shader_ids(shader_count);
+        glGetAttachedShaders(program_id, shader_count, nullptr, shader_ids.data());
+
+        for (const auto shader_id : shader_ids) {
+            GLint shader_log_size = 0;
+            glGetShaderiv(shader_id, GL_INFO_LOG_LENGTH, &shader_log_size);
+
+            std::string shader_log;
+            shader_log.resize(shader_log_size);
+            glGetShaderInfoLog(shader_id, shader_log_size, &shader_log_size, shader_log.data());
+            shader_log.resize(shader_log_size);
+
+            log.append(shader_log);
+        }
 
         glDeleteProgram(program_id);
 
@@ -54,6 +98,42 @@ std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
         throw shader_linking_error("No shaders to link. ShaderCompiler is empty.");
     }
 
+    // files program is built from, it is rebuilt when they change
+    std::vector<fs::path> dependencies;
+    for (const auto& shader : shaders) {
+        for (const auto& file : shader.getDependencies()) {
+            if (std::find(dependencies.begin(), dependencies.end(), file) == dependencies.end()) {
+                dependencies.emplace_back(file);
+            }
+        }
+    }
+
+    std::vector<std::string> defines;
+    for (const auto& define : watched_defines) {
+        if (std::any_of(shaders.begin(), shaders.end(), [&] (const auto& shader) { return refersTo(shader.getSource(), define); })) {
+            defines.emplace_back(define);
+        }
+    }
+
+    auto program = link();
+    program->dependencies = std::move(dependencies);
+    program->defines = std::move(defines);
+
+    return program;
+}
+
+std::shared_ptr<ShaderProgram> ShaderCompiler::link() {
+    // keeps cache alive if it is replaced meanwhile
+    const auto cache = binary_cache;
+    const auto key = cache ? cache->getKey(shaders) : 0;
+
+    if (cache) {
+        if (const auto program_id = cache->load(key); program_id != 0) {
+            shaders.clear();
+            return std::shared_ptr<ShaderProgram>(new ShaderProgram(context, program_id));
+        }
+    }
+
     const GLuint program_id = glCreateProgram();
 
     for (const auto& shader : shaders) {
@@ -61,11 +141,27 @@ std::shared_ptr<ShaderProgram> ShaderCompiler::compile() {
         glAttachShader(program_id, shader.getId());
     }
 
+    if (cache) {
+        glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     glLinkProgram(program_id);
 
+    shaders.clear();
+
+    if (background_link && ContextInitializer::isParallelShaderCompileSupported()) {
+        // commands have to reach driver to be linked while other context polls the program
+        glFlush();
+
+        auto pending = std::unique_ptr<ShaderProgram::PendingLink>(new ShaderProgram::PendingLink{cache, key});
+        return std::shared_ptr<ShaderProgram>(new ShaderProgram(program_id, std::move(pending)));
+    }
+
     checkStatus(program_id);
 
-    shaders.clear();
+    if (cache) {
+        cache->store(key, program_id);
+    }
 
     return std::shared_ptr<ShaderProgram>(new ShaderProgram(context, program_id));
 }
@@ -5,6 +5,9 @@
 #include <limitless/core/bindless_texture.hpp>
 #include <limitless/core/texture_binder.hpp>
 #include <limitless/core/context.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <iostream>
 
 using namespace Limitless;
 
@@ -13,30 +16,128 @@ ShaderProgram::ShaderProgram(ContextState& ctx, GLuint id) : id{id} {
     getIndexedBufferBounds(ctx);
 }
 
-GLint ShaderProgram::getUniformLocation(const Uniform& uniform) const noexcept {
-    const auto location = locations.find(uniform.getName());
-    if (location == locations.end()) {
-        return -1;
+ShaderProgram::ShaderProgram(GLuint id, std::unique_ptr<PendingLink> pending) noexcept
+    : id {id}
+    , pending {std::move(pending)} {
+}
+
+void ShaderProgram::finishLink() {
+    auto* state = ContextState::getState(glfwGetCurrentContext());
+    if (!state) {
+        throw shader_program_error("No current context to finish program link");
     }
 
-    return location->second;
+    const auto linking = std::move(pending);
+
+    // failed program is deleted by check
+    const auto program_id = std::exchange(id, 0);
+    ShaderCompiler::checkStatus(program_id);
+    id = program_id;
+
+    if (linking->binary_cache) {
+        linking->binary_cache->store(linking->binary_key, id);
+    }
+
+    getUniformLocations();
+    getIndexedBufferBounds(*state);
+}
+
+void ShaderProgram::replace(std::shared_ptr<ShaderProgram> program) noexcept {
+    std::atomic_store(&replacement, std::move(program));
+    outdated = false;
+}
+
+bool ShaderProgram::isReady() {
+    if (auto linked = std::atomic_load(&replacement); linked && linked->isReady()) {
+        // replacement stored meanwhile by another compile is kept for later frames
+        if (std::atomic_compare_exchange_strong(&replacement, &linked, std::shared_ptr<ShaderProgram>{})) {
+            // outdated program is deleted with replacement object
+            adopt(*linked);
+        }
+    }
+
+    if (failed) {
+        return false;
+    }
+
+    if (!pending) {
+        return true;
+    }
+
+    GLint completed = GL_FALSE;
+    glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &completed);
+    if (!completed) {
+        return false;
+    }
+
+    // draws keep using fallback instead of throwing mid-frame
+    try {
+        finishLink();
+    } catch (const shader_linking_error& e) {
+        failed = true;
+        std::cerr << "Shader program failed to link: " << e.what() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+ShaderProgram::UniformSlot* ShaderProgram::findSlot(UniformId uniform_id) noexcept {
+    const auto index = uniform_id.getIndex();
+    if (index >= slot_indices.size() || slot_indices[index] == 0) {
+        return nullptr;
+    }
+
+    return &uniforms[slot_indices[index] - 1];
+}
+
+const ShaderProgram::UniformSlot* ShaderProgram::findSlot(UniformId uniform_id) const noexcept {
+    return const_cast<ShaderProgram&>(*this).findSlot(uniform_id);
+}
+
+GLint ShaderProgram::getUniformLocation(const Uniform& uniform) const noexcept {
+    const auto* slot = findSlot(uniform.getId());
+    return slot ? slot->location : -1;
 }
 
 void ShaderProgram::use() {
+    if (failed) {
+        throw shader_program_error("Shader program failed to link");
+    }
+
+    if (pending) {
+        finishLink();
+    }
+
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        if (state->shader_id != id) {
-            state->shader_id = id;
-            glUseProgram(id);
+        state->endFirstUse();
+
+        if (!used) {
+            used = true;
+            state->beginFirstUse(warmed);
         }
 
-        bindIndexedBuffers(*state);
-        bindTextures();
+        apply(*state);
+    }
+}
 
-        for (auto& [name, uniform] : uniforms) {
-            if (auto& changed = uniform->getChanged(); changed) {
-                uniform->set(*this);
-                changed = false;
-            }
+void ShaderProgram::apply(ContextState& ctx) {
+    if (ctx.shader_id != id) {
+        ctx.shader_id = id;
+        glUseProgram(id);
+    }
+
+    bindIndexedBuffers(ctx);
+    bindTextures();
+
+    for (auto& [name, location, uniform] : uniforms) {
+        if (!uniform) {
+            continue;
+        }
+
+        if (auto& changed = uniform->getChanged(); changed) {
+            uniform->set(*this);
+            changed = false;
         }
     }
 }
@@ -50,13 +151,27 @@ ShaderProgram&  ShaderProgram::operator=(ShaderProgram&& rhs) noexcept {
     return *this;
 }
 
+void ShaderProgram::adopt(ShaderProgram& linked) noexcept {
+    using std::swap;
+
+    swap(id, linked.id);
+    swap(uniforms, linked.uniforms);
+    swap(slot_indices, linked.slot_indices);
+    swap(indexed_binds, linked.indexed_binds);
+    swap(pending, linked.pending);
+    swap(failed, linked.failed);
+    swap(dependencies, linked.dependencies);
+    swap(defines, linked.defines);
+    swap(used, linked.used);
+    swap(warmed, linked.warmed);
+}
+
 void Limitless::swap(ShaderProgram& lhs, ShaderProgram& rhs) noexcept {
     using std::swap;
 
-    swap(lhs.id, rhs.id);
-    swap(lhs.locations, rhs.locations);
-    swap(lhs.indexed_binds, rhs.indexed_binds);
-    swap(lhs.uniforms, rhs.uniforms);
+    lhs.adopt(rhs);
+    swap(lhs.replacement, rhs.replacement);
+    lhs.outdated = rhs.outdated.exchange(lhs.outdated);
 }
 
 void ShaderProgram::getUniformLocations() noexcept {
@@ -75,7 +190,15 @@ void ShaderProgram::getUniformLocations() noexcept {
         name.resize(static_cast<uint32_t>(values[1]) - 1UL);
 
         glGetProgramResourceName(id, GL_UNIFORM, i, values[1], nullptr, name.data());
-        locations.emplace(name, values[2]);
+
+        // slots are resolved once, updates then index them by uniform id
+        const auto index = UniformId{name}.getIndex();
+        if (index >= slot_indices.size()) {
+            slot_indices.resize(index + 1, 0);
+        }
+
+        uniforms.push_back({std::move(name), values[2], nullptr});
+        slot_indices[index] = static_cast<uint32_t>(uniforms.size());
     }
 }
 
@@ -151,16 +274,21 @@ void ShaderProgram::bindIndexedBuffers(ContextState& ctx) {
     }
 }
 
-ShaderProgram& ShaderProgram::operator<<(const UniformSampler& uniform) noexcept {
-    auto find = uniforms.find(uniform.getName());
-    if (find != uniforms.end()) {
-        static_cast<UniformSampler&>(*find->second).setSampler(uniform.getSampler());
-    } else {
-        uniforms.emplace(uniform.getName(), new UniformSampler(uniform));
+ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const std::shared_ptr<Texture>& texture) {
+    if (auto* slot = findSlot(uniform_id); slot) {
+        if (slot->uniform && slot->uniform->getType() == UniformType::Sampler) {
+            static_cast<UniformSampler&>(*slot->uniform).setSampler(texture);
+        } else {
+            slot->uniform = std::make_unique<UniformSampler>(slot->name, texture);
+        }
     }
     return *this;
 }
 
+ShaderProgram& ShaderProgram::operator<<(const UniformSampler& uniform) noexcept {
+    return setUniform(uniform.getId(), uniform.getSampler());
+}
+
 ShaderProgram& ShaderProgram::operator<<(const ms::Material& material) {
     //TODO: update before draw?
     const_cast<ms::Material&>(material).update();
@@ -171,7 +299,7 @@ ShaderProgram& ShaderProgram::operator<<(const ms::Material& material) {
           return *this;
     }
 
-    material.getMaterialBuffer()->bindBase(found->bound_point);
+    material.getBlock().bind(found->bound_point);
 
     for (const auto& [type, uniform] : material.getProperties()) {
         if (uniform->getType() == UniformType::Sampler) {
@@ -189,16 +317,23 @@ ShaderProgram& ShaderProgram::operator<<(const ms::Material& material) {
 }
 
 template<typename T>
-ShaderProgram& ShaderProgram::operator<<(const UniformValue<T>& uniform) noexcept {
-    auto found = uniforms.find(uniform.getName());
-    if (found != uniforms.end()) {
-        static_cast<UniformValue<T>&>(*found->second).setValue(uniform.getValue());
-    } else {
-        uniforms.emplace(uniform.getName(), new UniformValue(uniform));
+ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const T& value) {
+    if (auto* slot = findSlot(uniform_id); slot) {
+        auto& uniform = slot->uniform;
+        if (uniform && uniform->getType() == UniformType::Value && uniform->getValueType() == UniformValue<T>::getUniformValueType()) {
+            static_cast<UniformValue<T>&>(*uniform).setValue(value);
+        } else {
+            uniform = std::make_unique<UniformValue<T>>(slot->name, value);
+        }
     }
     return *this;
 }
 
+template<typename T>
+ShaderProgram& ShaderProgram::operator<<(const UniformValue<T>& uniform) noexcept {
+    return setUniform(uniform.getId(), uniform.getValue());
+}
+
 struct TextureResidentMaker : public TextureVisitor {
     void visit(BindlessTexture& texture) noexcept override {
         texture.makeResident();
@@ -210,32 +345,21 @@ struct TextureResidentMaker : public TextureVisitor {
 void ShaderProgram::bindTextures() const noexcept {
     //TODO: bind textures dependent on runtime type
     if (!ContextInitializer::isExtensionSupported("GL_ARB_bindless_texture")) {
-        // collects textures
-        // binds them to units for current usage
+        // binds textures of program as one set to units
         // sets unit index value to samplers in shader
-        std::vector<Texture*> to_bind;
-        for (const auto& [name, uniform] : uniforms) {
-            if (uniform->getType() == UniformType::Sampler) {
-                const auto& sampler = static_cast<UniformSampler&>(*uniform);
-                to_bind.emplace_back(sampler.getSampler().get());
-            }
-        }
-
-        const auto units = TextureBinder::bind(to_bind);
-
-        uint32_t i = 0;
-        for (const auto& [name, uniform] : uniforms) {
-            if (uniform->getType() == UniformType::Sampler) {
-                auto &sampler = static_cast<UniformSampler&>(*uniform);
-                sampler.setValue(units[i++]);
+        TextureBinder::begin();
+        for (const auto& [name, location, uniform] : uniforms) {
+            if (uniform && uniform->getType() == UniformType::Sampler) {
+                auto& sampler = static_cast<UniformSampler&>(*uniform);
+                sampler.setValue(TextureBinder::bind(*sampler.getSampler()));
             }
         }
     }
 
     // checks textures to be resident in bindless case
     TextureResidentMaker resident_maker;
-    for (const auto&[name, uniform] : uniforms) {
-        if (uniform->getType() == UniformType::Sampler) {
+    for (const auto& [name, location, uniform] : uniforms) {
+        if (uniform && uniform->getType() == UniformType::Sampler) {
             auto &sampler = static_cast<UniformSampler&>(*uniform);
             sampler.getSampler()->accept(resident_maker);
         }
@@ -250,4 +374,13 @@ namespace Limitless {
     template ShaderProgram& ShaderProgram::operator<<(const UniformValue<glm::vec3>& uniform) noexcept;
     template ShaderProgram& ShaderProgram::operator<<(const UniformValue<glm::vec4>& uniform) noexcept;
     template ShaderProgram& ShaderProgram::operator<<(const UniformValue<glm::mat4>& uniform) noexcept;
+
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const int& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const float& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const unsigned int& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const glm::vec2& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const glm::vec3& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const glm::vec4& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const glm::mat3& value);
+    template ShaderProgram& ShaderProgram::setUniform(UniformId uniform_id, const glm::mat4& value);
 }
@@ -0,0 +1,123 @@
+#include <limitless/core/shader_source_cache.hpp>
+
+#include <limitless/core/shader.hpp>
+#include <algorithm>
+#include <sstream>
+
+using namespace Limitless;
+
+namespace {
+    constexpr std::string_view include = "#include";
+
+    fs::file_time_type getWriteTime(const fs::path& path) noexcept {
+        std::error_code error;
+        const auto time = fs::last_write_time(path, error);
+        return error ? fs::file_time_type::min() : time;
+    }
+}
+
+const std::string& ShaderSourceCache::read(const fs::path& path) {
+    if (auto found = files.find(path.string()); found != files.end()) {
+        return found->second.text;
+    }
+
+    try {
+        std::ifstream file(path);
+        file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+
+        return files.emplace(path.string(), File {stream.str(), getWriteTime(path)}).first->second.text;
+    } catch (...) {
+        throw shader_file_not_found(path.string());
+    }
+}
+
+void ShaderSourceCache::resolve(std::string& text, const fs::path& base_dir, std::vector<fs::path>& used, const fs::path& shader_path) {
+    size_t found = 0;
+    for (;;) {
+        found = text.find(include, found);
+
+        if (found == std::string::npos) {
+            break;
+        }
+
+        const size_t beg = found + include.length() + 2;
+        const size_t end = text.find('"', beg);
+        const size_t name_length = end - beg;
+
+        // includes are relative to shader directory, nested ones too
+        const auto include_path = (base_dir / text.substr(beg, name_length)).lexically_normal();
+
+        try {
+            // included text is scanned again for nested includes
+            text.replace(found, include.length() + 3 + name_length, read(include_path));
+        } catch (const shader_file_not_found& not_found) {
+            throw shader_include_not_found("Failed to resolve include for " + shader_path.string() + ": " + not_found.what());
+        }
+
+        if (std::find(used.begin(), used.end(), include_path) == used.end()) {
+            used.emplace_back(include_path);
+        }
+    }
+}
+
+ShaderSourceCache::Source ShaderSourceCache::get(const fs::path& path) {
+    const auto normal = path.lexically_normal();
+
+    std::unique_lock lock(mutex);
+
+    if (auto found = sources.find(normal.string()); found != sources.end()) {
+        return found->second;
+    }
+
+    Source source {read(normal), {normal}};
+    resolve(source.text, normal.parent_path(), source.files, normal);
+
+    return sources.emplace(normal.string(), std::move(source)).first->second;
+}
+
+void ShaderSourceCache::resolveIncludes(std::string& text, const fs::path& base_dir, std::vector<fs::path>& used, const fs::path& shader_path) {
+    if (text.find(include) == std::string::npos) {
+        return;
+    }
+
+    std::unique_lock lock(mutex);
+    resolve(text, base_dir.lexically_normal(), used, shader_path);
+}
+
+std::vector<fs::path> ShaderSourceCache::update() {
+    std::unique_lock lock(mutex);
+
+    std::vector<fs::path> changed;
+    for (auto it = files.begin(); it != files.end();) {
+        const auto time = getWriteTime(it->first);
+
+        // deleted or renamed file keeps cached text, so its sources stay valid until it appears again
+        if (time != it->second.time && time != fs::file_time_type::min()) {
+            changed.emplace_back(it->first);
+            it = files.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (auto it = sources.begin(); it != sources.end();) {
+        const auto& used = it->second.files;
+        const auto affected = std::any_of(changed.begin(), changed.end(), [&] (const auto& file) {
+            return std::find(used.begin(), used.end(), file) != used.end();
+        });
+
+        it = affected ? sources.erase(it) : std::next(it);
+    }
+
+    return changed;
+}
+
+void ShaderSourceCache::clear() noexcept {
+    std::unique_lock lock(mutex);
+
+    files.clear();
+    sources.clear();
+}
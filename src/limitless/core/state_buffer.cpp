@@ -26,18 +26,13 @@ StateBuffer::StateBuffer(Type target, size_t size, const void* data, Storage usa
 StateBuffer::~StateBuffer() {
     if (id != 0) {
         if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-            auto& target_map = state->buffer_target;
-            auto& point_map = state->buffer_point;
+            std::replace(state->buffer_target.begin(), state->buffer_target.end(), id, 0u);
 
-            std::for_each(target_map.begin(), target_map.end(), [&] (auto& state_target) {
-                auto& [s_target, s_id] = state_target;
-                if (s_id == id) s_id = 0;
-            });
+            for (auto& points : state->buffer_point) {
+                std::replace(points.begin(), points.end(), id, 0u);
+            }
 
-            std::for_each(point_map.begin(), point_map.end(), [&] (auto& state_point) {
-                auto& [s_point, s_id] = state_point;
-                if (s_id == id) s_id = 0;
-            });
+            state->shared_vertex_arrays.detach(id);
 
             glDeleteBuffers(1, &id);
         }
@@ -67,42 +62,38 @@ StateBuffer& StateBuffer::operator=(StateBuffer&& rhs) noexcept {
 
 void StateBuffer::bind() const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        if (state->buffer_target[target] != id) {
+        if (auto& bound = state->getBufferTarget(target); bound != id) {
             glBindBuffer(static_cast<GLenum>(target), id);
-            state->buffer_target[target] = id;
+            bound = id;
         }
     }
 }
 
 void StateBuffer::bindAs(Type _target) const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        if (state->buffer_target[_target] != id) {
+        if (auto& bound = state->getBufferTarget(_target); bound != id) {
             glBindBuffer(static_cast<GLenum>(_target), id);
-            state->buffer_target[_target] = id;
+            bound = id;
         }
     }
 }
 
 void StateBuffer::bindBaseAs(Type _target, GLuint index) const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        auto& point_map = state->buffer_point;
-        auto& target_map = state->buffer_target;
-        if (point_map[{_target, index}] != id) {
+        if (auto& point = state->getBufferPoint(_target, index); point != id) {
             glBindBufferBase(static_cast<GLenum>(_target), index, id);
-            point_map[{_target, index}] = id;
-            target_map[_target] = id;
+            point = id;
+            state->getBufferTarget(_target) = id;
         }
     }
 }
 
 void StateBuffer::bindBase(GLuint index) const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        auto& point_map = state->buffer_point;
-        auto& target_map = state->buffer_target;
-        if (point_map[{target, index}] != id) {
+        if (auto& point = state->getBufferPoint(target, index); point != id) {
             glBindBufferBase(static_cast<GLenum>(target), index, id);
-            point_map[{target, index}] = id;
-            target_map[target] = id;
+            point = id;
+            state->getBufferTarget(target) = id;
         }
     }
 }
@@ -137,12 +128,7 @@ void StateBuffer::clearData(GLenum internalformat, GLenum format, GLenum type, c
 
 void StateBuffer::waitFence() noexcept {
     if (sync) {
-        for (;;) {
-            auto wait_result = glClientWaitSync(sync.value(), 0, 0);
-            if (wait_result == GL_ALREADY_SIGNALED || wait_result == GL_CONDITION_SATISFIED)
-                break;
-        }
-        glDeleteSync(sync.value());
+        sync->wait();
         sync.reset();
     }
 }
@@ -214,43 +200,41 @@ void StateBuffer::unmapBuffer() const noexcept {
     glUnmapBuffer(static_cast<GLenum>(target));
 }
 
+// draws share fence of current frame, so sync object is created once per frame rather than per draw
 void StateBuffer::fence() noexcept {
-    if (sync) {
-        glDeleteSync(sync.value());
-        sync.reset();
-    }
+    bool guarded = false;
 
     if (access.index() == 0) {
-        if (std::get<MutableAccess>(access) == MutableAccess::WriteUnsync) {
-            sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-        }
+        guarded = std::get<MutableAccess>(access) == MutableAccess::WriteUnsync;
     }
 
     if (access.index() == 1) {
-        if (auto acc = std::get<ImmutableAccess>(access); acc == ImmutableAccess::WritePersistence || acc == ImmutableAccess::WriteCoherent) {
-            sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
-        }
+        const auto acc = std::get<ImmutableAccess>(access);
+        guarded = acc == ImmutableAccess::WritePersistence || acc == ImmutableAccess::WriteCoherent;
     }
-}
 
-void StateBuffer::bindBufferRangeAs(Buffer::Type _target, GLuint index, GLintptr offset) const noexcept {
-    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        if (auto& point_map = state->buffer_point; point_map[{_target, index}] != id) {
-            glBindBufferRange(static_cast<GLenum>(_target), index, id, offset, size);
-            point_map[{_target, index}] = id;
+    if (guarded) {
+        if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+            if (const auto& frame_fence = state->getFrameFence(); sync != frame_fence) {
+                sync = frame_fence;
+            }
         }
     }
 }
 
-void StateBuffer::bindBufferRange(GLuint index, GLintptr offset) const noexcept {
+// ranges of the same buffer differ, so point is always rebound and left unknown for later base binds
+void StateBuffer::bindBufferRangeAs(Buffer::Type _target, GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept {
     if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
-        if (auto& point_map = state->buffer_point; point_map[{target, index}] != id) {
-            glBindBufferRange(static_cast<GLenum>(target), index, id, offset, size);
-            point_map[{target, index}] = id;
-        }
+        glBindBufferRange(static_cast<GLenum>(_target), index, id, offset, range_size);
+        state->getBufferPoint(_target, index) = 0;
+        state->getBufferTarget(_target) = id;
     }
 }
 
+void StateBuffer::bindBufferRange(GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept {
+    bindBufferRangeAs(target, index, offset, range_size);
+}
+
 Buffer::Type StateBuffer::getType() const noexcept {
     return target;
 }
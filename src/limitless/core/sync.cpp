@@ -0,0 +1,66 @@
+#include <limitless/core/sync.hpp>
+
+#include <limitless/core/context_state.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    constexpr GLuint64 wait_timeout = 1'000'000; // 1 ms
+}
+
+Fence::~Fence() {
+    if (sync && ContextState::getState(glfwGetCurrentContext())) {
+        glDeleteSync(sync);
+    }
+}
+
+void Fence::place() noexcept {
+    if (sync) {
+        glDeleteSync(sync);
+    }
+
+    sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void Fence::wait() noexcept {
+    auto* state = ContextState::getState(glfwGetCurrentContext());
+
+    if (!sync) {
+        // fence of current frame is placed right away, later users get the next one
+        if (state) {
+            state->fenceFrame();
+        }
+
+        if (!sync) {
+            place();
+        }
+    }
+
+    auto result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+    if (result == GL_TIMEOUT_EXPIRED) {
+        const auto start = std::chrono::steady_clock::now();
+
+        do {
+            result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, wait_timeout);
+        } while (result == GL_TIMEOUT_EXPIRED);
+
+        if (state) {
+            const auto stall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+            auto& stats = state->sync_stats;
+            ++stats.stalls;
+            stats.stall_time += stall;
+            stats.max_stall = std::max(stats.max_stall, stall);
+        }
+    }
+
+    if (state) {
+        ++state->sync_stats.waits;
+
+        if (result == GL_WAIT_FAILED) {
+            ++state->sync_stats.failures;
+        }
+    }
+}
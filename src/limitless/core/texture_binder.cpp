@@ -1,117 +1,88 @@
 #include <limitless/core/texture_binder.hpp>
 #include <limitless/core/context_state.hpp>
-#include <limitless/core/context_initializer.hpp>
-#include <algorithm>
 #include <stdexcept>
-#include <iterator>
 
 using namespace Limitless;
-//
-//GLint TextureBinder::bind(Texture& texture) noexcept {
-//    // contains [unit_index, texture_id]
-//    const auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-//
-//    // checks if there is already bound texture
-//    const auto already_bound = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == texture.getId(); });
-//    if (already_bound != texture_bound.end()) {
-//        return already_bound->first;
-//    }
-//
-//    // checks for free slots
-//    const auto empty_slot = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-//    if (empty_slot != texture_bound.end()) {
-//        texture.bind(empty_slot->first);
-//        return empty_slot->first;
-//    }
-//
-//    const auto unit = current_bind;
-//    texture.bind(unit);
-//
-//    current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
-//
-//    return unit;
-//}
 
-std::vector<GLint> TextureBinder::bind(const std::vector<Texture*>& textures) {
-    if (textures.size() > static_cast<size_t>(ContextInitializer::limits.max_texture_units)) {
-        throw std::runtime_error("Failed to bind textures which more than texture units.");
+void TextureBinder::resize(GLuint unit_count) {
+    prev.resize(unit_count);
+    next.resize(unit_count);
+    unit_set.assign(unit_count, 0);
+
+    for (GLuint i = 0; i < unit_count; ++i) {
+        prev[i] = i == 0 ? 0 : i - 1;
+        next[i] = i + 1 == unit_count ? i : i + 1;
     }
 
-    using IndexMap = std::map<uint32_t, const Texture*>;
-    auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-    std::vector<GLint> indices(textures.size(), -1);
+    lru = 0;
+    mru = unit_count == 0 ? 0 : unit_count - 1;
+}
 
-    IndexMap bind_map;
-    uint32_t i = 0;
-    for (const auto* texture : textures) {
-        bind_map.emplace(i++, texture);
+// moves unit to the end of list
+void TextureBinder::touch(GLuint unit) noexcept {
+    unit_set[unit] = current_set;
+
+    if (unit == mru) {
+        return;
+    }
+
+    if (unit == lru) {
+        lru = next[unit];
+    } else {
+        next[prev[unit]] = next[unit];
+        prev[next[unit]] = prev[unit];
+    }
+
+    prev[unit] = mru;
+    next[unit] = unit;
+    next[mru] = unit;
+    mru = unit;
+}
+
+GLint TextureBinder::bindUnit(const std::vector<GLuint>& texture_bound, const Texture& texture) {
+    if (const auto hint = texture.unit_hint; hint < texture_bound.size() && texture_bound[hint] == texture.getId()) {
+        touch(hint);
+        return static_cast<GLint>(hint);
+    }
+
+    // every unit is taken by textures of current set
+    if (prev.empty() || unit_set[lru] == current_set) {
+        throw std::runtime_error("Failed to bind textures which more than texture units.");
     }
 
-    // checks if there is already bound to context textures and creates map with it
-    IndexMap already_bound;
-    for (const auto& [index, texture] : bind_map) {
-        const auto& tex_ptr = texture;
-        const auto found = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == tex_ptr->getId(); });
-        if (found != texture_bound.end()) {
-            indices[index] = found->first;
-            already_bound.emplace(index, texture);
-        }
+    const auto unit = lru;
+
+    texture.bind(unit);
+    texture.unit_hint = unit;
+    touch(unit);
+
+    return static_cast<GLint>(unit);
+}
+
+void TextureBinder::begin() {
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        ++state->texture_binder.current_set;
     }
+}
 
-    // creates map with unbound textures
-    IndexMap unbound_map;
-    std::set_difference(bind_map.begin(), bind_map.end(), already_bound.begin(), already_bound.end(), std::inserter(unbound_map, unbound_map.begin()));
-
-    // checks for free texture unit slots in context
-    IndexMap empty_bound;
-    for (const auto& [index, texture] : unbound_map) {
-        auto found = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-        if (found != texture_bound.end()) {
-            indices[index] = found->first;
-            empty_bound.emplace(index, texture);
-            texture->bind(found->first);
-        }
+GLint TextureBinder::bind(const Texture& texture) {
+    auto* state = ContextState::getState(glfwGetCurrentContext());
+    if (!state) {
+        throw std::runtime_error("Failed to bind texture without context state.");
     }
 
-    IndexMap replace_map;
-    std::set_difference(unbound_map.begin(), unbound_map.end(), empty_bound.begin(), empty_bound.end(), std::inserter(replace_map, replace_map.begin()));
-
-    for (const auto& [index, texture] : replace_map) {
-        std::vector<int>::iterator found;
-        while (found != indices.end()) {
-            found = std::find_if(indices.begin(), indices.end(), [] (const auto& index) { return index == current_bind; });
-            if (found == indices.end()) {
-                indices[index] = current_bind;
-                texture->bind(current_bind);
-                current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
-            }
-        }
+    return state->texture_binder.bindUnit(state->texture_bound, texture);
+}
+
+std::vector<GLint> TextureBinder::bind(const std::vector<Texture*>& textures) {
+    begin();
+
+    std::vector<GLint> units;
+    units.reserve(textures.size());
+
+    for (const auto* texture : textures) {
+        units.emplace_back(bind(*texture));
     }
 
-    return indices;
+    return units;
 }
-//
-//GLint TextureBinder::bind(GLenum target, const ExtensionTexture& texture) noexcept {
-//    // contains [unit_index, texture_id]
-//    const auto& texture_bound = ContextState::getState(glfwGetCurrentContext())->texture_bound;
-//
-//    // checks if there is already bound texture
-//    const auto already_bound = std::find_if(texture_bound.begin(), texture_bound.end(), [&] (const auto& bind) { return bind.second == texture.getId(); });
-//    if (already_bound != texture_bound.end()) {
-//        return already_bound->first;
-//    }
-//
-//    // checks for free slots
-//    const auto empty_slot = std::find_if(texture_bound.begin(), texture_bound.end(), [] (const auto& bind) { return bind.second == 0; });
-//    if (empty_slot != texture_bound.end()) {
-//        texture.bind(target, empty_slot->first);
-//        return empty_slot->first;
-//    }
-//
-//    const auto unit = current_bind;
-//    texture.bind(target, unit);
-//
-//    current_bind = ++current_bind >= ContextInitializer::limits.max_texture_units ? 0 : current_bind;
-//
-//    return unit;
-//}
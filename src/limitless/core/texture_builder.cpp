@@ -9,7 +9,7 @@
 using namespace Limitless;
 
 ExtensionTexture* TextureBuilder::getSupportedTexture(Texture::Type target) {
-    ExtensionTexture* extension_texture = ContextInitializer::isExtensionSupported("GL_ARB_direct_state_access") ?
+    ExtensionTexture* extension_texture = ContextInitializer::isDirectStateAccessSupported() ?
                                           new NamedTexture(static_cast<GLenum>(target)) :
                                           new StateTexture();
 
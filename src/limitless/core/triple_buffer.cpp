@@ -1,131 +1,152 @@
 #include <limitless/core/triple_buffer.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/context_state.hpp>
+#include <algorithm>
 #include <cstring>
-#include <stdexcept>
-#include <cstdlib>
 
 using namespace Limitless;
 
-TripleBuffer::TripleBuffer(decltype(buffers) buffers) noexcept
-        : buffers(std::move(buffers)), curr_index(0) {
-
+TripleBuffer::TripleBuffer(Type _target, size_t size, const void* data)
+    : target {_target}
+    , region_size {std::max<size_t>(size, 1)} {
+    create(data);
 }
 
-void TripleBuffer::mapData(const void* data, size_t data_size) {
-    if (data_size == 0) return;
+void TripleBuffer::create(const void* data) {
+    BufferBuilder builder;
+    builder.setTarget(target)
+           .setData(nullptr)
+           .setDataSize(region_size * region_count);
+
+    if (ContextInitializer::isExtensionSupported("GL_ARB_buffer_storage")) {
+        buffer = builder.setUsage(Buffer::Storage::DynamicCoherentWrite)
+                        .setAccess(Buffer::ImmutableAccess::WriteCoherent)
+                        .build();
 
-    const auto &buffer = buffers[curr_index];
+        persistent_ptr = static_cast<uint8_t*>(buffer->mapBufferRange(0, static_cast<GLsizeiptr>(region_size * region_count)));
+    } else {
+        // fences are the only guard of regions, so driver does not have to sync them
+        buffer = builder.setUsage(Buffer::Usage::StreamDraw)
+                        .setAccess(Buffer::MutableAccess::WriteUnsync)
+                        .build();
 
-    if (data_size > buffer->getSize()) {
-        throw std::logic_error("Buffer capacity is not enough to map data.");
+        persistent_ptr = nullptr;
     }
 
-    auto access = buffer->getAccess();
-
-    if (access.index() == 0) {
-        switch (std::get<MutableAccess>(access)) {
-            case MutableAccess::None:
-                throw std::runtime_error("Static created buffer should not be mapped.");
-            case MutableAccess::Write:
-                [[fallthrough]];
-            case MutableAccess::WriteOrphaning:
-                std::memcpy(mapBufferRange(0, data_size), data, data_size);
-                unmapBuffer();
-                break;
-            case MutableAccess::WriteUnsync:
-                waitFence();
-                std::memcpy(mapBufferRange(0, data_size), data, data_size);
-                glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
-                break;
-        }
+    curr_index = 0;
+
+    if (data) {
+        std::memcpy(mapBufferRange(0, static_cast<GLsizeiptr>(region_size)), data, region_size);
+        unmapBuffer();
     }
+}
 
-    if (access.index() == 1) {
-        switch (std::get<ImmutableAccess>(access)) {
-            case ImmutableAccess::None:
-                throw std::runtime_error("Static created storage cannot be mapped.");
-            case ImmutableAccess::WritePersistence:
-                waitFence();
-                std::memcpy(mapBufferRange(0, data_size), data, data_size);
-                glMemoryBarrier(GL_CLIENT_MAPPED_BUFFER_BARRIER_BIT);
-                break;
-            case ImmutableAccess::WriteCoherent:
-                waitFence();
-                std::memcpy(mapBufferRange(0, data_size), data, data_size);
-                break;
-        }
+void TripleBuffer::mapData(const void* data, size_t data_size) {
+    if (data_size == 0) return;
+
+    if (data_size > region_size) {
+        throw buffer_error{"Buffer capacity is not enough to map data"};
     }
+
+    // previous region can still be in use by current frame
+    curr_index = (curr_index + 1) % region_count;
+
+    waitFence();
+
+    std::memcpy(mapBufferRange(0, static_cast<GLsizeiptr>(data_size)), data, data_size);
+    unmapBuffer();
 }
 
 void TripleBuffer::clearSubData(GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void* data) const noexcept {
-    buffers[curr_index]->clearSubData(internalformat, offset, size, format, type, data);
+    buffer->clearSubData(internalformat, getOffset() + offset, size, format, type, data);
 }
 
 void TripleBuffer::clearData(GLenum internalformat, GLenum format, GLenum type, const void* data) const noexcept {
-    buffers[curr_index]->clearData(internalformat, format, type, data);
+    buffer->clearSubData(internalformat, getOffset(), static_cast<GLsizeiptr>(region_size), format, type, data);
 }
 
 void TripleBuffer::bufferSubData(GLintptr offset, size_t sub_size, const void* data) const noexcept {
-    buffers[curr_index]->bufferSubData(offset, sub_size, data);
+    buffer->bufferSubData(getOffset() + offset, sub_size, data);
 }
 
-void TripleBuffer::bindBaseAs(Type target, GLuint index) const noexcept {
-    buffers[curr_index]->bindBaseAs(target, index);
+void TripleBuffer::bindBaseAs(Type _target, GLuint index) const noexcept {
+    buffer->bindBufferRangeAs(_target, index, getOffset(), static_cast<GLsizeiptr>(region_size));
 }
 
 void TripleBuffer::bindBase(GLuint index) const noexcept {
-    buffers[curr_index]->bindBase(index);
+    buffer->bindBufferRangeAs(target, index, getOffset(), static_cast<GLsizeiptr>(region_size));
 }
 
-void TripleBuffer::bindBufferRangeAs(Type target, GLuint index, GLintptr offset) const noexcept {
-    buffers[curr_index]->bindBufferRangeAs(target, index, offset);
+void TripleBuffer::bindBufferRangeAs(Type _target, GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept {
+    buffer->bindBufferRangeAs(_target, index, getOffset() + offset, range_size);
 }
 
-void TripleBuffer::bindBufferRange(GLuint index, GLintptr offset) const noexcept {
-    buffers[curr_index]->bindBufferRange(index, offset);
+void TripleBuffer::bindBufferRange(GLuint index, GLintptr offset, GLsizeiptr range_size) const noexcept {
+    buffer->bindBufferRangeAs(target, index, getOffset() + offset, range_size);
 }
 
-void TripleBuffer::bindAs(Type target) const noexcept {
-    buffers[curr_index]->bindAs(target);
+void TripleBuffer::bindAs(Type _target) const noexcept {
+    buffer->bindAs(_target);
 }
 
 void TripleBuffer::bind() const noexcept {
-    buffers[curr_index]->bind();
+    buffer->bind();
+}
+
+void TripleBuffer::resize(size_t size) noexcept {
+    // new storage has not been used by GPU yet
+    fences = {};
+
+    region_size = std::max<size_t>(size, 1);
+    create(nullptr);
 }
 
 void TripleBuffer::waitFence() noexcept {
-    buffers[curr_index]->waitFence();
+    if (auto& fence = fences[curr_index]; fence) {
+        fence->wait();
+        fence.reset();
+    }
 }
 
+// every draw of region during frame shares the same fence
 void TripleBuffer::fence() noexcept {
-    buffers[curr_index]->fence();
-
-    curr_index = ++curr_index >= 3 ? 0 : curr_index;
+    if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+        fences[curr_index] = state->getFrameFence();
+    }
 }
 
 void* TripleBuffer::mapBufferRange(GLintptr offset, GLsizeiptr size) const {
-    return buffers[curr_index]->mapBufferRange(offset, size);
+    if (persistent_ptr) {
+        return persistent_ptr + getOffset() + offset;
+    }
+
+    return buffer->mapBufferRange(getOffset() + offset, size);
 }
 
 void TripleBuffer::unmapBuffer() const noexcept {
-    buffers[curr_index]->unmapBuffer();
+    if (!persistent_ptr) {
+        buffer->unmapBuffer();
+    }
 }
 
 GLuint TripleBuffer::getId() const noexcept {
-    return buffers[curr_index]->getId();
+    return buffer->getId();
 }
 
 Buffer::Type TripleBuffer::getType() const noexcept {
-    return buffers[curr_index]->getType();
+    return target;
 }
 
 size_t TripleBuffer::getSize() const noexcept {
-    return buffers[curr_index]->getSize();
+    return region_size;
 }
 
 const std::variant<Buffer::Usage, Buffer::Storage>& TripleBuffer::getUsageFlags() const noexcept {
-    return buffers[curr_index]->getUsageFlags();
+    return buffer->getUsageFlags();
 }
 
 const std::variant<Buffer::MutableAccess, Buffer::ImmutableAccess>& TripleBuffer::getAccess() const noexcept {
-    return buffers[curr_index]->getAccess();
+    return buffer->getAccess();
 }
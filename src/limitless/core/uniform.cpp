@@ -9,10 +9,25 @@ using namespace Limitless;
 
 Uniform::Uniform(std::string name, UniformType type, UniformValueType value_type) noexcept
     : name{std::move(name)}
+    , id{this->name}
     , type{type}
     , value_type{value_type}
     , changed{true} {}
 
+Uniform::Uniform(const Uniform& rhs)
+    : name{rhs.name}
+    , id{rhs.id}
+    , type{rhs.type}
+    , value_type{rhs.value_type}
+    , changed{rhs.changed} {}
+
+void Uniform::notify() noexcept {
+    changed = true;
+    if (observer) {
+        observer->onUniformChange(*this);
+    }
+}
+
 bool Limitless::operator<(const Uniform& lhs, const Uniform& rhs) noexcept {
     if (lhs.type != rhs.type) {
         return lhs.type < rhs.type;
@@ -83,7 +98,7 @@ template<typename T>
 void UniformValue<T>::setValue(const T& val) noexcept {
     if (value != val) {
         value = val;
-        changed = true;
+        notify();
     }
 }
 
@@ -126,37 +141,6 @@ template<typename T>
     return new UniformValue<T>(*this);
 }
 
-template<typename T>
-constexpr UniformValueType UniformValue<T>::getUniformValueType() {
-    if constexpr (std::is_same<T, int>::value) {
-        return UniformValueType::Int;
-    }
-    else if constexpr (std::is_same<T, unsigned int>::value) {
-        return UniformValueType::Uint;
-    }
-    else if constexpr (std::is_same<T, float>::value) {
-        return UniformValueType::Float;
-    }
-    else if constexpr (std::is_same<T, glm::vec2>::value) {
-        return UniformValueType::Vec2;
-    }
-    else if constexpr (std::is_same<T, glm::vec3>::value) {
-        return UniformValueType::Vec3;
-    }
-    else if constexpr (std::is_same<T, glm::vec4>::value) {
-        return UniformValueType::Vec4;
-    }
-    else if constexpr (std::is_same<T, glm::mat3>::value) {
-        return UniformValueType::Mat3;
-    }
-    else if constexpr (std::is_same<T, glm::mat4>::value) {
-        return UniformValueType::Mat4;
-    }
-    else {
-        static_assert(!std::is_same<T, T>::value, "Unimplemented value type for uniform T.");
-    }
-}
-
 UniformSampler::UniformSampler(const std::string& name, std::shared_ptr<Texture> sampler) noexcept
     : UniformValue{name, UniformType::Sampler, -1}, sampler{std::move(sampler)} { }
 
@@ -164,7 +148,7 @@ void UniformSampler::setSampler(const std::shared_ptr<Texture>& texture) noexcep
     if (sampler != texture || sampler_id != texture->getId()) {
         sampler = texture;
         sampler_id = texture->getId();
-        changed = true;
+        notify();
     }
 }
 
@@ -0,0 +1,32 @@
+#include <limitless/core/uniform_id.hpp>
+
+#include <unordered_map>
+#include <mutex>
+
+using namespace Limitless;
+
+namespace {
+    struct UniformNames {
+        std::unordered_map<std::string, uint32_t> indices;
+        std::mutex mutex;
+    };
+
+    // ids can be created during static initialization
+    UniformNames& getUniformNames() {
+        static UniformNames names;
+        return names;
+    }
+}
+
+UniformId::UniformId(const std::string& name) {
+    auto& names = getUniformNames();
+
+    std::unique_lock lock{names.mutex};
+
+    if (const auto found = names.indices.find(name); found != names.indices.end()) {
+        index = found->second;
+    } else {
+        index = static_cast<uint32_t>(names.indices.size());
+        names.indices.emplace(name, index);
+    }
+}
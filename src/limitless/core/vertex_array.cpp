@@ -1,13 +1,65 @@
 #include <limitless/core/vertex_array.hpp>
 #include <limitless/core/context_state.hpp>
+#include <limitless/core/context_initializer.hpp>
 #include <limitless/core/buffer.hpp>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace Limitless;
 
+const VertexFormat& Limitless::getVertexFormat(const Vertex&) noexcept {
+    static const VertexFormat format {{
+        { 0, 3, GL_FLOAT, GL_FALSE, offsetof(Vertex, position) },
+        { 1, 2, GL_FLOAT, GL_FALSE, offsetof(Vertex, uv) },
+    }, sizeof(Vertex) };
+    return format;
+}
+
+const VertexFormat& Limitless::getVertexFormat(const TextVertex&) noexcept {
+    static const VertexFormat format {{
+        { 0, 2, GL_FLOAT, GL_FALSE, offsetof(TextVertex, position) },
+        { 1, 2, GL_FLOAT, GL_FALSE, offsetof(TextVertex, uv) },
+    }, sizeof(TextVertex) };
+    return format;
+}
+
+const VertexFormat& Limitless::getVertexFormat(const VertexNormal&) noexcept {
+    static const VertexFormat format {{
+        { 0, 3, GL_FLOAT, GL_FALSE, offsetof(VertexNormal, position) },
+        { 1, 3, GL_FLOAT, GL_FALSE, offsetof(VertexNormal, normal) },
+        { 2, 2, GL_FLOAT, GL_FALSE, offsetof(VertexNormal, uv) },
+    }, sizeof(VertexNormal) };
+    return format;
+}
+
+const VertexFormat& Limitless::getVertexFormat(const VertexNormalTangent&) noexcept {
+    static const VertexFormat format {{
+        { 0, 3, GL_FLOAT, GL_FALSE, offsetof(VertexNormalTangent, position) },
+        { 1, 3, GL_FLOAT, GL_FALSE, offsetof(VertexNormalTangent, normal) },
+        { 2, 3, GL_FLOAT, GL_FALSE, offsetof(VertexNormalTangent, tangent) },
+        { 3, 2, GL_FLOAT, GL_FALSE, offsetof(VertexNormalTangent, uv) },
+    }, sizeof(VertexNormalTangent) };
+    return format;
+}
+
+const VertexFormat& Limitless::getVertexFormat(const VertexPackedNormalTangent&) noexcept {
+    static const VertexFormat format {{
+        { 0, 3, GL_FLOAT, GL_FALSE, offsetof(VertexPackedNormalTangent, position) },
+        { 1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(VertexPackedNormalTangent, normal) },
+        { 2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, offsetof(VertexPackedNormalTangent, tangent) },
+        { 3, 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(VertexPackedNormalTangent, uv) },
+    }, sizeof(VertexPackedNormalTangent) };
+    return format;
+}
+
 VertexArray::VertexArray(GLuint id) noexcept : id(id), next_attribute_index(0) {}
 
 VertexArray::VertexArray() noexcept : id(0), next_attribute_index(0) {
-    glGenVertexArrays(1, &id);
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glCreateVertexArrays(1, &id);
+    } else {
+        glGenVertexArrays(1, &id);
+    }
 }
 
 VertexArray::~VertexArray() {
@@ -31,26 +83,52 @@ void VertexArray::bind() const noexcept {
 }
 
 void VertexArray::enableAttribute(GLuint index) const noexcept {
-    glEnableVertexAttribArray(index);
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glEnableVertexArrayAttrib(id, index);
+    } else {
+        bind();
+        glEnableVertexAttribArray(index);
+    }
 }
 
 void VertexArray::disableAttribute(GLuint index) const noexcept {
-    glDisableVertexAttribArray(index);
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glDisableVertexArrayAttrib(id, index);
+    } else {
+        bind();
+        glDisableVertexAttribArray(index);
+    }
 }
 
 VertexArray& VertexArray::setAttribute(GLuint attr_id, const VertexAttribute& attribute) noexcept {
-    bind();
-
     const auto& [size, type, normalized, stride, pointer, buffer] = attribute;
 
-    buffer.bind();
+    if (attr_id < bindings.size()) {
+        bindings[attr_id].buffer = 0;
+    }
 
-    enableAttribute(attr_id);
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        if (type == GL_INT) {
+            glVertexArrayAttribIFormat(id, attr_id, size, type, 0);
+        } else {
+            glVertexArrayAttribFormat(id, attr_id, size, type, normalized, 0);
+        }
 
-    if (type == GL_INT) {
-        glVertexAttribIPointer(attr_id, size, type, stride, pointer);
+        glVertexArrayAttribBinding(id, attr_id, attr_id);
+        glVertexArrayVertexBuffer(id, attr_id, buffer.getId(), reinterpret_cast<GLintptr>(pointer), stride);
+        enableAttribute(attr_id);
     } else {
-        glVertexAttribPointer(attr_id, size, type, normalized, stride, pointer);
+        bind();
+
+        buffer.bind();
+
+        enableAttribute(attr_id);
+
+        if (type == GL_INT) {
+            glVertexAttribIPointer(attr_id, size, type, stride, pointer);
+        } else {
+            glVertexAttribPointer(attr_id, size, type, normalized, stride, pointer);
+        }
     }
 
     //todo: fix shitty logic
@@ -59,43 +137,175 @@ VertexArray& VertexArray::setAttribute(GLuint attr_id, const VertexAttribute& at
     return *this;
 }
 
-//VertexArray& VertexArray::operator<<(const VertexAttribute& attribute) noexcept {
-//    return setAttribute(next_attribute_index, attribute);
-//}
+VertexArray& VertexArray::setAttributeDivisor(GLuint attr_id, GLuint divisor) noexcept {
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glVertexArrayBindingDivisor(id, attr_id, divisor);
+    } else {
+        bind();
+        glVertexAttribDivisor(attr_id, divisor);
+    }
 
-VertexArray& VertexArray::operator<<(const std::pair<Vertex, Buffer&>& attribute) noexcept {
-    setAttribute(0,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, position), attribute.second });
-    setAttribute(1,  VertexAttribute{ 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid*)offsetof(Vertex, uv), attribute.second });
     return *this;
 }
 
-VertexArray& VertexArray::operator<<(const std::pair<VertexNormal, Buffer&>& attribute) noexcept {
-    setAttribute(0,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexNormal), (GLvoid*)offsetof(Vertex, position), attribute.second });
-    setAttribute(1,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexNormal), (GLvoid*)offsetof(VertexNormal, normal), attribute.second });
-    setAttribute(2,  VertexAttribute{ 2, GL_FLOAT, GL_FALSE, sizeof(VertexNormal), (GLvoid*)offsetof(VertexNormal, uv), attribute.second });
+VertexArray& VertexArray::setFormat(GLuint binding, const VertexFormat& format) noexcept {
+    if (binding >= bindings.size()) {
+        bindings.resize(binding + 1, VertexBinding{nullptr, 0, 0});
+    }
+
+    if (bindings[binding].format == &format) {
+        return *this;
+    }
+
+    bindings[binding] = {&format, 0, 0};
+
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        for (const auto& [index, size, type, normalized, offset] : format.attributes) {
+            if (type == GL_INT) {
+                glVertexArrayAttribIFormat(id, index, size, type, offset);
+            } else {
+                glVertexArrayAttribFormat(id, index, size, type, normalized, offset);
+            }
+
+            glVertexArrayAttribBinding(id, index, binding);
+            enableAttribute(index);
+        }
+
+        glVertexArrayBindingDivisor(id, binding, format.divisor);
+    } else if (ContextInitializer::isVertexAttribBindingSupported()) {
+        bind();
+
+        for (const auto& [index, size, type, normalized, offset] : format.attributes) {
+            if (type == GL_INT) {
+                glVertexAttribIFormat(index, size, type, offset);
+            } else {
+                glVertexAttribFormat(index, size, type, normalized, offset);
+            }
+
+            glVertexAttribBinding(index, binding);
+            enableAttribute(index);
+        }
+
+        glVertexBindingDivisor(binding, format.divisor);
+    }
+
+    for (const auto& attribute : format.attributes) {
+        next_attribute_index = std::max(next_attribute_index, attribute.index + 1);
+    }
+
     return *this;
 }
 
-VertexArray& VertexArray::operator<<(const std::pair<VertexNormalTangent, Buffer&>& attribute) noexcept {
-    setAttribute(0,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexNormalTangent), (GLvoid*)offsetof(Vertex, position), attribute.second });
-    setAttribute(1,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexNormalTangent), (GLvoid*)offsetof(VertexNormalTangent, normal), attribute.second });
-    setAttribute(2,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexNormalTangent), (GLvoid*)offsetof(VertexNormalTangent, tangent), attribute.second });
-    setAttribute(3,  VertexAttribute{ 2, GL_FLOAT, GL_FALSE, sizeof(VertexNormalTangent), (GLvoid*)offsetof(VertexNormalTangent, uv), attribute.second });
+VertexArray& VertexArray::setVertexBuffer(GLuint binding, const Buffer& buffer, GLintptr offset) noexcept {
+    auto& vertex_binding = bindings.at(binding);
+    if (vertex_binding.buffer == buffer.getId() && vertex_binding.offset == offset) {
+        return *this;
+    }
+
+    vertex_binding.buffer = buffer.getId();
+    vertex_binding.offset = offset;
+
+    const auto& format = *vertex_binding.format;
+
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glVertexArrayVertexBuffer(id, binding, buffer.getId(), offset, format.stride);
+    } else if (ContextInitializer::isVertexAttribBindingSupported()) {
+        bind();
+        glBindVertexBuffer(binding, buffer.getId(), offset, format.stride);
+    } else {
+        // pointers capture buffer bound to array target, so they are respecified
+        bind();
+
+        buffer.bind();
+
+        for (const auto& [index, size, type, normalized, attribute_offset] : format.attributes) {
+            enableAttribute(index);
+
+            const auto* pointer = reinterpret_cast<const GLvoid*>(offset + attribute_offset);
+            if (type == GL_INT) {
+                glVertexAttribIPointer(index, size, type, format.stride, pointer);
+            } else {
+                glVertexAttribPointer(index, size, type, normalized, format.stride, pointer);
+            }
+
+            glVertexAttribDivisor(index, format.divisor);
+        }
+    }
+
     return *this;
 }
 
-VertexArray& VertexArray::operator<<(const std::pair<VertexPackedNormalTangent, Buffer&>& attribute) noexcept {
-    setAttribute(0,  VertexAttribute{ 3, GL_FLOAT, GL_FALSE, sizeof(VertexPackedNormalTangent), (GLvoid*)offsetof(Vertex, position), attribute.second });
-    setAttribute(1,  VertexAttribute{ 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(VertexPackedNormalTangent), (GLvoid*)offsetof(VertexPackedNormalTangent, normal), attribute.second });
-    setAttribute(2,  VertexAttribute{ 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(VertexPackedNormalTangent), (GLvoid*)offsetof(VertexPackedNormalTangent, tangent), attribute.second });
-    setAttribute(3,  VertexAttribute{ 2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(VertexPackedNormalTangent), (GLvoid*)offsetof(VertexPackedNormalTangent, uv), attribute.second });
+VertexArray& VertexArray::setElementBuffer(const Buffer& _element_buffer) noexcept {
+    if (element_buffer == _element_buffer.getId()) {
+        return *this;
+    }
+
+    element_buffer = _element_buffer.getId();
+
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        glVertexArrayElementBuffer(id, element_buffer);
+    } else {
+        bind();
+
+        // element binding belongs to vertex array, so cached target is not trusted
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_buffer);
+        if (auto* state = ContextState::getState(glfwGetCurrentContext()); state) {
+            state->getBufferTarget(Buffer::Type::Element) = element_buffer;
+        }
+    }
+
     return *this;
 }
 
+void VertexArray::detach(GLuint buffer) noexcept {
+    for (auto& binding : bindings) {
+        if (binding.buffer == buffer) {
+            binding.buffer = 0;
+        }
+    }
+
+    if (element_buffer == buffer) {
+        element_buffer = 0;
+    }
+}
+
+VertexArray& VertexArray::getShared(std::initializer_list<const VertexFormat*> formats) {
+    auto* state = ContextState::getState(glfwGetCurrentContext());
+    if (!state) {
+        throw std::logic_error{"Shared vertex array requires current context"};
+    }
+
+    return state->shared_vertex_arrays.get(formats);
+}
+
+VertexArray& SharedVertexArrays::get(std::initializer_list<const VertexFormat*> formats) {
+    for (auto& [key, vertex_array] : vertex_arrays) {
+        if (std::equal(key.begin(), key.end(), formats.begin(), formats.end())) {
+            return *vertex_array;
+        }
+    }
+
+    auto vertex_array = std::make_unique<VertexArray>();
+    GLuint binding = 0;
+    for (const auto* format : formats) {
+        vertex_array->setFormat(binding++, *format);
+    }
+
+    return *vertex_arrays.emplace_back(formats, std::move(vertex_array)).second;
+}
+
+void SharedVertexArrays::detach(GLuint buffer) noexcept {
+    for (auto& [key, vertex_array] : vertex_arrays) {
+        vertex_array->detach(buffer);
+    }
+}
+
+//VertexArray& VertexArray::operator<<(const VertexAttribute& attribute) noexcept {
+//    return setAttribute(next_attribute_index, attribute);
+//}
+
 VertexArray& VertexArray::operator<<(const Buffer& element_buffer) noexcept {
-    bind();
-    element_buffer.bind();
-    return *this;
+    return setElementBuffer(element_buffer);
 }
 
 VertexArray::VertexArray(VertexArray&& rhs) noexcept : VertexArray(0) {
@@ -112,10 +322,6 @@ void Limitless::swap(VertexArray& lhs, VertexArray& rhs) {
 
     swap(lhs.id, rhs.id);
     swap(lhs.next_attribute_index, rhs.next_attribute_index);
-}
-
-VertexArray& VertexArray::operator<<(const std::pair<TextVertex, Buffer&>& attribute) noexcept {
-    setAttribute(0, VertexAttribute{ 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (GLvoid*)offsetof(TextVertex, position), attribute.second });
-    setAttribute(1, VertexAttribute{ 2, GL_FLOAT, GL_FALSE, sizeof(TextVertex), (GLvoid*)offsetof(TextVertex, uv), attribute.second });
-	return *this;
+    swap(lhs.bindings, rhs.bindings);
+    swap(lhs.element_buffer, rhs.element_buffer);
 }
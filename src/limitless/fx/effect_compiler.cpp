@@ -108,6 +108,8 @@ std::string EffectCompiler::getEmitterDefines(const AbstractEmitter& emitter) no
 template<typename T>
 void EffectCompiler::compile(ShaderPass shader_type, const T& emitter) {
     if (!assets.shaders.contains({emitter.getUniqueShaderType(), shader_type})) {
+        watched_defines = getWatchedDefines(emitter.getMaterial());
+
         const auto props = [&] (Shader& shader) {
             replaceMaterialSettings(shader, emitter.getMaterial(), ModelShader::Effect);
             replaceRenderSettings(shader);
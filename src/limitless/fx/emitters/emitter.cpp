@@ -2,6 +2,29 @@
 
 using namespace Limitless::fx;
 
+namespace {
+    // expands box by particle extent around its position
+    void expand(glm::vec3& min, glm::vec3& max, const SpriteParticle& particle) noexcept {
+        const auto extent = glm::vec3{particle.getSize() * 0.5f};
+        min = glm::min(min, particle.getPosition() - extent);
+        max = glm::max(max, particle.getPosition() + extent);
+    }
+
+    // assumes mesh of unit size, MeshEmitter accounts for its mesh bounds
+    void expand(glm::vec3& min, glm::vec3& max, const MeshParticle& particle) noexcept {
+        const auto extent = glm::vec3{glm::length(particle.getSize())};
+        min = glm::min(min, particle.getPosition() - extent);
+        max = glm::max(max, particle.getPosition() + extent);
+    }
+
+    // beam spans from particle position to its target and can be displaced sideways
+    void expand(glm::vec3& min, glm::vec3& max, const BeamParticle& particle) noexcept {
+        const auto extent = glm::vec3{particle.getSize() * 0.5f + particle.getDisplacement()};
+        min = glm::min(min, glm::min(particle.getPosition(), particle.getTarget()) - extent);
+        max = glm::max(max, glm::max(particle.getPosition(), particle.getTarget()) + extent);
+    }
+}
+
 template<typename Particle>
 bool ModuleCompare<Particle>::operator() (const std::unique_ptr<Module<Particle>>& lhs, const std::unique_ptr<Module<Particle>>& rhs) const {
     return lhs->getType() < rhs->getType();
@@ -38,6 +61,22 @@ const glm::quat& Emitter<P>::getRotation() const noexcept {
     return rotation;
 }
 
+template<typename P>
+Limitless::BoundingBox Emitter<P>::getBoundingBox() const noexcept {
+    if (particles.empty()) {
+        return { position + local_position, glm::vec3{0.0f} };
+    }
+
+    auto min = glm::vec3{std::numeric_limits<float>::max()};
+    auto max = glm::vec3{std::numeric_limits<float>::lowest()};
+
+    for (const auto& particle : particles) {
+        expand(min, max, particle);
+    }
+
+    return { (min + max) * 0.5f, max - min };
+}
+
 template<typename P>
 void Emitter<P>::kill() noexcept {
     done = true;
@@ -4,6 +4,7 @@
 #include <limitless/fx/modules/module.hpp>
 
 #include <limitless/ms/material.hpp>
+#include <limitless/models/abstract_mesh.hpp>
 
 using namespace Limitless::fx;
 
@@ -44,3 +45,24 @@ void MeshEmitter::accept(EmitterVisitor& visitor) noexcept {
 UniqueEmitterRenderer MeshEmitter::getUniqueRendererType() const noexcept {
     return { type, mesh, material };
 }
+
+Limitless::BoundingBox MeshEmitter::getBoundingBox() const noexcept {
+    if (particles.empty()) {
+        return { position + local_position, glm::vec3{0.0f} };
+    }
+
+    const auto& mesh_box = mesh->getBoundingBox();
+    // mesh is rotated around its origin, so its farthest point bounds it in any orientation
+    const auto mesh_radius = glm::length(mesh_box.center) + glm::length(mesh_box.size * 0.5f);
+
+    auto min = glm::vec3{std::numeric_limits<float>::max()};
+    auto max = glm::vec3{std::numeric_limits<float>::lowest()};
+
+    for (const auto& particle : particles) {
+        const auto extent = glm::vec3{mesh_radius * glm::max(particle.getSize().x, glm::max(particle.getSize().y, particle.getSize().z))};
+        min = glm::min(min, particle.getPosition() - extent);
+        max = glm::max(max, particle.getPosition() + extent);
+    }
+
+    return { (min + max) * 0.5f, max - min };
+}
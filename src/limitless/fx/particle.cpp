@@ -5,27 +5,31 @@
 using namespace Limitless::fx;
 using namespace Limitless;
 
-VertexArray& Limitless::fx::operator<<(VertexArray& vertex_array, const std::pair<SpriteParticle, Buffer&>& attribute) noexcept {
-    vertex_array.setAttribute(0, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, color), attribute.second });
-    vertex_array.setAttribute(1, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, subUV), attribute.second });
-    vertex_array.setAttribute(2, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, properties), attribute.second });
-    vertex_array.setAttribute(3, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, acceleration_lifetime), attribute.second });
-    vertex_array.setAttribute(4, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, position_size), attribute.second });
-    vertex_array.setAttribute(5, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, rotation_time), attribute.second });
-    vertex_array.setAttribute(6, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(SpriteParticle), (GLvoid*)offsetof(SpriteParticle, velocity), attribute.second });
-    return vertex_array;
+const VertexFormat& Limitless::fx::getVertexFormat(const SpriteParticle&) noexcept {
+    static const VertexFormat format {{
+        { 0, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, color) },
+        { 1, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, subUV) },
+        { 2, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, properties) },
+        { 3, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, acceleration_lifetime) },
+        { 4, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, position_size) },
+        { 5, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, rotation_time) },
+        { 6, 4, GL_FLOAT, GL_FALSE, offsetof(SpriteParticle, velocity) },
+    }, sizeof(SpriteParticle) };
+    return format;
 }
 
-VertexArray& Limitless::fx::operator<<(VertexArray& vertex_array, const std::pair<BeamParticleMapping, Buffer&>& attribute) noexcept {
-    vertex_array.setAttribute(0, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, position), attribute.second });
-    vertex_array.setAttribute(1, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, color), attribute.second });
-    vertex_array.setAttribute(2, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, subUV), attribute.second });
-    vertex_array.setAttribute(3, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, properties), attribute.second });
-    vertex_array.setAttribute(4, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, acceleration_lifetime), attribute.second });
-    vertex_array.setAttribute(5, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, rotation_time), attribute.second });
-    vertex_array.setAttribute(6, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, velocity_size), attribute.second });
-    vertex_array.setAttribute(7, VertexAttribute{4, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, uv_length), attribute.second });
-    vertex_array.setAttribute(8, VertexAttribute{3, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, start), attribute.second });
-    vertex_array.setAttribute(9, VertexAttribute{3, GL_FLOAT, GL_FALSE, sizeof(BeamParticleMapping), (GLvoid*)offsetof(BeamParticleMapping, end), attribute.second });
-    return vertex_array;
+const VertexFormat& Limitless::fx::getVertexFormat(const BeamParticleMapping&) noexcept {
+    static const VertexFormat format {{
+        { 0, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, position) },
+        { 1, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, color) },
+        { 2, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, subUV) },
+        { 3, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, properties) },
+        { 4, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, acceleration_lifetime) },
+        { 5, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, rotation_time) },
+        { 6, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, velocity_size) },
+        { 7, 4, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, uv_length) },
+        { 8, 3, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, start) },
+        { 9, 3, GL_FLOAT, GL_FALSE, offsetof(BeamParticleMapping, end) },
+    }, sizeof(BeamParticleMapping) };
+    return format;
 }
\ No newline at end of file
@@ -12,6 +12,24 @@ void AbstractInstance::calculateModelMatrix() noexcept {
     const auto scale_matrix = glm::scale(glm::mat4{1.0f}, scale);
 
     model_matrix = translation_matrix * rotation_matrix * scale_matrix;
+
+    rebuilt_matrix_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AbstractInstance::storeTransform() noexcept {
+    if (!transform) {
+        return;
+    }
+
+    if (transform.store->isLocked()) {
+        transform.pending = true;
+        return;
+    }
+
+    transform.store->setPosition(transform.handle, position);
+    transform.store->setRotation(transform.handle, rotation);
+    transform.store->setScale(transform.handle, scale);
+    transform.pending = false;
 }
 
 void AbstractInstance::reveal() noexcept {
@@ -35,6 +53,9 @@ AbstractInstance& AbstractInstance::setPosition(const glm::vec3& _position) noex
     LightAttachable::setPosition(_position);
 
     position = _position;
+    storeTransform();
+
+    transform_changed = true;
     return *this;
 }
 
@@ -43,6 +64,9 @@ AbstractInstance& AbstractInstance::setRotation(const glm::quat& _rotation) noex
     LightAttachable::setRotation(_rotation);
 
     rotation = _rotation;
+    storeTransform();
+
+    transform_changed = true;
     return *this;
 }
 
@@ -51,11 +75,17 @@ AbstractInstance& AbstractInstance::rotateBy(const glm::quat& _rotation) noexcep
     LightAttachable::rotateBy(_rotation);
 
     rotation = _rotation * rotation;
+    storeTransform();
+
+    transform_changed = true;
     return *this;
 }
 
 AbstractInstance& AbstractInstance::setScale(const glm::vec3& _scale) noexcept {
     scale = _scale;
+    storeTransform();
+
+    transform_changed = true;
     return *this;
 }
 
@@ -66,8 +96,24 @@ void AbstractInstance::draw(Context& ctx, const Assets& assets, ShaderPass mater
 void AbstractInstance::update(Context& context, Camera& camera) {
     EffectAttachable::update(context, camera);
 
-    calculateModelMatrix();
-    calculateBoundingBox();
+    if (transform_changed) {
+        // scene composes matrices of its instances before updating them
+        // the entry is stale if transform was changed by update jobs themselves
+        if (transform && !transform.pending && !transform.store->isDirty(transform.handle)) {
+            model_matrix = transform.store->getMatrix(transform.handle);
+        } else {
+            calculateModelMatrix();
+        }
+        calculateBoundingBox();
+
+        transform_changed = false;
+        bounds_changed = true;
+    }
+}
+
+void AbstractInstance::updateLights() noexcept {
+    EffectAttachable::updateLights();
+    LightAttachable::updateLights();
 }
 
 AbstractInstance::AbstractInstance(Lighting* _lighting, ModelShader _shader_type, const glm::vec3& _position) noexcept
@@ -50,6 +50,12 @@ void EffectAttachable::setPosition(const glm::vec3& position) noexcept {
         instance->setPosition(position + offset);
 }
 
+void EffectAttachable::updateLights() noexcept {
+    for (auto& [instance, offset] : attachments) {
+        instance->updateLights();
+    }
+}
+
 void EffectAttachable::setRotation(const glm::quat& rotation) noexcept {
     for (auto& [instance, offset] : attachments)
         instance->setRotation(rotation);
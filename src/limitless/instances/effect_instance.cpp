@@ -55,12 +55,19 @@ EffectInstance::EffectInstance(const EffectInstance& effect) noexcept
 }
 
 void EffectInstance::update(Context& context, Camera& camera) {
-    AbstractInstance::update(context, camera);
-
     for (auto& [name, emitter] : emitters) {
         emitter->update(context, camera);
     }
 
+    // bounds are calculated from particles, so emitters are updated first
+    AbstractInstance::update(context, camera);
+
+    // particles move every frame even if instance does not
+    if (!bounds_changed) {
+        calculateBoundingBox();
+        bounds_changed = true;
+    }
+
     done = isDone();
 }
 
@@ -99,5 +106,15 @@ EffectInstance::EffectInstance() noexcept
 }
 
 void EffectInstance::calculateBoundingBox() noexcept {
-    //TODO:
+    bool empty = true;
+
+    for (const auto& [name, emitter] : emitters) {
+        const auto box = emitter->getBoundingBox();
+        bounding_box = empty ? box : mergeBoundingBox(bounding_box, box);
+        empty = false;
+    }
+
+    if (empty) {
+        bounding_box = { position, glm::vec3{0.0f} };
+    }
 }
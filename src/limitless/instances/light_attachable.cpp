@@ -13,8 +13,19 @@ LightAttachable::~LightAttachable() {
 }
 
 void LightAttachable::setPosition(const glm::vec3& position) noexcept {
+    light_position = position;
+    lights_moved = true;
+}
+
+void LightAttachable::updateLights() noexcept {
+    if (!lights_moved) {
+        return;
+    }
+
     for (const auto& [id, offset] : point_lights)
-        lighting->point_lights[id].position = { position + offset, 1.0f };
+        lighting->point_lights[id].position = { light_position + offset, 1.0f };
+
+    lights_moved = false;
 }
 
 void LightAttachable::setRotation([[maybe_unused]] const glm::quat& rotation) noexcept {
@@ -7,6 +7,24 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformId model_uniform {"model"};
+
+    // material is drawn as default one until its shader is compiled and linked,
+    // returns null if there is no linked shader to draw with
+    ShaderProgram* getShader(const Assets& assets, ShaderPass pass, ModelShader model, const ms::Material*& material) {
+        // variant is not stored yet while compiling thread works on it
+        if (auto* shader = assets.shaders.find(pass, model, material->getShaderIndex()); shader && shader->isReady()) {
+            return shader;
+        }
+
+        material = assets.materials.at("default").get();
+
+        auto* fallback = assets.shaders.find(pass, model, material->getShaderIndex());
+        return fallback && fallback->isReady() ? fallback : nullptr;
+    }
+}
+
 MeshInstance::MeshInstance(std::shared_ptr<AbstractMesh> _mesh, const std::shared_ptr<ms::Material>& _material) noexcept
     : mesh {std::move(_mesh)}
     , material {_material} {
@@ -33,28 +51,9 @@ void MeshInstance::draw(Context& ctx,
 
     // iterates over material layers
     for (const auto& [index, mat] : material) {
-        if (mat->getBlending() != blending) {
-            continue;
+        if (mat->getBlending() == blending) {
+            drawLayer(ctx, assets, pass, model, model_matrix, index, uniform_setter);
         }
-
-        // sets state for material
-        material.setMaterialState(ctx, index, pass);
-
-        // gets required shader from storage
-        auto& shader = assets.shaders.get(pass, model, mat->getShaderIndex());
-
-        // updates model/material uniforms
-        shader << UniformValue {"model", model_matrix}
-               << *mat;
-
-        // sets custom pass-dependent uniforms
-        uniform_setter(shader);
-
-        shader.use();
-
-        const auto draw_mode = mat->contains(ms::Property::TessellationFactor) ? DrawMode::Patches : mesh->getDrawMode();
-
-        mesh->draw(draw_mode);
     }
 }
 
@@ -72,27 +71,73 @@ void MeshInstance::draw_instanced(Context& ctx,
 
     // iterates over material layers
     for (const auto& [index, mat] : material) {
-        if (mat->getBlending() != blending) {
-            continue;
+        if (mat->getBlending() == blending) {
+            drawLayerInstanced(ctx, assets, pass, model, model_matrix, index, uniform_setter, count);
         }
+    }
+}
 
-        // sets state for material
-        material.setMaterialState(ctx, index, pass);
+void MeshInstance::drawLayer(Context& ctx,
+                             const Assets& assets,
+                             ShaderPass pass,
+                             ModelShader model,
+                             const glm::mat4& model_matrix,
+                             uint64_t layer,
+                             const UniformSetter& uniform_setter) {
+    const auto* mat = &material[layer];
+
+    // sets state for material
+    material.setMaterialState(ctx, layer, pass);
+
+    // gets required shader from storage
+    auto* shader = getShader(assets, pass, model, mat);
+    if (!shader) {
+        return;
+    }
 
-        // gets required shader from storage
-        auto& shader = assets.shaders.get(pass, model, mat->getShaderIndex());
+    // updates model/material uniforms
+    shader->setUniform(model_uniform, model_matrix)
+          << *mat;
 
-        // updates model/material uniforms
-        shader << UniformValue {"model", model_matrix}
-               << *mat;
+    // sets custom pass-dependent uniforms
+    uniform_setter(*shader);
 
-        // sets custom pass-dependent uniforms
-        uniform_setter(shader);
+    shader->use();
 
-        shader.use();
+    const auto draw_mode = mat->contains(ms::Property::TessellationFactor) ? DrawMode::Patches : mesh->getDrawMode();
 
-        const auto draw_mode = mat->contains(ms::Property::TessellationFactor) ? DrawMode::Patches : mesh->getDrawMode();
+    mesh->draw(draw_mode);
+}
 
-        mesh->draw_instanced(draw_mode, count);
+void MeshInstance::drawLayerInstanced(Context& ctx,
+                                      const Assets& assets,
+                                      ShaderPass pass,
+                                      ModelShader model,
+                                      const glm::mat4& model_matrix,
+                                      uint64_t layer,
+                                      const UniformSetter& uniform_setter,
+                                      uint32_t count) {
+    const auto* mat = &material[layer];
+
+    // sets state for material
+    material.setMaterialState(ctx, layer, pass);
+
+    // gets required shader from storage
+    auto* shader = getShader(assets, pass, model, mat);
+    if (!shader) {
+        return;
     }
+
+    // updates model/material uniforms
+    shader->setUniform(model_uniform, model_matrix)
+          << *mat;
+
+    // sets custom pass-dependent uniforms
+    uniform_setter(*shader);
+
+    shader->use();
+
+    const auto draw_mode = mat->contains(ms::Property::TessellationFactor) ? DrawMode::Patches : mesh->getDrawMode();
+
+    mesh->draw_instanced(draw_mode, count);
 }
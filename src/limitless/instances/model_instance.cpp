@@ -3,6 +3,7 @@
 #include <limitless/pipeline/shader_pass_types.hpp>
 #include <limitless/models/model.hpp>
 #include <limitless/models/elementary_model.hpp>
+#include <limitless/pipeline/render_queue.hpp>
 
 using namespace Limitless;
 
@@ -89,6 +90,26 @@ void ModelInstance::draw(Context& ctx, const Assets& assets, ShaderPass pass, ms
     }
 }
 
+void ModelInstance::collect(RenderQueue& queue) {
+    if (hidden) {
+        return;
+    }
+
+    for (auto& [name, mesh] : meshes) {
+        if (mesh.isHidden()) {
+            continue;
+        }
+
+        for (const auto& [index, material] : mesh.getMaterial()) {
+            queue.add(*this, mesh, index, *material);
+        }
+    }
+}
+
+void ModelInstance::drawItem(Context& ctx, const Assets& assets, ShaderPass pass, const DrawItem& item, const UniformSetter& uniform_setter) {
+    item.mesh->drawLayer(ctx, assets, pass, shader_type, model_matrix, item.layer, uniform_setter);
+}
+
 MeshInstance& ModelInstance::operator[](const std::string& mesh) {
     return meshes.at(mesh);
 }
@@ -98,6 +119,5 @@ ModelInstance* ModelInstance::clone() noexcept {
 }
 
 void ModelInstance::calculateBoundingBox() noexcept {
-    bounding_box.center = glm::vec4{position, 1.0f} + glm::vec4{model->getBoundingBox().center, 1.0f} * model_matrix;
-    bounding_box.size = glm::vec4{model->getBoundingBox().size, 1.0f} * model_matrix;
+    bounding_box = transformBoundingBox(model->getBoundingBox(), model_matrix);
 }
@@ -10,22 +10,11 @@ using namespace Limitless;
 
 constexpr auto skeletal_buffer_name = "bone_buffer";
 
-void SkeletalInstance::initializeBuffer() {
-    BufferBuilder builder;
-    bone_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
-            .setUsage(Buffer::Usage::DynamicDraw)
-            .setAccess(Buffer::MutableAccess::WriteOrphaning)
-            .setData(bone_transform.data())
-            .setDataSize(bone_transform.size() * sizeof(glm::mat4))
-            .build();
-}
-
 SkeletalInstance::SkeletalInstance(std::shared_ptr<AbstractModel> m, const glm::vec3& position)
     : ModelInstance(ModelShader::Skeletal, std::move(m), position) {
     auto& skeletal = dynamic_cast<SkeletalModel&>(*model);
 
     bone_transform.resize(skeletal.getBones().size(), glm::mat4(1.0f));
-    initializeBuffer();
 }
 
 SkeletalInstance::SkeletalInstance(Lighting *lighting, std::shared_ptr<AbstractModel> m, const glm::vec3& position)
@@ -33,7 +22,6 @@ SkeletalInstance::SkeletalInstance(Lighting *lighting, std::shared_ptr<AbstractM
     auto& skeletal = dynamic_cast<SkeletalModel&>(*model);
 
     bone_transform.resize(skeletal.getBones().size(), glm::mat4(1.0f));
-    initializeBuffer();
 }
 
 const AnimationNode* SkeletalInstance::findAnimationNode(const Bone& bone) const noexcept {
@@ -68,16 +56,27 @@ void SkeletalInstance::draw(Context& ctx, const Assets& assets, ShaderPass pass,
         return;
     }
 
-    calculateModelMatrix();
-
-    bone_buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, skeletal_buffer_name));
+    bindBones(ctx);
 
     // iterates over all meshes
     for (auto& [name, mesh] : meshes) {
         mesh.draw(ctx, assets, pass, shader_type, model_matrix, blending, uniform_setter);
     }
+}
+
+void SkeletalInstance::drawItem(Context& ctx, const Assets& assets, ShaderPass pass, const DrawItem& item, const UniformSetter& uniform_setter) {
+    bindBones(ctx);
+
+    ModelInstance::drawItem(ctx, assets, pass, item, uniform_setter);
+}
+
+void SkeletalInstance::bindBones(Context& ctx) {
+    // every pass of frame uses the same bones
+    if (auto& ring = ctx.getRingBuffer(); !ring.isValid(bones)) {
+        bones = ring.upload(Buffer::Type::ShaderStorage, bone_transform.data(), sizeof(glm::mat4) * bone_transform.size());
+    }
 
-    bone_buffer->fence();
+    RingBuffer::bind(bones, Buffer::Type::ShaderStorage, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, skeletal_buffer_name));
 }
 
 SkeletalInstance& SkeletalInstance::play(const std::string& name) {
@@ -166,8 +165,6 @@ void SkeletalInstance::update(Context& context, Camera& camera) {
     catch (const std::exception& e) {
         throw std::runtime_error("Wrong TPS/duration. " + std::string(e.what()));
     }
-
-    bone_buffer->mapData(bone_transform.data(), sizeof(glm::mat4) * bone_transform.size());
 }
 
 SkeletalInstance* SkeletalInstance::clone() noexcept {
@@ -11,6 +11,7 @@
 
 #include <limitless/lighting/lights.hpp>
 #include <limitless/pipeline/renderer.hpp>
+#include <limitless/util/frustum.hpp>
 #include <limitless/camera.hpp>
 #include <limitless/scene.hpp>
 
@@ -18,6 +19,12 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformId light_space_uniform {"light_space"};
+    const UniformId dir_shadows_uniform {"dir_shadows"};
+    const UniformId far_bounds_uniform {"far_bounds"};
+}
+
 namespace {
     constexpr auto DIRECTIONAL_CSM_BUFFER_NAME = "directional_shadows";
 }
@@ -63,6 +70,7 @@ CascadeShadows::CascadeShadows(Context& context, const RenderSettings& settings)
     frustums.resize(split_count);
     far_bounds.resize(split_count);
     light_space.reserve(split_count);
+    casters.resize(split_count);
 }
 
 void CascadeShadows::updateFrustums(Context& ctx, const Camera& camera) {
@@ -178,15 +186,21 @@ void CascadeShadows::updateLightMatrices(const DirectionalLight& light) {
     }
 }
 
-void CascadeShadows::draw(Instances& instances,
-                          const DirectionalLight& light,
-                          Context& ctx, const
-                          Assets& assets,
-                          const Camera& camera,
-                          [[maybe_unused]] fx::EffectRenderer* renderer) {
+void CascadeShadows::update(Context& ctx, const Camera& camera, const DirectionalLight& light, const Scene& scene) {
     updateFrustums(ctx, camera);
     updateLightMatrices(light);
 
+    for (uint32_t i = 0; i < split_count; ++i) {
+        casters[i].clear();
+        scene.query(Frustum{frustums[i].crop}, [&] (AbstractInstance& instance) {
+            if (instance.doesCastShadow()) {
+                casters[i].emplace_back(instance);
+            }
+        });
+    }
+}
+
+void CascadeShadows::draw(Context& ctx, const Assets& assets, [[maybe_unused]] fx::EffectRenderer* renderer) {
     framebuffer->bind();
 
     ctx.setViewPort(shadow_resolution);
@@ -197,14 +211,10 @@ void CascadeShadows::draw(Instances& instances,
         framebuffer->clear();
 
         const auto uniform_set = [&] (ShaderProgram& shader) {
-            shader << UniformValue{"light_space", frustums[i].crop};
+            shader.setUniform(light_space_uniform, frustums[i].crop);
         };
 
-        for (const auto& instance : instances) {
-            if (!instance.get().doesCastShadow()) {
-                continue;
-            }
-
+        for (const auto& instance : casters[i]) {
             instance.get().draw(ctx, assets, ShaderPass::DirectionalShadow, ms::Blending::Opaque, UniformSetter{uniform_set});
         }
 
@@ -217,7 +227,7 @@ void CascadeShadows::draw(Instances& instances,
 }
 
 void CascadeShadows::setUniform(ShaderProgram& shader)  const {
-    shader << UniformSampler{"dir_shadows", framebuffer->get(FramebufferAttachment::Depth).texture};
+    shader.setUniform(dir_shadows_uniform, framebuffer->get(FramebufferAttachment::Depth).texture);
 
     // TODO: ?
     glm::vec4 bounds {0.0f};
@@ -225,7 +235,7 @@ void CascadeShadows::setUniform(ShaderProgram& shader)  const {
         bounds[i] = far_bounds[i];
     }
 
-    shader << UniformValue{"far_bounds", bounds};
+    shader.setUniform(far_bounds_uniform, bounds);
 }
 
 void CascadeShadows::mapData() const {
@@ -240,6 +250,7 @@ void CascadeShadows::update(Context& ctx, const RenderSettings& settings) {
 
     frustums.resize(split_count);
     far_bounds.resize(split_count);
+    casters.resize(split_count);
 }
 
 CascadeShadows::~CascadeShadows() {
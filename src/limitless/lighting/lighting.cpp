@@ -1,7 +1,6 @@
 #include <limitless/lighting/lighting.hpp>
 
 #include <limitless/core/context.hpp>
-#include <limitless/core/buffer_builder.hpp>
 
 using namespace Limitless;
 
@@ -16,18 +15,8 @@ namespace {
     constexpr auto SCENE_LIGHTING_BUFFER_NAME = "scene_lighting";
 }
 
-void Lighting::createLightBuffer() {
-    BufferBuilder builder;
-    buffer = builder.setTarget(Buffer::Type::ShaderStorage)
-            .setUsage(Buffer::Usage::DynamicDraw)
-            .setAccess(Buffer::MutableAccess::WriteOrphaning)
-            .setDataSize(sizeof(SceneLighting))
-            .build(SCENE_LIGHTING_BUFFER_NAME, context);
-}
-
 Lighting::Lighting(Context& ctx)
     : context {ctx} {
-    createLightBuffer();
 }
 
 void Lighting::updateLightBuffer() {
@@ -37,20 +26,20 @@ void Lighting::updateLightBuffer() {
         static_cast<uint32_t>(point_lights.size()),
         directional_light.direction != glm::vec4(0.0f)
     };
-    //TODO update changed?
-    buffer->mapData(&light_info, sizeof(SceneLighting));
+
+    const auto allocation = context.getRingBuffer().upload(Buffer::Type::ShaderStorage, &light_info, sizeof(SceneLighting));
+
+    // binds light buffer to the context
+    // in case if there are many scenes or lighting classes
+    RingBuffer::bind(allocation, Buffer::Type::ShaderStorage, context.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SCENE_LIGHTING_BUFFER_NAME));
 }
 
 void Lighting::update() {
     // maps point lights buffer
     point_lights.update();
 
-    // maps global scene light buffer
+    // uploads global scene light data for this frame
     updateLightBuffer();
-
-    // binds light buffer to the context
-    // in case if there are many scenes or lighting classes
-    buffer->bindBase(context.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, SCENE_LIGHTING_BUFFER_NAME));
 }
 
 template<typename T>
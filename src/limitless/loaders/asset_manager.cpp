@@ -49,7 +49,14 @@ bool AssetManager::isDone() {
         }
     }
 
-    return std::all_of(model_futures.begin(), model_futures.end(), [] (auto& post) { return post.future.wait_for(0ms) == std::future_status::ready; });
+    const auto done = std::all_of(model_futures.begin(), model_futures.end(), [] (auto& post) { return post.future.wait_for(0ms) == std::future_status::ready; });
+
+    // finished tasks are waited on GPU before their assets are used by this context
+    if (done) {
+        pool.synchronize();
+    }
+
+    return done;
 }
 
 void AssetManager::wait() {
@@ -60,6 +67,11 @@ void AssetManager::wait() {
 
     for (auto& [future, addition] : model_futures) {
         future.wait();
+    }
+
+    pool.synchronize();
+
+    for (auto& [future, addition] : model_futures) {
         addition(future);
     }
 
@@ -73,6 +85,7 @@ void AssetManager::doDelayedJob() {
         auto& [future, addition] = *it;
 
         if (future.wait_for(0ms) == std::future_status::ready) {
+            pool.synchronize();
             addition(future);
             it = model_futures.erase(it);
         } else {
@@ -143,9 +143,15 @@ std::shared_ptr<AbstractMesh> ModelLoader::loadMesh(
     auto indices = loadIndices<T1>(m);
     auto weights = loadBoneWeights(m, bones, bone_map, flags);
 
-    auto mesh = bone_map.empty() ?
-        std::shared_ptr<AbstractMesh>(new IndexedMesh<T, T1>(std::move(vertices), std::move(indices), std::move(name), MeshDataType::Static, DrawMode::Triangles)) :
-        std::shared_ptr<AbstractMesh>(new SkinnedMesh<T, T1>(std::move(vertices), std::move(indices), std::move(weights), std::move(name), MeshDataType::Static, DrawMode::Triangles));
+    std::shared_ptr<AbstractMesh> mesh;
+    if (!bone_map.empty()) {
+        mesh = std::make_shared<SkinnedMesh<T, T1>>(std::move(vertices), std::move(indices), std::move(weights), std::move(name), MeshDataType::Static, DrawMode::Triangles);
+    } else if constexpr (std::is_same_v<T, VertexNormalTangent> && std::is_same_v<T1, GLuint>) {
+        // static meshes share buffers of assets pool
+        mesh = std::make_shared<IndexedMesh<T, T1>>(std::move(vertices), std::move(indices), std::move(name), DrawMode::Triangles, assets.geometry);
+    } else {
+        mesh = std::make_shared<IndexedMesh<T, T1>>(std::move(vertices), std::move(indices), std::move(name), MeshDataType::Static, DrawMode::Triangles);
+    }
 
     assets.meshes.add(mesh->getName(), mesh);
 
@@ -37,9 +37,15 @@ std::function<std::shared_ptr<AbstractMesh>()> ThreadedModelLoader::loadMesh(
             return asset_ptr.meshes[name];
         }
 
-        auto mesh = !skinned ?
-                    std::shared_ptr<AbstractMesh>(new IndexedMesh<V, I>(std::move(vertices), std::move(indices), std::move(name), MeshDataType::Static, DrawMode::Triangles)) :
-                    std::shared_ptr<AbstractMesh>(new SkinnedMesh<V, I>(std::move(vertices), std::move(indices), std::move(weights), std::move(name), MeshDataType::Static, DrawMode::Triangles));
+        std::shared_ptr<AbstractMesh> mesh;
+        if (skinned) {
+            mesh = std::make_shared<SkinnedMesh<V, I>>(std::move(vertices), std::move(indices), std::move(weights), std::move(name), MeshDataType::Static, DrawMode::Triangles);
+        } else if constexpr (std::is_same_v<V, VertexNormalTangent> && std::is_same_v<I, GLuint>) {
+            // static meshes share buffers of assets pool
+            mesh = std::make_shared<IndexedMesh<V, I>>(std::move(vertices), std::move(indices), std::move(name), DrawMode::Triangles, asset_ptr.geometry);
+        } else {
+            mesh = std::make_shared<IndexedMesh<V, I>>(std::move(vertices), std::move(indices), std::move(name), MeshDataType::Static, DrawMode::Triangles);
+        }
 
         asset_ptr.meshes.add(mesh->getName(), mesh);
 
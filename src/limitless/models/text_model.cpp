@@ -19,11 +19,7 @@ void TextModel::initialize(size_t count) {
     buffer = builder .setTarget(Buffer::Type::Array)
                      .setData(vertices.empty() ? nullptr : vertices.data())
                      .setDataSize(count * sizeof(TextVertex))
-                     .setUsage(Buffer::Usage::DynamicDraw)
-                     .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                     .build();
-
-    vertex_array << std::pair<TextVertex, Buffer&>(TextVertex{}, *buffer);
+                     .buildTriple();
 }
 
 void TextModel::update(std::vector<TextVertex>&& _vertices) {
@@ -41,7 +37,11 @@ void TextModel::draw() const {
         return;
     }
 
+    auto& vertex_array = VertexArray::getShared({&getVertexFormat(TextVertex{})});
     vertex_array.bind();
+    vertex_array.setVertexBuffer(0, *buffer);
+
+    glDrawArrays(GL_TRIANGLES, static_cast<GLint>(buffer->getOffset() / sizeof(TextVertex)), vertices.size());
 
-    glDrawArrays(GL_TRIANGLES, 0, vertices.size());
-}
\ No newline at end of file
+    buffer->fence();
+}
@@ -2,7 +2,6 @@
 
 #include <limitless/core/context_initializer.hpp>
 #include <limitless/core/bindless_texture.hpp>
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/core/texture.hpp>
 #include <cstring>
 
@@ -19,7 +18,9 @@ void Limitless::ms::swap(Material& lhs, Material& rhs) noexcept {
     swap(lhs.name, rhs.name);
     swap(lhs.shader_index, rhs.shader_index);
     swap(lhs.model_shaders, rhs.model_shaders);
-    swap(lhs.material_buffer, rhs.material_buffer);
+    swap(lhs.block, rhs.block);
+    swap(lhs.animated, rhs.animated);
+    swap(lhs.textured, rhs.textured);
     swap(lhs.uniform_offsets, rhs.uniform_offsets);
     swap(lhs.uniforms, rhs.uniforms);
     swap(lhs.vertex_snippet, rhs.vertex_snippet);
@@ -92,6 +93,9 @@ Material::Material(const Material& material)
     , name {material.name}
     , shader_index {material.shader_index}
     , model_shaders {material.model_shaders}
+    , block {std::make_unique<MaterialBlock>(material.block->getStorage())}
+    , animated {material.animated}
+    , textured {material.textured}
     , uniform_offsets {material.uniform_offsets}
     , vertex_snippet {material.vertex_snippet}
     , fragment_snippet {material.fragment_snippet}
@@ -107,24 +111,28 @@ Material::Material(const Material& material)
         uniforms.emplace(name, uniform->clone());
     }
 
-    // TODO: empty copy function
-    // copy of opengl buffer
-    BufferBuilder builder;
-    material_buffer = builder.setTarget(Buffer::Type::Uniform)
-                             .setUsage(Buffer::Usage::DynamicDraw)
-                             .setAccess(Buffer::MutableAccess::WriteOrphaning)
-                             .setDataSize(material.material_buffer->getSize())
-                             .build();
+    // copy gets its own block in the same storage
+    observe();
+}
+
+void Material::observe() {
+    for (const auto& [type, property] : properties) {
+        property->setObserver(block.get());
+    }
+
+    for (const auto& [name, uniform] : uniforms) {
+        uniform->setObserver(block.get());
+    }
 }
 
 template<typename V>
-void Material::map(std::vector<std::byte>& block, const Uniform& uniform) const {
+void Material::map(std::byte* block, const Uniform& uniform) const {
     const auto& uni = static_cast<const UniformValue<V>&>(uniform);
     const auto offset = uniform_offsets.at(uniform.getName());
-    std::memcpy(block.data() + offset, &uni.getValue(), sizeof(V));
+    std::memcpy(block + offset, &uni.getValue(), sizeof(V));
 }
 
-void Material::map(std::vector<std::byte>& block, Uniform& uniform) {
+void Material::map(std::byte* block, Uniform& uniform) {
     switch (uniform.getType()) {
         case UniformType::Value:
             switch (uniform.getValueType()) {
@@ -160,7 +168,7 @@ void Material::map(std::vector<std::byte>& block, Uniform& uniform) {
                 const auto offset = uniform_offsets.at(uniform.getName());
                 auto& bindless_texture = static_cast<BindlessTexture&>(uni.getSampler()->getExtensionTexture());
                 bindless_texture.makeResident();
-                std::memcpy(block.data() + offset, &bindless_texture.getHandle(), sizeof(uint64_t));
+                std::memcpy(block + offset, &bindless_texture.getHandle(), sizeof(uint64_t));
             }
             break;
         case UniformType::Time: {
@@ -173,35 +181,23 @@ void Material::map(std::vector<std::byte>& block, Uniform& uniform) {
 }
 
 void Material::map() {
-    std::vector<std::byte> block(material_buffer->getSize());
+    auto* data = block->write();
 
     for (const auto& [property, uniform] : properties) {
-        map(block, *uniform);
+        map(data, *uniform);
     }
 
     for (const auto& [name, uniform] : uniforms) {
-        map(block, *uniform);
+        map(data, *uniform);
     }
 
-    material_buffer->mapData(block.data(), block.size());
+    block->commit();
 }
 
 void Material::update() {
-    const auto properties_changed = std::any_of(properties.begin(), properties.end(), [] (auto& property) { return property.second->getChanged(); });
-    const auto uniforms_changed = std::any_of(uniforms.begin(), uniforms.end(), [] (auto& uniform) { return uniform.second->getChanged(); });
-
-    if (!properties_changed && !uniforms_changed) {
-        return;
-    }
-
-    map();
-
-    for (const auto& [type, uniform] : properties) {
-        uniform->getChanged() = false;
-    }
-
-    for (const auto& [name, uniform] : uniforms) {
-        uniform->getChanged() = false;
+    // uniforms report their changes to block, so nothing is checked per draw
+    if (block->isChanged() || animated) {
+        map();
     }
 }
 
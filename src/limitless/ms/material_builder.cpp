@@ -1,10 +1,10 @@
 #include <limitless/ms/material_builder.hpp>
 
-#include <limitless/core/buffer_builder.hpp>
 #include <limitless/ms/material_compiler.hpp>
 #include <limitless/core/shader_program.hpp>
 #include <limitless/assets.hpp>
 #include <limitless/core/context_initializer.hpp>
+#include <limitless/core/context_state.hpp>
 
 using namespace Limitless::ms;
 
@@ -56,13 +56,22 @@ void MaterialBuilder::initializeMaterialBuffer() {
         offset = 4;
     }
 
-    BufferBuilder builder;
-    material->material_buffer = builder
-            .setTarget(Buffer::Type::Uniform)
-            .setUsage(Buffer::Usage::DynamicDraw)
-            .setAccess(Buffer::MutableAccess::WriteOrphaning)
-            .setDataSize(sizeof(std::byte) * offset)
-            .build();
+    auto* state = ContextState::getState(glfwGetCurrentContext());
+    if (!state) {
+        throw material_builder_error("No current context to build material");
+    }
+
+    // materials of the context with blocks of the same size share one buffer
+    material->block = std::make_unique<MaterialBlock>(state->getMaterialStorage(offset));
+    material->observe();
+
+    material->animated = std::any_of(material->uniforms.begin(), material->uniforms.end(), [] (const auto& uniform) {
+        return uniform.second->getType() == UniformType::Time;
+    });
+
+    const auto is_sampler = [] (const auto& uniform) { return uniform.second->getType() == UniformType::Sampler; };
+    material->textured = std::any_of(material->properties.begin(), material->properties.end(), is_sampler) ||
+                         std::any_of(material->uniforms.begin(), material->uniforms.end(), is_sampler);
 }
 
 MaterialBuilder& MaterialBuilder::set(decltype(material->properties)&& properties) {
@@ -238,21 +247,13 @@ MaterialBuilder& MaterialBuilder::removeUniform(const std::string& name) {
 void MaterialBuilder::setMaterialIndex() {
     std::unique_lock lock(mutex);
 
-    material->shader_index = next_shader_index++;
-//    if (!material->uniforms.empty() || !material->vertex_snippet.empty() || !material->fragment_snippet.empty() || !material->tessellation_snippet.empty() || !material->global_snippet.empty()) {
-//        // it is custom material; makes index unique
-//        material->shader_index = next_shader_index++;
-//    } else {
-//        const auto material_type = getMaterialType();
-//        if (auto found = unique_materials.find(material_type); found != unique_materials.end()) {
-//            // already exist
-//            material->shader_index = found->second;
-//        } else {
-//            // new one
-//            material->shader_index = next_shader_index++;
-//            unique_materials.emplace(material_type, material->shader_index);
-//        }
-//    }
+    // materials that differ only in values of properties and uniforms compile to the same shaders
+    const auto [found, inserted] = unique_materials.emplace(getMaterialType(), next_shader_index);
+    if (inserted) {
+        ++next_shader_index;
+    }
+
+    material->shader_index = found->second;
 }
 
 void MaterialBuilder::checkRequirements() {
@@ -295,14 +296,27 @@ std::shared_ptr<Material> MaterialBuilder::build() {
     return new_material;
 }
 
-UniqueMaterial MaterialBuilder::getMaterialType() const noexcept {
+UniqueMaterial MaterialBuilder::getMaterialType() const {
     std::set<Property> props;
 
     std::for_each(material->properties.begin(), material->properties.end(), [&] (auto& prop) {
         props.emplace(prop.first);
     });
 
-    return { std::move(props), material->shading };
+    std::string uniforms;
+    for (const auto& [name, uniform] : material->uniforms) {
+        uniforms.append(getUniformDeclaration(*uniform));
+    }
+
+    return {
+        std::move(props),
+        material->shading,
+        material->vertex_snippet,
+        material->fragment_snippet,
+        material->global_snippet,
+        material->tessellation_snippet,
+        std::move(uniforms)
+    };
 }
 
 MaterialBuilder& MaterialBuilder::setModelShaders(const Limitless::ModelShaders& shaders) noexcept {
@@ -3,13 +3,60 @@
 #include <limitless/pipeline/render_settings.hpp>
 #include <limitless/ms/material.hpp>
 #include <limitless/assets.hpp>
+#include <algorithm>
 
 using namespace Limitless::ms;
+using namespace Limitless;
+
+namespace {
+    // every define that render settings can set
+    const std::vector<std::string> settings_define_names = {
+        "PHONG_MODEL",
+        "BLINN_PHONG_MODEL",
+        "NORMAL_MAPPING",
+        "DIRECTIONAL_CSM",
+        "DIRECTIONAL_SPLIT_COUNT",
+        "DIRECTIONAL_PFC"
+    };
+
+    // defines with values of render settings, values are empty for flags
+    std::vector<std::pair<std::string, std::string>> getSettingsDefines(const RenderSettings& settings) {
+        std::vector<std::pair<std::string, std::string>> defines;
+
+        // sets shading model
+        switch (settings.shading_model) {
+            case ShadingModel::Phong:
+                defines.emplace_back("PHONG_MODEL", "");
+                break;
+            case ShadingModel::BlinnPhong:
+                defines.emplace_back("BLINN_PHONG_MODEL", "");
+                break;
+        }
+
+        // sets normal mapping
+        if (settings.normal_mapping) {
+            defines.emplace_back("NORMAL_MAPPING", "");
+        }
+
+        if (settings.directional_csm) {
+            defines.emplace_back("DIRECTIONAL_CSM", "");
+
+            defines.emplace_back("DIRECTIONAL_SPLIT_COUNT", std::to_string(settings.directional_split_count));
+
+            if (settings.directional_pcf) {
+                defines.emplace_back("DIRECTIONAL_PFC", "");
+            }
+        }
+
+        return defines;
+    }
+}
 
 MaterialCompiler::MaterialCompiler(Context& context, Assets& _assets, const RenderSettings& _settings) noexcept
     :  ShaderCompiler {context}
     , assets {_assets}
     , render_settings {_settings} {
+    background_link = true;
 }
 
 std::string MaterialCompiler::getMaterialDefines(const Material& material) noexcept {
@@ -67,9 +114,7 @@ std::string MaterialCompiler::getMaterialDefines(const Material& material) noexc
             break;
     }
 
-    if ((material.contains(Property::MetallicTexture) || material.contains(Property::RoughnessTexture) ||
-         material.contains(Property::Metallic) || material.contains(Property::Roughness)) &&
-        render_settings.physically_based_render) {
+    if (hasPBRProperties(material) && render_settings.physically_based_render) {
         property_defines.append("#define PBR\n");
     }
 
@@ -94,6 +139,9 @@ std::string MaterialCompiler::getModelDefines(const ModelShader& type) {
         case ModelShader::Effect:
             defines.append("#define EFFECT_MODEL\n");
             break;
+        case ModelShader::Batched:
+            defines.append("#define BATCHED_MODEL\n");
+            break;
     }
     return defines;
 }
@@ -110,6 +158,31 @@ std::string MaterialCompiler::getCustomMaterialScalarUniforms(const Material& ma
     return uniforms;
 }
 
+std::string MaterialCompiler::getMaterialBatchPadding(const Material& material) {
+    // std140 array stride of the block is its size rounded up to 16 and has to match stride of storage
+    const auto& storage = *material.getBlock().getStorage();
+    const auto size = material.getUniformOffsets().empty() ? 0 : (storage.getBlockSize() + 15) / 16 * 16;
+    const auto padding = (storage.getStride() - size) / 16;
+
+    return padding ? "vec4 material_padding[" + std::to_string(padding) + "];\n" : "";
+}
+
+std::string MaterialCompiler::getMaterialBatchMembers(const Material& material) {
+    std::vector<std::string> names;
+    for (const auto& [name, offset] : material.getUniformOffsets()) {
+        names.emplace_back(name);
+    }
+
+    // sorted to keep the same source for the same material
+    std::sort(names.begin(), names.end());
+
+    std::string members;
+    for (const auto& name : names) {
+        members.append("#define " + name + " materials[batched_material_index]." + name + '\n');
+    }
+    return members;
+}
+
 std::string MaterialCompiler::getCustomMaterialSamplerUniforms(const Material& material) noexcept {
     std::string uniforms;
     for (const auto& [name, uniform] : material.getUniforms()) {
@@ -120,40 +193,73 @@ std::string MaterialCompiler::getCustomMaterialSamplerUniforms(const Material& m
     return uniforms;
 }
 
-void MaterialCompiler::replaceRenderSettings(Shader& shader) noexcept {
-    std::string settings;
+bool MaterialCompiler::hasPBRProperties(const Material& material) noexcept {
+    return material.contains(Property::MetallicTexture) || material.contains(Property::RoughnessTexture) ||
+           material.contains(Property::Metallic) || material.contains(Property::Roughness);
+}
 
-    // sets shading model
-    switch (render_settings.shading_model) {
-        case ShadingModel::Phong:
-            settings.append("#define PHONG_MODEL\n");
-            break;
-        case ShadingModel::BlinnPhong:
-            settings.append("#define BLINN_PHONG_MODEL\n");
-            break;
-    }
+std::vector<std::string> MaterialCompiler::getWatchedDefines(const Material& material) {
+    auto defines = settings_define_names;
 
-    // sets normal mapping
-    if (render_settings.normal_mapping) {
-        settings.append("#define NORMAL_MAPPING\n");
+    // materials without these properties do not get PBR define whatever settings are
+    if (hasPBRProperties(material)) {
+        defines.emplace_back("PBR");
     }
 
-    if (render_settings.directional_csm) {
-        settings.append("#define DIRECTIONAL_CSM\n");
+    return defines;
+}
+
+std::vector<std::string> MaterialCompiler::getChangedDefines(const RenderSettings& lhs, const RenderSettings& rhs) {
+    const auto lhs_defines = getSettingsDefines(lhs);
+    const auto rhs_defines = getSettingsDefines(rhs);
+
+    const auto find = [] (const auto& defines, const std::string& name) {
+        return std::find_if(defines.begin(), defines.end(), [&] (const auto& define) { return define.first == name; });
+    };
+
+    std::vector<std::string> changed;
+    for (const auto& name : settings_define_names) {
+        const auto lhs_define = find(lhs_defines, name);
+        const auto rhs_define = find(rhs_defines, name);
 
-        settings.append("#define DIRECTIONAL_SPLIT_COUNT " + std::to_string(render_settings.directional_split_count) + '\n');
+        const auto lhs_defined = lhs_define != lhs_defines.end();
+        const auto rhs_defined = rhs_define != rhs_defines.end();
 
-        if (render_settings.directional_pcf) {
-            settings.append("#define DIRECTIONAL_PFC\n");
+        if (lhs_defined != rhs_defined || (lhs_defined && lhs_define->second != rhs_define->second)) {
+            changed.emplace_back(name);
         }
     }
 
+    if (lhs.physically_based_render != rhs.physically_based_render) {
+        changed.emplace_back("PBR");
+    }
+
+    return changed;
+}
+
+void MaterialCompiler::replaceRenderSettings(Shader& shader) noexcept {
+    std::string settings;
+
+    for (const auto& [name, value] : getSettingsDefines(render_settings)) {
+        settings.append("#define " + name + (value.empty() ? "" : " " + value) + '\n');
+    }
+
     shader.replaceKey("Limitless::Settings", settings);
 }
 
 void MaterialCompiler::replaceMaterialSettings(Shader& shader, const Material& material, ModelShader model_shader) noexcept {
     shader.replaceKey("Limitless::MaterialType", getMaterialDefines(material));
-    shader.replaceKey("Limitless::ModelType", getModelDefines(model_shader));
+
+    if (model_shader == ModelShader::Batched) {
+        const auto batch_size = material.getBlock().getStorage()->getBatchSize();
+        shader.replaceKey("Limitless::ModelType", getModelDefines(model_shader) + "#define MATERIAL_BATCH_SIZE " + std::to_string(batch_size) + '\n');
+        shader.replaceKey("Limitless::MaterialBatchPadding", getMaterialBatchPadding(material));
+        shader.replaceKey("Limitless::MaterialBatchMembers", getMaterialBatchMembers(material));
+    } else {
+        shader.replaceKey("Limitless::ModelType", getModelDefines(model_shader));
+        shader.replaceKey("Limitless::MaterialBatchPadding", "");
+        shader.replaceKey("Limitless::MaterialBatchMembers", "");
+    }
 
     shader.replaceKey("Limitless::CustomMaterialVertexCode", material.getVertexSnippet());
     shader.replaceKey("Limitless::CustomMaterialFragmentCode", material.getFragmentSnippet());
@@ -169,6 +275,8 @@ void MaterialCompiler::compile(const Material& material, ShaderPass pass_shader,
         replaceRenderSettings(shader);
     };
 
+    watched_defines = getWatchedDefines(material);
+
     if (material.contains(Property::TessellationFactor)) {
         *this << Shader { assets.getShaderDir() / "tesselation" / "tesselation.tcs", Shader::Type::TessControl, props }
               << Shader { assets.getShaderDir() / "tesselation" / "tesselation.tes", Shader::Type::TessEval, props };
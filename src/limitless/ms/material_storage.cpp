@@ -0,0 +1,113 @@
+#include <limitless/ms/material_storage.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace Limitless::ms;
+using namespace Limitless;
+
+namespace {
+    constexpr uint32_t initial_slot_count = 64;
+}
+
+MaterialStorage::MaterialStorage(size_t _block_size)
+    : block_size {_block_size} {
+    const auto alignment = static_cast<size_t>(std::max(ContextInitializer::limits.uniform_buffer_alignment, 16));
+    stride = (block_size + alignment - 1) / alignment * alignment;
+
+    const auto max_size = static_cast<size_t>(ContextInitializer::limits.uniform_block_max_size);
+    batch_size = static_cast<uint32_t>(std::max(max_size / stride, size_t{1}));
+}
+
+uint32_t MaterialStorage::allocate() {
+    std::unique_lock lock(mutex);
+
+    if (!free_slots.empty()) {
+        const auto slot = free_slots.back();
+        free_slots.pop_back();
+        return slot;
+    }
+
+    // client copy keeps one batch of blocks past the last slot, so range bound for any slot stays inside the buffer
+    const auto slot = slot_count++;
+    if ((slot_count + batch_size) * stride > data.size()) {
+        data.resize((std::max(slot_count * 2, initial_slot_count) + batch_size) * stride);
+    }
+
+    return slot;
+}
+
+void MaterialStorage::free(uint32_t slot) noexcept {
+    std::unique_lock lock(mutex);
+    free_slots.emplace_back(slot);
+}
+
+uint32_t MaterialStorage::getSlotCount() const {
+    std::unique_lock lock(mutex);
+    return slot_count - static_cast<uint32_t>(free_slots.size());
+}
+
+void MaterialStorage::write(uint32_t slot, const std::byte* block) {
+    std::unique_lock lock(mutex);
+
+    const auto offset = slot * stride;
+    std::memcpy(data.data() + offset, block, block_size);
+
+    if (dirty_begin == dirty_end) {
+        dirty_begin = offset;
+        dirty_end = offset + block_size;
+    } else {
+        dirty_begin = std::min(dirty_begin, offset);
+        dirty_end = std::max(dirty_end, offset + block_size);
+    }
+}
+
+// buffer grows with client copy and is uploaded whole then
+void MaterialStorage::upload() {
+    if (!buffer || buffer->getSize() < data.size()) {
+        BufferBuilder builder;
+        buffer = builder.setTarget(Buffer::Type::Uniform)
+                        .setUsage(Buffer::Usage::DynamicDraw)
+                        .setAccess(Buffer::MutableAccess::None)
+                        .setData(data.data())
+                        .setDataSize(data.size())
+                        .build();
+    } else if (dirty_begin != dirty_end) {
+        buffer->bufferSubData(static_cast<GLintptr>(dirty_begin), dirty_end - dirty_begin, data.data() + dirty_begin);
+    }
+
+    dirty_begin = dirty_end = 0;
+}
+
+void MaterialStorage::bind(uint32_t slot, GLuint binding_point) {
+    std::unique_lock lock(mutex);
+
+    upload();
+
+    buffer->bindBufferRange(binding_point, static_cast<GLintptr>(slot * stride), static_cast<GLsizeiptr>(block_size));
+}
+
+void MaterialStorage::bindBatch(uint32_t slot, GLuint binding_point) {
+    std::unique_lock lock(mutex);
+
+    upload();
+
+    buffer->bindBufferRange(binding_point, static_cast<GLintptr>(slot * stride), static_cast<GLsizeiptr>(batch_size * stride));
+}
+
+MaterialBlock::MaterialBlock(std::shared_ptr<MaterialStorage> _storage)
+    : storage {std::move(_storage)}
+    , slot {storage->allocate()}
+    , data(storage->getBlockSize()) {
+}
+
+MaterialBlock::~MaterialBlock() {
+    storage->free(slot);
+}
+
+std::byte* MaterialBlock::write() noexcept {
+    changed = false;
+    return data.data();
+}
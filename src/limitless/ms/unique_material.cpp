@@ -3,5 +3,6 @@
 #include <tuple>
 
 bool Limitless::ms::operator<(const UniqueMaterial& lhs, const UniqueMaterial& rhs) noexcept {
-    return std::tie(lhs.properties, lhs.shading) < std::tie(rhs.properties, rhs.shading);
-}
\ No newline at end of file
+    return std::tie(lhs.properties, lhs.shading, lhs.uniforms, lhs.vertex_snippet, lhs.fragment_snippet, lhs.global_snippet, lhs.tessellation_snippet) <
+           std::tie(rhs.properties, rhs.shading, rhs.uniforms, rhs.vertex_snippet, rhs.fragment_snippet, rhs.global_snippet, rhs.tessellation_snippet);
+}
@@ -0,0 +1,328 @@
+#include <limitless/pipeline/batch_renderer.hpp>
+
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/instances/mesh_instance.hpp>
+#include <limitless/models/indexed_mesh.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/util/frustum.hpp>
+#include <limitless/assets.hpp>
+#include <limitless/camera.hpp>
+#include <algorithm>
+#include <numeric>
+
+using namespace Limitless;
+
+namespace {
+    // the only static geometry format models are loaded with
+    using BatchedMesh = IndexedMesh<VertexNormalTangent, GLuint>;
+
+    constexpr auto BATCH_BUFFER_NAME = "batch_buffer";
+    constexpr auto MATERIAL_BUFFER_NAME = "material_buffer";
+    constexpr GLuint draw_id_location = 6;
+    constexpr size_t initial_draw_count = 1024;
+
+    // draw ids are sourced from second binding, one per instance
+    const VertexFormat& getDrawIdFormat() noexcept {
+        static const VertexFormat format {{
+            { draw_id_location, 1, GL_INT, GL_FALSE, 0 },
+        }, sizeof(GLuint), 1 };
+        return format;
+    }
+
+    // one program and one bound range of blocks serve draws of both materials
+    bool isCompatible(const ms::Material& lhs, const ms::Material& rhs) noexcept {
+        return lhs.getShaderIndex() == rhs.getShaderIndex() &&
+               lhs.getBlock().getStorage() == rhs.getBlock().getStorage() &&
+               lhs.getBlending() == rhs.getBlending() &&
+               lhs.getTwoSided() == rhs.getTwoSided() &&
+               !lhs.isTextured() && !rhs.isTextured();
+    }
+}
+
+BatchRenderer::BatchRenderer(bool gpu_culling, bool occlusion_culling) {
+    if (gpu_culling && GpuCulling::isSupported()) {
+        culling = std::make_unique<GpuCulling>(occlusion_culling);
+    }
+}
+
+BatchRenderer::~BatchRenderer() {
+    if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx && draw_buffer) {
+        ctx->getIndexedBuffers().remove(BATCH_BUFFER_NAME, draw_buffer);
+    }
+}
+
+bool BatchRenderer::isSupported() noexcept {
+    return ContextInitializer::isExtensionSupported("GL_ARB_multi_draw_indirect") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_base_instance") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_shader_storage_buffer_object");
+}
+
+bool BatchRenderer::isBatchable(const DrawItem& item, const Assets& assets, ShaderPass pass) {
+    // skeletal and instanced models have own data per draw
+    if (item.instance->getShaderType() != ModelShader::Model) {
+        return false;
+    }
+
+    // blending of several layers depends on their count
+    if (item.mesh->getMaterial().count() != 1) {
+        return false;
+    }
+
+    const auto& material = *item.material;
+    if (material.contains(ms::Property::TessellationFactor) || !assets.shaders.contains(pass, ModelShader::Batched, material.getShaderIndex())) {
+        return false;
+    }
+
+    // item is drawn alone with fallback shader until batched one is linked
+    auto* shader = assets.shaders.find(pass, ModelShader::Batched, material.getShaderIndex());
+    if (!shader || !shader->isReady()) {
+        return false;
+    }
+
+    const auto& mesh = item.mesh->getMesh();
+    auto found = entries.find(mesh.get());
+
+    // address can be reused by new mesh after old one is gone
+    if (found == entries.end() || found->second.mesh.lock() != mesh) {
+        const auto* indexed = dynamic_cast<const BatchedMesh*>(mesh.get());
+        const bool batchable = indexed &&
+                               indexed->getDataType() == MeshDataType::Static &&
+                               indexed->getDrawMode() == DrawMode::Triangles &&
+                               !indexed->getIndices().empty();
+
+        found = entries.insert_or_assign(mesh.get(), Entry {mesh, {}, nullptr, batchable}).first;
+        entries_added = true;
+
+        auto& entry = found->second;
+        if (batchable && indexed->getGeometry()) {
+            entry.geometry = &indexed->getGeometry();
+        } else if (batchable) {
+            if (!geometry_pool) {
+                geometry_pool = std::make_shared<GeometryPool>(getVertexFormat(VertexNormalTangent{}));
+            }
+
+            const auto& vertices = indexed->getVertices();
+            const auto& indices = indexed->getIndices();
+            entry.copy = {geometry_pool, vertices.data(), static_cast<GLuint>(vertices.size()), indices.data(), static_cast<GLuint>(indices.size())};
+            entry.geometry = &entry.copy;
+        }
+    }
+
+    return found->second.batchable;
+}
+
+const GeometryPool* BatchRenderer::getPool(const DrawItem& item) const {
+    return entries.at(item.mesh->getMesh().get()).geometry->getPool();
+}
+
+void BatchRenderer::initialize(Context& ctx) {
+    BufferBuilder builder;
+
+    command_buffer = builder.setTarget(Buffer::Type::IndirectDraw)
+                            .setUsage(Buffer::Usage::DynamicDraw)
+                            .setAccess(Buffer::MutableAccess::WriteOrphaning)
+                            .setData(nullptr)
+                            .setDataSize(sizeof(Command) * initial_draw_count)
+                            .build();
+
+    draw_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
+                         .setUsage(Buffer::Usage::DynamicDraw)
+                         .setAccess(Buffer::MutableAccess::WriteOrphaning)
+                         .setData(nullptr)
+                         .setDataSize(sizeof(Draw) * initial_draw_count)
+                         .build(BATCH_BUFFER_NAME, ctx);
+}
+
+// copies of meshes that are gone are returned to pool
+void BatchRenderer::removeExpired() {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.mesh.expired()) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    entries_added = false;
+}
+
+void BatchRenderer::upload() {
+    // draw ids are constant, so buffer only grows
+    if (!draw_id_buffer || draw_id_buffer->getSize() < draws.size() * sizeof(GLuint)) {
+        std::vector<GLuint> ids(std::max(draws.size() * 2, initial_draw_count));
+        std::iota(ids.begin(), ids.end(), 0);
+
+        BufferBuilder builder;
+        draw_id_buffer = builder.setTarget(Buffer::Type::Array)
+                                .setUsage(Buffer::Storage::Static)
+                                .setAccess(Buffer::ImmutableAccess::None)
+                                .setData(ids.data())
+                                .setDataSize(ids.size() * sizeof(GLuint))
+                                .build();
+    }
+
+    if (command_buffer->getSize() < commands.size() * sizeof(Command)) {
+        command_buffer->resize(commands.size() * sizeof(Command) * 2);
+    }
+
+    if (draw_buffer->getSize() < draws.size() * sizeof(Draw)) {
+        draw_buffer->resize(draws.size() * sizeof(Draw) * 2);
+    }
+
+    command_buffer->mapData(commands.data(), commands.size() * sizeof(Command));
+    draw_buffer->mapData(draws.data(), draws.size() * sizeof(Draw));
+}
+
+void BatchRenderer::submit(Context& ctx, const Assets& assets, ShaderPass pass, const Run& run, const UniformSetter& setter) {
+    const auto& item = *run.first;
+    const auto& material = *item.material;
+
+    // every item of run has the same single layer material
+    item.mesh->getMaterial().setMaterialState(ctx, item.layer, pass);
+
+    auto& shader = assets.shaders.get(pass, ModelShader::Batched, material.getShaderIndex());
+
+    shader << material;
+
+    setter(shader);
+
+    shader.use();
+
+    // blocks of other materials of run are remapped if changed and bound as one range with the first one
+    for (uint32_t i = 1; i < run.count; ++i) {
+        if (run.first[i].material != run.first[i - 1].material) {
+            const_cast<ms::Material&>(*run.first[i].material).update();
+        }
+    }
+    material.getBlock().getStorage()->bindBatch(run.first_slot, ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::UniformBuffer, MATERIAL_BUFFER_NAME));
+
+    draw_buffer->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, BATCH_BUFFER_NAME));
+
+    const auto& pool = *getPool(item);
+    auto& vertex_array = VertexArray::getShared({&pool.getFormat(), &getDrawIdFormat()});
+    vertex_array.bind();
+    pool.attach(vertex_array);
+    vertex_array.setVertexBuffer(1, *draw_id_buffer);
+
+    const auto* offset = reinterpret_cast<const void*>(run.first_command * sizeof(Command)); // NOLINT(performance-no-int-to-ptr)
+
+    if (!culling) {
+        command_buffer->bind();
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, static_cast<GLsizei>(run.count), sizeof(Command));
+        return;
+    }
+
+    culling->getOutput().bindAs(Buffer::Type::IndirectDraw);
+
+    // culled commands at the end of run are empty, count buffer lets to skip them
+    if (GpuCulling::isCountSupported()) {
+        culling->getCounts().bindAs(Buffer::Type::Parameter);
+        glMultiDrawElementsIndirectCountARB(GL_TRIANGLES, GL_UNSIGNED_INT, offset, run.index * sizeof(GLuint), static_cast<GLsizei>(run.count), sizeof(Command));
+    } else {
+        glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, offset, static_cast<GLsizei>(run.count), sizeof(Command));
+    }
+}
+
+void BatchRenderer::draw(Context& ctx, const Assets& assets, ShaderPass pass, const Camera& camera, RenderQueue::Bucket bucket, const UniformSetter& setter) {
+    if (bucket.empty()) {
+        return;
+    }
+
+    if (!command_buffer) {
+        initialize(ctx);
+    }
+
+    // splits bucket into runs of batchable items with compatible materials and the same pool, single items are not worth a command
+    runs.clear();
+    for (auto* it = bucket.begin(); it != bucket.end();) {
+        auto* last = it + 1;
+        auto first_slot = it->material->getBlock().getSlot();
+
+        if (isBatchable(*it, assets, pass)) {
+            // slots of run have to fit into one bound range of blocks
+            const auto batch_size = it->material->getBlock().getStorage()->getBatchSize();
+            auto last_slot = first_slot;
+
+            while (last != bucket.end() && (last->material == it->material || isCompatible(*last->material, *it->material))) {
+                const auto slot = last->material->getBlock().getSlot();
+                if (std::max(last_slot, slot) - std::min(first_slot, slot) >= batch_size) {
+                    break;
+                }
+
+                if (!isBatchable(*last, assets, pass) || getPool(*last) != getPool(*it)) {
+                    break;
+                }
+
+                first_slot = std::min(first_slot, slot);
+                last_slot = std::max(last_slot, slot);
+                ++last;
+            }
+        }
+
+        const auto count = static_cast<uint32_t>(last - it);
+        runs.push_back({it, count, 0, 0, first_slot, count > 1});
+        it = last;
+    }
+
+    if (entries_added) {
+        removeExpired();
+    }
+
+    commands.clear();
+    draws.clear();
+
+    if (culling) {
+        culling->clear();
+    }
+
+    uint32_t batch_count = 0;
+    for (auto& run : runs) {
+        if (!run.batched) {
+            continue;
+        }
+
+        run.first_command = static_cast<uint32_t>(commands.size());
+        run.index = batch_count++;
+
+        for (uint32_t i = 0; i < run.count; ++i) {
+            const auto& item = run.first[i];
+            // ranges move when pool is compacted, so they are looked up every frame
+            const auto& [vertices, indices] = entries.at(item.mesh->getMesh().get()).geometry->get();
+            const auto draw_id = static_cast<GLuint>(draws.size());
+
+            commands.push_back({indices.count, 1, indices.offset, static_cast<GLint>(vertices.offset), draw_id});
+            draws.push_back({item.instance->getModelMatrix(), item.material->getBlock().getSlot() - run.first_slot, {}});
+
+            if (culling) {
+                culling->add(item.instance->getBoundingBox(), run.index, run.first_command);
+            }
+        }
+    }
+
+    if (!commands.empty()) {
+        upload();
+
+        if (culling) {
+            culling->cull(ctx, assets, camera, *command_buffer, batch_count);
+        }
+    }
+
+    const Frustum frustum {camera.getProjection() * camera.getView()};
+
+    for (const auto& run : runs) {
+        if (run.batched) {
+            submit(ctx, assets, pass, run, setter);
+            continue;
+        }
+
+        // nothing was culled before queue when culling is done here
+        if (culling && !frustum.intersects(run.first->instance->getBoundingBox())) {
+            continue;
+        }
+
+        run.first->instance->drawItem(ctx, assets, pass, *run.first, setter);
+    }
+}
@@ -3,37 +3,31 @@
 #include <limitless/core/context.hpp>
 #include <limitless/pipeline/shader_pass_types.hpp>
 #include <limitless/ms/blending.hpp>
-#include <limitless/util/sorter.hpp>
+#include <limitless/pipeline/render_queue.hpp>
+#include <limitless/pipeline/batch_renderer.hpp>
 #include <limitless/instances/abstract_instance.hpp>
 #include <stdexcept>
 
 using namespace Limitless;
 
-ColorPass::ColorPass(RenderPass* prev, ms::Blending _blending)
+ColorPass::ColorPass(RenderPass* prev, const RenderQueue& _queue, BatchRenderer* _batches, ms::Blending _blending)
         : RenderPass(prev)
+        , queue {_queue}
+        , batches {_batches}
         , blending {_blending} {
+    if (blending == ms::Blending::MultipleOpaque || blending == ms::Blending::Text) {
+        throw std::logic_error("This type of blending cannot be used as ColorPass value");
+    }
 }
 
-void ColorPass::draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, const UniformSetter& setter) {
-    switch (blending) {
-        case ms::Blending::Opaque:
-            std::sort(instances.begin(), instances.end(), FrontToBackSorter{camera});
-            break;
-        case ms::Blending::Translucent:
-        case ms::Blending::Additive:
-        case ms::Blending::Modulate:
-            std::sort(instances.begin(), instances.end(), BackToFrontSorter{camera});
-            break;
-        case ms::Blending::MultipleOpaque:
-        case ms::Blending::Text:
-            throw std::logic_error("This type of blending cannot be used as ColorPass value");
+void ColorPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, const UniformSetter& setter) {
+    // items are already sorted by RenderQueuePass
+    if (batches) {
+        batches->draw(ctx, assets, ShaderPass::Forward, camera, queue.getBucket(blending), setter);
+        return;
     }
 
-    for (auto& instance : instances) {
-//        ctx.setPolygonMode(CullFace::FrontBack, PolygonMode::Line);
-
-        instance.get().draw(ctx, assets, ShaderPass::Forward, blending, setter);
-
-//        ctx.setPolygonMode(CullFace::FrontBack, PolygonMode::Fill);
+    for (const auto& item : queue.getBucket(blending)) {
+        item.instance->drawItem(ctx, assets, ShaderPass::Forward, item, setter);
     }
 }
@@ -0,0 +1,24 @@
+#include <limitless/pipeline/culling_pass.hpp>
+
+#include <limitless/util/frustum.hpp>
+#include <limitless/camera.hpp>
+#include <limitless/scene.hpp>
+
+using namespace Limitless;
+
+CullingPass::CullingPass(RenderPass* prev) noexcept
+    : RenderPass(prev) {
+}
+
+void CullingPass::update(Scene& scene, Instances& instances, [[maybe_unused]] Context& ctx, const Camera& camera) {
+    const Frustum frustum {camera.getProjection() * camera.getView()};
+
+    total_count = scene.size();
+
+    instances.clear();
+    scene.query(frustum, [&] (AbstractInstance& instance) {
+        instances.emplace_back(instance);
+    });
+
+    visible_count = instances.size();
+}
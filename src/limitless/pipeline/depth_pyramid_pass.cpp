@@ -0,0 +1,18 @@
+#include <limitless/pipeline/depth_pyramid_pass.hpp>
+
+#include <limitless/pipeline/gpu_culling.hpp>
+#include <limitless/core/framebuffer.hpp>
+#include <limitless/core/context.hpp>
+
+using namespace Limitless;
+
+DepthPyramidPass::DepthPyramidPass(RenderPass* prev, GpuCulling& _culling) noexcept
+    : RenderPass(prev)
+    , culling {_culling} {
+}
+
+void DepthPyramidPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, [[maybe_unused]] const UniformSetter& setter) {
+    auto& framebuffer = dynamic_cast<Framebuffer&>(getTarget());
+
+    culling.updateDepthPyramid(ctx, assets, framebuffer.get(FramebufferAttachment::Depth).texture, camera);
+}
@@ -6,8 +6,12 @@
 #include <limitless/pipeline/sceneupdate_pass.hpp>
 #include <limitless/pipeline/effectupdate_pass.hpp>
 #include <limitless/pipeline/shadow_pass.hpp>
+#include <limitless/pipeline/culling_pass.hpp>
+#include <limitless/pipeline/render_queue_pass.hpp>
 #include <limitless/pipeline/framebuffer_pass.hpp>
 #include <limitless/pipeline/color_pass.hpp>
+#include <limitless/pipeline/depth_pyramid_pass.hpp>
+#include <limitless/pipeline/gpu_culling.hpp>
 #include <limitless/pipeline/particle_pass.hpp>
 #include <limitless/pipeline/skybox_pass.hpp>
 #include <limitless/pipeline/postprocessing_pass.hpp>
@@ -15,32 +19,72 @@
 
 using namespace Limitless;
 
-Forward::Forward(ContextEventObserver& ctx, const RenderSettings& settings) {
+Forward::Forward(ContextEventObserver& ctx, const RenderSettings& settings)
+    : applied_settings {settings} {
     create(ctx, settings);
 }
 
 void Forward::update(ContextEventObserver& ctx, [[maybe_unused]] Scene& scene, const RenderSettings& settings) {
-    clear();
+    previous = std::move(passes);
+    passes.clear();
+
+    // render queue and passes that draw or cull its batches
+    if (settings.batching != applied_settings.batching ||
+        settings.gpu_culling != applied_settings.gpu_culling ||
+        settings.occlusion_culling != applied_settings.occlusion_culling) {
+        discard<RenderQueuePass>();
+        discard<ColorPass>();
+        discard<DepthPyramidPass>();
+    }
+
+    // shadow maps
+    if (settings.directional_shadow_resolution != applied_settings.directional_shadow_resolution ||
+        settings.directional_split_count != applied_settings.directional_split_count) {
+        discard<DirectionalShadowPass>();
+    }
+
+    // other settings are used by shaders only
     create(ctx, settings);
+
+    // passes that are not used anymore
+    previous.clear();
+
+    applied_settings = settings;
 }
 
 void Forward::create(ContextEventObserver& ctx, const RenderSettings& settings) {
-    add<SceneUpdatePass>(ctx);
-    auto& fx = add<EffectUpdatePass>(ctx);
+    reuse<SceneUpdatePass>(ctx);
+    auto& fx = reuse<EffectUpdatePass>(ctx);
 
     if (settings.directional_csm) {
-        add<DirectionalShadowPass>(ctx, settings, fx.getRenderer());
+        reuse<DirectionalShadowPass>(ctx, settings, fx.getRenderer());
+    }
+
+    // culling is done by batch renderer when it is on gpu
+    const bool gpu_culling = settings.batching && settings.gpu_culling && BatchRenderer::isSupported() && GpuCulling::isSupported();
+    if (!gpu_culling) {
+        reuse<CullingPass>();
+    }
+
+    auto& queue_pass = reuse<RenderQueuePass>(settings);
+    const auto& queue = queue_pass.getQueue();
+    auto* batches = queue_pass.getBatches();
+
+    reuse<FramebufferPass>(ctx);
+    reuse<ColorPass>(queue, batches, ms::Blending::Opaque);
+
+    if (gpu_culling && settings.occlusion_culling) {
+        reuse<DepthPyramidPass>(*batches->getCulling());
     }
 
-    add<FramebufferPass>(ctx);
-    add<ColorPass>(ms::Blending::Opaque);
-    add<ParticlePass>(fx.getRenderer(), ms::Blending::Opaque);
-    add<SkyboxPass>();
-    add<ColorPass>(ms::Blending::Additive);
-    add<ParticlePass>(fx.getRenderer(), ms::Blending::Additive);
-    add<ColorPass>(ms::Blending::Modulate);
-    add<ParticlePass>(fx.getRenderer(), ms::Blending::Modulate);
-    add<ColorPass>(ms::Blending::Translucent);
-    add<ParticlePass>(fx.getRenderer(), ms::Blending::Translucent);
-    add<PostEffectsPass>(ctx);
+    // passes of the same type are taken in order they were added
+    reuse<ParticlePass>(fx.getRenderer(), ms::Blending::Opaque);
+    reuse<SkyboxPass>();
+    reuse<ColorPass>(queue, batches, ms::Blending::Additive);
+    reuse<ParticlePass>(fx.getRenderer(), ms::Blending::Additive);
+    reuse<ColorPass>(queue, batches, ms::Blending::Modulate);
+    reuse<ParticlePass>(fx.getRenderer(), ms::Blending::Modulate);
+    reuse<ColorPass>(queue, batches, ms::Blending::Translucent);
+    reuse<ParticlePass>(fx.getRenderer(), ms::Blending::Translucent);
+    reuse<PostEffectsPass>(ctx);
 }
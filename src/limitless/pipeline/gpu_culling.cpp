@@ -0,0 +1,188 @@
+#include <limitless/pipeline/gpu_culling.hpp>
+
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/uniform.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/assets.hpp>
+#include <limitless/camera.hpp>
+
+using namespace Limitless;
+
+namespace {
+    constexpr auto CULL_DRAWS_BUFFER_NAME = "cull_draws";
+    constexpr auto CULL_INPUT_BUFFER_NAME = "cull_input";
+    constexpr auto CULL_OUTPUT_BUFFER_NAME = "cull_output";
+    constexpr auto CULL_COUNTS_BUFFER_NAME = "cull_counts";
+
+    // DrawElementsIndirectCommand
+    constexpr size_t command_size = sizeof(GLuint) * 5;
+
+    constexpr size_t initial_draw_count = 1024;
+    constexpr GLuint cull_group_size = 64;
+    constexpr GLuint pyramid_group_size = 8;
+}
+
+GpuCulling::GpuCulling(bool _occlusion)
+    : occlusion {_occlusion} {
+}
+
+GpuCulling::~GpuCulling() {
+    if (auto* ctx = ContextState::getState(glfwGetCurrentContext()); ctx && draw_buffer) {
+        ctx->getIndexedBuffers().remove(CULL_DRAWS_BUFFER_NAME, draw_buffer);
+        ctx->getIndexedBuffers().remove(CULL_OUTPUT_BUFFER_NAME, output_buffer);
+        ctx->getIndexedBuffers().remove(CULL_COUNTS_BUFFER_NAME, count_buffer);
+    }
+}
+
+bool GpuCulling::isSupported() noexcept {
+    return ContextInitializer::isExtensionSupported("GL_ARB_compute_shader") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_shader_storage_buffer_object") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_clear_buffer_object") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_shader_image_load_store") &&
+           ContextInitializer::isExtensionSupported("GL_ARB_texture_storage");
+}
+
+bool GpuCulling::isCountSupported() noexcept {
+    return ContextInitializer::isExtensionSupported("GL_ARB_indirect_parameters");
+}
+
+void GpuCulling::clear() noexcept {
+    draws.clear();
+}
+
+void GpuCulling::add(const BoundingBox& box, uint32_t run, uint32_t first_command) {
+    draws.push_back({box.center, run, box.size * 0.5f, first_command});
+}
+
+void GpuCulling::initialize(Context& ctx) {
+    BufferBuilder builder;
+
+    draw_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
+                         .setUsage(Buffer::Usage::DynamicDraw)
+                         .setAccess(Buffer::MutableAccess::WriteOrphaning)
+                         .setData(nullptr)
+                         .setDataSize(sizeof(Draw) * initial_draw_count)
+                         .build(CULL_DRAWS_BUFFER_NAME, ctx);
+
+    // written only by compute shader and read as indirect commands and draw count
+    output_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
+                           .setUsage(Buffer::Usage::DynamicCopy)
+                           .setAccess(Buffer::MutableAccess::None)
+                           .setData(nullptr)
+                           .setDataSize(command_size * initial_draw_count)
+                           .build(CULL_OUTPUT_BUFFER_NAME, ctx);
+
+    count_buffer = builder.setTarget(Buffer::Type::ShaderStorage)
+                          .setUsage(Buffer::Usage::DynamicCopy)
+                          .setAccess(Buffer::MutableAccess::None)
+                          .setData(nullptr)
+                          .setDataSize(sizeof(GLuint) * initial_draw_count)
+                          .build(CULL_COUNTS_BUFFER_NAME, ctx);
+}
+
+void GpuCulling::reserve(size_t run_count) {
+    if (draw_buffer->getSize() < draws.size() * sizeof(Draw)) {
+        draw_buffer->resize(draws.size() * sizeof(Draw) * 2);
+    }
+
+    if (output_buffer->getSize() < draws.size() * command_size) {
+        output_buffer->resize(draws.size() * command_size * 2);
+    }
+
+    if (count_buffer->getSize() < run_count * sizeof(GLuint)) {
+        count_buffer->resize(run_count * sizeof(GLuint) * 2);
+    }
+}
+
+void GpuCulling::cull(Context& ctx, const Assets& assets, const Camera& camera, const Buffer& commands, size_t run_count) {
+    if (draws.empty()) {
+        return;
+    }
+
+    if (!draw_buffer) {
+        initialize(ctx);
+    }
+
+    reserve(run_count);
+
+    draw_buffer->mapData(draws.data(), draws.size() * sizeof(Draw));
+
+    // culled commands stay zeroed, so they draw nothing
+    output_buffer->clearData(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+    count_buffer->clearData(GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT, nullptr);
+
+    auto& shader = assets.shaders.get("culling");
+
+    const bool occlusion_ready = occlusion && depth_pyramid;
+
+    shader << UniformValue {"view_projection", camera.getProjection() * camera.getView()}
+           << UniformValue {"draw_count", static_cast<GLuint>(draws.size())}
+           << UniformValue {"occlusion", static_cast<int>(occlusion_ready)};
+
+    if (occlusion_ready) {
+        shader << UniformSampler {"depth_pyramid", depth_pyramid}
+               << UniformValue {"pyramid_levels", static_cast<int>(pyramid_levels)}
+               << UniformValue {"pyramid_view_projection", pyramid_view_projection};
+    }
+
+    shader.use();
+
+    auto& buffers = ctx.getIndexedBuffers();
+    draw_buffer->bindBase(buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, CULL_DRAWS_BUFFER_NAME));
+    commands.bindBaseAs(Buffer::Type::ShaderStorage, buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, CULL_INPUT_BUFFER_NAME));
+    output_buffer->bindBase(buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, CULL_OUTPUT_BUFFER_NAME));
+    count_buffer->bindBase(buffers.getBindingPoint(IndexedBuffer::Type::ShaderStorage, CULL_COUNTS_BUFFER_NAME));
+
+    glDispatchCompute((static_cast<GLuint>(draws.size()) + cull_group_size - 1) / cull_group_size, 1, 1);
+
+    // results are consumed as indirect commands and parameters
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void GpuCulling::updateDepthPyramid([[maybe_unused]] Context& ctx, const Assets& assets, const std::shared_ptr<Texture>& depth, const Camera& camera) {
+    if (!occlusion) {
+        return;
+    }
+
+    const auto size = glm::max(glm::uvec2{depth->getSize()} / 2u, glm::uvec2{1});
+
+    if (!depth_pyramid || glm::uvec2{depth_pyramid->getSize()} != size) {
+        pyramid_levels = static_cast<GLsizei>(glm::log2(static_cast<float>(glm::max(size.x, size.y)))) + 1;
+
+        TextureBuilder builder;
+        depth_pyramid = builder.setTarget(Texture::Type::Tex2D)
+                               .setInternalFormat(Texture::InternalFormat::R32F)
+                               .setLevels(pyramid_levels)
+                               .setSize(size)
+                               .setFormat(Texture::Format::Red)
+                               .setDataType(Texture::DataType::Float)
+                               .setMinFilter(Texture::Filter::NearestMipmapNearest)
+                               .setMagFilter(Texture::Filter::Nearest)
+                               .setWrapS(Texture::Wrap::ClampToEdge)
+                               .setWrapT(Texture::Wrap::ClampToEdge)
+                               .build();
+    }
+
+    auto& shader = assets.shaders.get("depth_pyramid");
+
+    shader << UniformValue {"destination", 0};
+
+    for (GLsizei level = 0; level < pyramid_levels; ++level) {
+        const auto level_size = glm::max(glm::uvec2{size.x >> level, size.y >> level}, glm::uvec2{1});
+
+        // first level reduces depth buffer itself, others the previous level
+        shader << UniformSampler {"source", level == 0 ? depth : depth_pyramid}
+               << UniformValue {"source_level", level == 0 ? 0 : level - 1};
+
+        shader.use();
+
+        glBindImageTexture(0, depth_pyramid->getId(), level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+        glDispatchCompute((level_size.x + pyramid_group_size - 1) / pyramid_group_size, (level_size.y + pyramid_group_size - 1) / pyramid_group_size, 1);
+        glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+    }
+
+    pyramid_view_projection = camera.getProjection() * camera.getView();
+}
@@ -4,6 +4,7 @@
 #include <limitless/core/uniform_setter.hpp>
 #include <limitless/pipeline/render_pass.hpp>
 #include <limitless/core/framebuffer.hpp>
+#include <limitless/core/context.hpp>
 #include <limitless/pipeline/sceneupdate_pass.hpp>
 
 using namespace Limitless;
@@ -11,6 +12,10 @@ using namespace Limitless;
 void Pipeline::draw(Context& context, const Assets& assets, Scene& scene, Camera& camera) {
     Instances instances;
 
+    // per-frame data of passes and instances is allocated in ring buffer
+    auto& ring = context.getRingBuffer();
+    ring.beginFrame();
+
     for (const auto& pass : passes) {
         pass->update(scene, instances, context, camera);
         if (dynamic_cast<Limitless::SceneUpdatePass*>(pass.get())) {
@@ -23,6 +28,11 @@ void Pipeline::draw(Context& context, const Assets& assets, Scene& scene, Camera
         pass->draw(instances, context, assets, camera, setter);
         pass->addSetter(setter);
     }
+
+    ring.endFrame();
+
+    // first draws with programs are timed up to the end of frame
+    context.endFirstUse();
 }
 
 void Pipeline::update([[maybe_unused]] ContextEventObserver& ctx, [[maybe_unused]] Scene& scene, [[maybe_unused]] const RenderSettings& settings) {
@@ -8,6 +8,10 @@ RenderPass::RenderPass(RenderPass *pass) noexcept
     : prev_pass {pass} {
 }
 
+void RenderPass::setPrevious(RenderPass* pass) noexcept {
+    prev_pass = pass;
+}
+
 RenderTarget& RenderPass::getTarget() {
     return prev_pass ? prev_pass->getTarget() : throw std::logic_error("Forgot to add FramebufferPass!");
 }
@@ -0,0 +1,116 @@
+#include <limitless/pipeline/render_queue.hpp>
+
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/camera.hpp>
+#include <cstring>
+
+using namespace Limitless;
+
+namespace {
+    constexpr uint64_t depth_bits = 24;
+    constexpr uint64_t shader_bits = 21;
+    constexpr uint64_t material_bits = 16;
+    constexpr uint64_t blending_shift = 61;
+
+    constexpr uint64_t mask(uint64_t bits) noexcept { return (uint64_t{1} << bits) - 1; }
+
+    // bit pattern of non-negative floats grows with their value, so top bits make a monotonic depth without any range
+    uint64_t quantizeDepth(float depth) noexcept {
+        depth = std::max(depth, 0.0f);
+
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+
+        return bits >> (32 - depth_bits);
+    }
+
+    // materials have no ids, addresses keep items of the same material together
+    uint64_t materialBits(const ms::Material& material) noexcept {
+        const auto address = reinterpret_cast<uintptr_t>(&material);
+        return ((address >> 4) ^ (address >> 20)) & mask(material_bits);
+    }
+}
+
+void RenderQueue::begin(const Camera& camera) {
+    items.clear();
+    camera_position = camera.getPosition();
+    camera_front = camera.getFront();
+}
+
+uint64_t RenderQueue::makeKey(const AbstractInstance& instance, const ms::Material& material) const noexcept {
+    const auto blending = static_cast<uint64_t>(material.getBlending());
+    const auto shader = material.getShaderIndex() & mask(shader_bits);
+    const auto mat = materialBits(material);
+    const auto depth = quantizeDepth(glm::dot(instance.getBoundingBox().center - camera_position, camera_front));
+
+    auto key = blending << blending_shift;
+
+    if (material.getBlending() == ms::Blending::Translucent) {
+        key |= (~depth & mask(depth_bits)) << (shader_bits + material_bits);
+        key |= shader << material_bits;
+        key |= mat;
+    } else {
+        key |= shader << (material_bits + depth_bits);
+        key |= mat << depth_bits;
+        key |= depth;
+    }
+
+    return key;
+}
+
+void RenderQueue::add(AbstractInstance& instance, MeshInstance& mesh, uint64_t layer, const ms::Material& material) {
+    items.push_back({&instance, &mesh, &material, layer});
+}
+
+void RenderQueue::sort() {
+    entries.resize(items.size());
+    scratch.resize(items.size());
+
+    for (uint32_t i = 0; i < items.size(); ++i) {
+        entries[i] = {makeKey(*items[i].instance, *items[i].material), i};
+    }
+
+    // least significant digit first, a byte per pass; passes where all keys share a digit are skipped
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        std::array<uint32_t, 256> histogram {};
+        for (const auto& entry : entries) {
+            ++histogram[(entry.key >> shift) & 0xFF];
+        }
+
+        if (histogram[(entries.empty() ? 0 : entries[0].key >> shift) & 0xFF] == entries.size()) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (auto& count : histogram) {
+            const auto current = count;
+            count = offset;
+            offset += current;
+        }
+
+        for (const auto& entry : entries) {
+            scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        }
+
+        std::swap(entries, scratch);
+    }
+
+    sorted.clear();
+    sorted.reserve(items.size());
+    buckets.fill(0);
+
+    for (const auto& entry : entries) {
+        sorted.emplace_back(items[entry.index]);
+        ++buckets[(entry.key >> blending_shift) + 1];
+    }
+
+    for (uint32_t i = 1; i < buckets.size(); ++i) {
+        buckets[i] += buckets[i - 1];
+    }
+}
+
+RenderQueue::Bucket RenderQueue::getBucket(ms::Blending blending) const noexcept {
+    const auto index = static_cast<uint32_t>(blending);
+    return {sorted.data() + buckets[index], sorted.data() + buckets[index + 1]};
+}
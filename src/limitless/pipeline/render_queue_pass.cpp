@@ -0,0 +1,23 @@
+#include <limitless/pipeline/render_queue_pass.hpp>
+
+#include <limitless/instances/abstract_instance.hpp>
+#include <limitless/pipeline/render_settings.hpp>
+
+using namespace Limitless;
+
+RenderQueuePass::RenderQueuePass(RenderPass* prev, const RenderSettings& settings)
+    : RenderPass(prev) {
+    if (settings.batching && BatchRenderer::isSupported()) {
+        batches = std::make_unique<BatchRenderer>(settings.gpu_culling, settings.occlusion_culling);
+    }
+}
+
+void RenderQueuePass::update([[maybe_unused]] Scene& scene, Instances& instances, [[maybe_unused]] Context& ctx, const Camera& camera) {
+    queue.begin(camera);
+
+    for (auto& instance : instances) {
+        instance.get().collect(queue);
+    }
+
+    queue.sort();
+}
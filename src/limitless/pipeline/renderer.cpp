@@ -13,11 +13,13 @@ using namespace Limitless;
 
 Renderer::Renderer(std::unique_ptr<Pipeline> _pipeline, const RenderSettings& _settings)
     : settings {_settings}
+    , applied_settings {_settings}
     , pipeline {std::move(_pipeline)} {
 }
 
 Renderer::Renderer(ContextEventObserver& ctx)
     : settings {}
+    , applied_settings {}
     , pipeline {std::make_unique<Forward>(ctx, settings)} {
 }
 
@@ -26,7 +28,9 @@ void Renderer::draw(Context& context, const Assets& assets, Scene& scene, Camera
 }
 
 void Renderer::update(ContextEventObserver& ctx, Assets& assets, Scene& scene) {
-    assets.recompileShaders(ctx, settings);
+    assets.updateShaders(ctx, applied_settings, settings);
 
     pipeline->update(ctx, scene, settings);
+
+    applied_settings = settings;
 }
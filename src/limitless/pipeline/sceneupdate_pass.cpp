@@ -4,9 +4,8 @@
 
 using namespace Limitless;
 
-SceneUpdatePass::SceneUpdatePass(RenderPass* prev, Context& ctx)
-    : RenderPass(prev)
-    , scene_data {ctx} {
+SceneUpdatePass::SceneUpdatePass(RenderPass* prev, [[maybe_unused]] Context& ctx)
+    : RenderPass(prev) {
 }
 
 void SceneUpdatePass::update(Scene& scene, Instances& instances, Context& ctx, const Camera& camera) {
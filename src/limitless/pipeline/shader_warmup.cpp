@@ -0,0 +1,289 @@
+#include <limitless/pipeline/shader_warmup.hpp>
+
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/context.hpp>
+#include <limitless/fx/emitters/sprite_emitter.hpp>
+#include <limitless/fx/emitters/mesh_emitter.hpp>
+#include <limitless/fx/emitters/beam_emitter.hpp>
+#include <limitless/instances/effect_instance.hpp>
+#include <limitless/skybox/skybox.hpp>
+#include <limitless/ms/blending.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/assets.hpp>
+#include <algorithm>
+#include <tuple>
+#include <map>
+#include <string_view>
+
+using namespace Limitless;
+
+namespace {
+    const glm::uvec2 target_size {1};
+
+    // covers first entries of model, bone and batch buffers that vertices of cube mesh read
+    constexpr size_t placeholder_size = 1024;
+
+    std::shared_ptr<Texture> makeAttachment(Texture::InternalFormat internal, Texture::Format format) {
+        TextureBuilder builder;
+        return builder.setTarget(Texture::Type::Tex2D)
+                      .setInternalFormat(internal)
+                      .setSize(target_size)
+                      .setFormat(format)
+                      .setDataType(Texture::DataType::Float)
+                      .setMinFilter(Texture::Filter::Nearest)
+                      .setMagFilter(Texture::Filter::Nearest)
+                      .build();
+    }
+
+    const ms::Material& getEmitterMaterial(const EffectInstance& effect, const std::string& name, const fx::AbstractEmitter& emitter) {
+        switch (emitter.getType()) {
+            case fx::AbstractEmitter::Type::Sprite:
+                return effect.get<fx::SpriteEmitter>(name).getMaterial();
+            case fx::AbstractEmitter::Type::Mesh:
+                return effect.get<fx::MeshEmitter>(name).getMaterial();
+            case fx::AbstractEmitter::Type::Beam:
+                return effect.get<fx::BeamEmitter>(name).getMaterial();
+        }
+
+        throw std::logic_error("Unknown emitter type");
+    }
+
+    // storage buffers that instances and batch renderer bind themselves before drawing
+    std::vector<std::string_view> getModelBuffers(ModelShader model) {
+        switch (model) {
+            case ModelShader::Skeletal:
+                return {"bone_buffer"};
+            case ModelShader::Instanced:
+                return {"model_buffer"};
+            case ModelShader::SkeletalInstanced:
+                return {"model_buffer", "bone_buffer"};
+            case ModelShader::Batched:
+                return {"batch_buffer"};
+            default:
+                return {};
+        }
+    }
+}
+
+ShaderWarmUp::ShaderWarmUp() {
+    // formats of FramebufferPass and of shadow maps
+    target.bind();
+    target << TextureAttachment{FramebufferAttachment::Color0, makeAttachment(Texture::InternalFormat::RGBA16F, Texture::Format::RGBA)}
+           << TextureAttachment{FramebufferAttachment::Depth, makeAttachment(Texture::InternalFormat::Depth32F, Texture::Format::DepthComponent)};
+    target.drawBuffer(FramebufferAttachment::Color0);
+    target.checkStatus();
+    target.unbind();
+
+    depth_target.bind();
+    depth_target << TextureAttachment{FramebufferAttachment::Depth, makeAttachment(Texture::InternalFormat::Depth16, Texture::Format::DepthComponent)};
+    depth_target.drawBuffer(FramebufferAttachment::None);
+    depth_target.readBuffer(FramebufferAttachment::None);
+    depth_target.checkStatus();
+    depth_target.unbind();
+
+    const std::vector<std::byte> zeros(placeholder_size);
+    BufferBuilder builder;
+    placeholder = builder.setTarget(Buffer::Type::ShaderStorage)
+                         .setUsage(Buffer::Usage::StaticDraw)
+                         .setAccess(Buffer::MutableAccess::None)
+                         .setData(zeros.data())
+                         .setDataSize(zeros.size())
+                         .build();
+}
+
+ShaderWarmUp& ShaderWarmUp::setMaterials(std::vector<std::string> names) {
+    materials = std::move(names);
+    return *this;
+}
+
+ShaderWarmUp& ShaderWarmUp::setPasses(std::vector<ShaderPass> _passes) {
+    passes = std::move(_passes);
+    return *this;
+}
+
+ShaderWarmUp& ShaderWarmUp::setModelShaders(ModelShaders _models) {
+    models = std::move(_models);
+    return *this;
+}
+
+std::vector<ShaderWarmUp::Entry> ShaderWarmUp::getEntries(const Assets& assets) const {
+    // materials with equal shader index share programs, any of them gives the state
+    std::map<uint64_t, const ms::Material*> index_materials;
+    for (const auto& [_, material] : assets.materials) {
+        index_materials.emplace(material->getShaderIndex(), material.get());
+    }
+
+    for (const auto& [_, skybox] : assets.skyboxes) {
+        index_materials.emplace(skybox->getMaterial().getShaderIndex(), &skybox->getMaterial());
+    }
+
+    std::map<fx::UniqueEmitterShader, std::pair<const ms::Material*, bool>> emitter_materials;
+    for (const auto& [_, effect] : assets.effects) {
+        for (const auto& [name, emitter] : effect->getEmitters()) {
+            const auto& material = getEmitterMaterial(*effect, name, *emitter);
+            emitter_materials.emplace(emitter->getUniqueShaderType(), std::pair{&material, emitter->getType() == fx::AbstractEmitter::Type::Sprite});
+        }
+    }
+
+    std::vector<Entry> entries;
+
+    for (const auto& [key, program] : assets.shaders.copyMaterialShaders()) {
+        const auto found = index_materials.find(key.material_index);
+        const auto* material = found != index_materials.end() ? found->second : nullptr;
+        entries.emplace_back(Entry{program, key.material_type, key.model_type, material, false});
+    }
+
+    for (const auto& [key, program] : assets.shaders.copyEmitterShaders()) {
+        const auto found = emitter_materials.find(key.emitter_type);
+        const auto [material, points] = found != emitter_materials.end() ? found->second : std::pair<const ms::Material*, bool>{nullptr, false};
+        entries.emplace_back(Entry{program, key.shader, ModelShader::Effect, material, points});
+    }
+
+    const auto rank = [&] (const Entry& entry) {
+        const auto material = entry.material
+                ? std::find(materials.begin(), materials.end(), entry.material->getName()) - materials.begin()
+                : std::distance(materials.begin(), materials.end());
+        const auto pass = std::find(passes.begin(), passes.end(), entry.pass) - passes.begin();
+        return std::tuple{material, pass, entry.model};
+    };
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&] (const Entry& entry) {
+        return std::find(passes.begin(), passes.end(), entry.pass) == passes.end() || !models.count(entry.model);
+    }), entries.end());
+
+    std::stable_sort(entries.begin(), entries.end(), [&] (const Entry& lhs, const Entry& rhs) {
+        return rank(lhs) < rank(rhs);
+    });
+
+    return entries;
+}
+
+// the same state that passes set before drawing with the program
+void ShaderWarmUp::setState(Context& ctx, const Entry& entry) {
+    if (entry.pass == ShaderPass::Skybox) {
+        ctx.enable(Capabilities::DepthTest);
+        ctx.setDepthFunc(DepthFunc::Lequal);
+        ctx.setDepthMask(DepthMask::True);
+        ctx.disable(Capabilities::Blending);
+        ctx.disable(Capabilities::CullFace);
+        return;
+    }
+
+    // depth state of forward and shadow passes, blending of material may relax it below
+    ctx.enable(Capabilities::DepthTest);
+    ctx.setDepthFunc(DepthFunc::Less);
+    ctx.setDepthMask(DepthMask::True);
+
+    // shadow pass draws opaque materials only
+    if (entry.pass == ShaderPass::DirectionalShadow) {
+        ctx.disable(Capabilities::Blending);
+    } else {
+        setBlendingMode(ctx, entry.material ? entry.material->getBlending() : ms::Blending::Opaque);
+    }
+
+    if (entry.material && entry.material->getTwoSided()) {
+        ctx.disable(Capabilities::CullFace);
+    } else {
+        ctx.enable(Capabilities::CullFace);
+        ctx.setCullFace(entry.pass == ShaderPass::DirectionalShadow ? CullFace::Front : CullFace::Back);
+    }
+
+    if (entry.points) {
+        ctx.enable(Capabilities::ProgramPointSize);
+    }
+}
+
+void ShaderWarmUp::draw(Context& ctx, const Assets& assets, const Entry& entry) {
+    auto& framebuffer = entry.pass == ShaderPass::DirectionalShadow ? depth_target : target;
+    framebuffer.bind();
+
+    setState(ctx, entry);
+
+    auto& program = *entry.program;
+    if (entry.material) {
+        program << *entry.material;
+    }
+    program.apply(ctx);
+
+    // zeroed data is enough for driver to compile, real buffers are bound by their owners again
+    for (const auto name : getModelBuffers(entry.model)) {
+        placeholder->bindBase(ctx.getIndexedBuffers().getBindingPoint(IndexedBuffer::Type::ShaderStorage, name));
+    }
+
+    const auto& mesh = assets.meshes.at("cube");
+    if (entry.points) {
+        mesh->draw(DrawMode::Points);
+    } else if (entry.material && entry.material->contains(ms::Property::TessellationFactor)) {
+        mesh->draw(DrawMode::Patches);
+    } else if (entry.model == ModelShader::Instanced || entry.model == ModelShader::SkeletalInstanced) {
+        mesh->draw_instanced(DrawMode::Triangles, 1);
+    } else {
+        mesh->draw();
+    }
+
+    program.warmed = true;
+}
+
+bool ShaderWarmUp::warm(Context& ctx, const Assets& assets, std::chrono::nanoseconds budget) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // state of frames is restored after drawing, it may differ from state that warm-up sets
+    const auto viewport = ctx.getViewPort();
+    const auto capabilities = ctx.getCapabilities();
+    const auto depth_func = ctx.getDepthFunc();
+    const auto depth_mask = ctx.getDepthMask();
+    const auto cull_face = ctx.getCullFace();
+    const auto [src_factor, dst_factor] = ctx.getBlendFunc();
+    const auto blend_color = ctx.getBlendColor();
+
+    ctx.setViewPort(target_size);
+
+    bool done = true;
+    for (const auto& entry : getEntries(assets)) {
+        // also swaps in linked replacement, which is not warm
+        if (!entry.program->isReady()) {
+            done = false;
+            continue;
+        }
+
+        if (entry.program->warmed || entry.program->used) {
+            continue;
+        }
+
+        if (std::chrono::steady_clock::now() - start >= budget) {
+            done = false;
+            break;
+        }
+
+        const auto draw_start = std::chrono::steady_clock::now();
+        draw(ctx, assets, entry);
+
+        auto& stats = ctx.shader_stats;
+        ++stats.warmed;
+        stats.warm_up_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - draw_start);
+    }
+
+    target.unbind();
+    ctx.setViewPort(viewport);
+
+    for (const auto func : {Capabilities::DepthTest, Capabilities::Blending, Capabilities::ProgramPointSize, Capabilities::CullFace}) {
+        if (capabilities[ContextState::getIndex(func)]) {
+            ctx.enable(func);
+        } else {
+            ctx.disable(func);
+        }
+    }
+
+    ctx.setDepthFunc(depth_func);
+    ctx.setDepthMask(depth_mask);
+    ctx.setCullFace(cull_face);
+    ctx.setBlendColor(blend_color);
+    // blend function was not set before, there is nothing to restore
+    if (src_factor != BlendFactor::None) {
+        ctx.setBlendFunc(src_factor, dst_factor);
+    }
+
+    return done;
+}
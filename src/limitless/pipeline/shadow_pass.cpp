@@ -16,9 +16,9 @@ DirectionalShadowPass::DirectionalShadowPass(RenderPass *prev, Context& ctx, con
     , effect_renderer {&renderer} {
 }
 
-void DirectionalShadowPass::draw(Instances& instances, Context& ctx, const Assets& assets, const Camera& camera, [[maybe_unused]] const UniformSetter& setter) {
+void DirectionalShadowPass::draw([[maybe_unused]] Instances& instances, Context& ctx, const Assets& assets, [[maybe_unused]] const Camera& camera, [[maybe_unused]] const UniformSetter& setter) {
     if (light) {
-        shadows.draw(instances, *light, ctx, assets, camera, effect_renderer);
+        shadows.draw(ctx, assets, effect_renderer);
         shadows.mapData();
     }
 }
@@ -29,6 +29,8 @@ void DirectionalShadowPass::addSetter(UniformSetter& setter) {
     });
 }
 
-void DirectionalShadowPass::update(Scene& scene, [[maybe_unused]] Instances& instances, [[maybe_unused]] Context& ctx, [[maybe_unused]] const Camera& camera) {
+void DirectionalShadowPass::update(Scene& scene, [[maybe_unused]] Instances& instances, Context& ctx, const Camera& camera) {
     light = &scene.lighting.directional_light;
+
+    shadows.update(ctx, camera, *light, scene);
 }
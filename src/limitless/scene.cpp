@@ -11,33 +11,149 @@ Scene::Scene(Context& context)
 AbstractInstance& Scene::operator[](uint64_t id) noexcept { return *instances[id]; }
 AbstractInstance& Scene::at(uint64_t id) { return *instances.at(id); }
 
-void Scene::remove(uint64_t id) { instances.erase(id); }
+void Scene::remove(uint64_t id) {
+    if (auto it = instances.find(id); it != instances.end()) {
+        removeFromSpatialIndex(*it->second);
+        detach(*it->second);
+        instances.erase(it);
+    }
+}
 
 void Scene::setSkybox(std::shared_ptr<Skybox> _skybox) {
     skybox = std::move(_skybox);
 }
 
 void Scene::update(Context& context, Camera& camera) {
-    lighting.update();
+    const auto rebuilt_before = AbstractInstance::getRebuiltMatrixCount();
 
     removeDeadInstances();
 
+    // matrices of all moved instances are composed in one batch before instances pick them up
+    const auto composed = transforms.update();
+
+    update_models.clear();
+    update_effects.clear();
     for (auto& [_, instance] : instances) {
         if (instance->getShaderType() != ModelShader::Effect) {
-            instance->update(context, camera);
+            update_models.emplace_back(instance.get());
+        } else {
+            update_effects.emplace_back(instance.get());
         }
     }
 
-    for (auto& [_, instance] : instances) {
-        if (instance->getShaderType() == ModelShader::Effect) {
+    // update jobs read the store, instances moved meanwhile write their transforms afterwards
+    transforms.lock();
+    try {
+        updateInstances(update_models, context, camera);
+        updateInstances(update_effects, context, camera);
+    } catch (...) {
+        transforms.unlock();
+        throw;
+    }
+    transforms.unlock();
+
+    // lights and transform store are shared by instances, so they are written after update jobs are done
+    for (auto* instance : update_models) {
+        updateSerial(*instance);
+    }
+
+    for (auto* instance : update_effects) {
+        updateSerial(*instance);
+    }
+
+    lighting.update();
+
+    rebuilt_matrix_count = composed + AbstractInstance::getRebuiltMatrixCount() - rebuilt_before;
+}
+
+void Scene::updateInstances(const std::vector<AbstractInstance*>& list, Context& context, Camera& camera) {
+    // minimal count of instances taken by a thread at once
+    constexpr size_t min_chunk_size = 64;
+
+    if (!update_jobs || list.size() <= min_chunk_size) {
+        for (auto* instance : list) {
             instance->update(context, camera);
         }
+        return;
     }
+
+    update_jobs->parallel_for(0, list.size(), min_chunk_size, [&] (size_t i) {
+        list[i]->update(context, camera);
+    });
+}
+
+void Scene::setUpdateThreadCount(uint32_t count) {
+    update_thread_count = std::max(count, 1u);
+    update_jobs = update_thread_count > 1 ? std::make_unique<JobSystem>(update_thread_count) : nullptr;
+}
+
+void Scene::attach(AbstractInstance& instance) {
+    instance.transform.store = &transforms;
+    instance.transform.handle = transforms.allocate(instance.getPosition(), instance.getRotation(), instance.getScale());
+    instance.transform_changed = true;
+}
+
+void Scene::detach(AbstractInstance& instance) noexcept {
+    if (instance.transform) {
+        transforms.release(instance.transform.handle);
+        instance.transform.store = nullptr;
+        instance.transform.handle = TransformStore::null_handle;
+    }
+}
+
+void Scene::updateSerial(AbstractInstance& instance) {
+    if (instance.transform.pending) {
+        instance.storeTransform();
+    }
+
+    instance.updateLights();
+    updateSpatialIndex(instance);
+}
+
+void Scene::updateSpatialIndex(AbstractInstance& instance) {
+    if (!instance.bounds_changed) {
+        return;
+    }
+
+    if (instance.spatial_proxy == AABBTree<AbstractInstance*>::null_node) {
+        instance.spatial_proxy = tree.insert(instance.getBoundingBox(), &instance);
+    } else {
+        tree.update(instance.spatial_proxy, instance.getBoundingBox());
+    }
+
+    instance.bounds_changed = false;
+}
+
+void Scene::removeFromSpatialIndex(AbstractInstance& instance) noexcept {
+    if (instance.spatial_proxy != AABBTree<AbstractInstance*>::null_node) {
+        tree.remove(instance.spatial_proxy);
+        instance.spatial_proxy = AABBTree<AbstractInstance*>::null_node;
+    }
+}
+
+Instances Scene::query(const Frustum& frustum) const {
+    Instances result;
+    query(frustum, [&] (AbstractInstance& instance) { result.emplace_back(instance); });
+    return result;
+}
+
+Instances Scene::query(const BoundingBox& box) const {
+    Instances result;
+    query(box, [&] (AbstractInstance& instance) { result.emplace_back(instance); });
+    return result;
+}
+
+Instances Scene::query(const glm::vec3& center, float radius) const {
+    Instances result;
+    query(center, radius, [&] (AbstractInstance& instance) { result.emplace_back(instance); });
+    return result;
 }
 
 void Scene::removeDeadInstances() noexcept {
     for (auto it = instances.cbegin(); it != instances.cend(); ) {
         if (it->second->isKilled()) {
+            removeFromSpatialIndex(*it->second);
+            detach(*it->second);
             it = instances.erase(it);
         } else {
             ++it;
@@ -58,4 +174,6 @@ Instances Scene::getWrappers() noexcept {
 
 void Scene::clear() {
 	instances.clear();
+	tree.clear();
+	transforms.clear();
 }
@@ -1,5 +1,7 @@
 #include <limitless/shader_storage.hpp>
 #include <limitless/core/shader_compiler.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/pipeline/gpu_culling.hpp>
 
 using namespace Limitless;
 
@@ -8,6 +10,7 @@ bool Limitless::operator<(const ShaderKey& lhs, const ShaderKey& rhs) noexcept {
 }
 
 ShaderProgram& ShaderStorage::get(const std::string& name) const {
+    std::shared_lock lock(mutex);
     try {
         return *shaders.at(name);
     } catch (const std::out_of_range& e) {
@@ -16,6 +19,7 @@ ShaderProgram& ShaderStorage::get(const std::string& name) const {
 }
 
 ShaderProgram& ShaderStorage::get(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const {
+    std::shared_lock lock(mutex);
     try {
         return *material_shaders.at({material_type, model_type, material_index});
     } catch (const std::out_of_range& e) {
@@ -33,28 +37,31 @@ void ShaderStorage::add(std::string name, std::shared_ptr<ShaderProgram> program
 
 void ShaderStorage::add(ShaderPass material_type, ModelShader model_type, uint64_t material_index, std::shared_ptr<ShaderProgram> program) {
     std::unique_lock lock(mutex);
-    const auto result = material_shaders.emplace(ShaderKey{material_type, model_type, material_index}, std::move(program));
-    if (!result.second) {
-        throw shader_storage_error{"Shader already exists"};
+    const auto [it, added] = material_shaders.emplace(ShaderKey{material_type, model_type, material_index}, program);
+    if (!added && it->second->isOutdated()) {
+        it->second->replace(std::move(program));
     }
 }
 
 bool ShaderStorage::contains(const std::string& shader_name) noexcept {
-	std::unique_lock lock(mutex);
+	std::shared_lock lock(mutex);
 	return shaders.find(shader_name) != shaders.end();
 }
 
-bool ShaderStorage::contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) noexcept {
-    std::unique_lock lock(mutex);
-    return material_shaders.find({material_type, model_type, material_index}) != material_shaders.end();
+bool ShaderStorage::contains(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const noexcept {
+    std::shared_lock lock(mutex);
+    const auto it = material_shaders.find({material_type, model_type, material_index});
+    return it != material_shaders.end() && !it->second->isOutdated();
 }
 
 bool ShaderStorage::contains(const fx::UniqueEmitterShaderKey& emitter_type) noexcept {
-    std::unique_lock lock(mutex);
-    return emitters.find(emitter_type) != emitters.end();
+    std::shared_lock lock(mutex);
+    const auto it = emitters.find(emitter_type);
+    return it != emitters.end() && !it->second->isOutdated();
 }
 
 ShaderProgram& ShaderStorage::get(const fx::UniqueEmitterShaderKey& emitter_type) const {
+    std::shared_lock lock(mutex);
     try {
         return *emitters.at(emitter_type);
     } catch (const std::out_of_range& e) {
@@ -62,11 +69,33 @@ ShaderProgram& ShaderStorage::get(const fx::UniqueEmitterShaderKey& emitter_type
     }
 }
 
+ShaderProgram* ShaderStorage::find(ShaderPass material_type, ModelShader model_type, uint64_t material_index) const noexcept {
+    std::shared_lock lock(mutex);
+    const auto it = material_shaders.find({material_type, model_type, material_index});
+    return it != material_shaders.end() ? it->second.get() : nullptr;
+}
+
+ShaderProgram* ShaderStorage::find(const fx::UniqueEmitterShaderKey& emitter_type) const noexcept {
+    std::shared_lock lock(mutex);
+    const auto it = emitters.find(emitter_type);
+    return it != emitters.end() ? it->second.get() : nullptr;
+}
+
+std::map<ShaderKey, std::shared_ptr<ShaderProgram>> ShaderStorage::copyMaterialShaders() const {
+    std::shared_lock lock(mutex);
+    return material_shaders;
+}
+
+std::map<fx::UniqueEmitterShaderKey, std::shared_ptr<ShaderProgram>> ShaderStorage::copyEmitterShaders() const {
+    std::shared_lock lock(mutex);
+    return emitters;
+}
+
 void ShaderStorage::add(const fx::UniqueEmitterShaderKey& emitter_type, std::shared_ptr<ShaderProgram> program) {
     std::unique_lock lock(mutex);
-    const auto result = emitters.emplace(emitter_type, std::move(program));
-    if (!result.second) {
-        throw shader_storage_error{"Shader already contains emitter"};
+    const auto [it, added] = emitters.emplace(emitter_type, program);
+    if (!added && it->second->isOutdated()) {
+        it->second->replace(std::move(program));
     }
 }
 //
@@ -94,16 +123,49 @@ void ShaderStorage::initialize(Context& ctx, const fs::path& shader_dir) {
     add("postprocess", compiler.compile(shader_dir / "postprocessing/postprocess"));
     add("text", compiler.compile(shader_dir / "pipeline/text"));
     add("text_selection", compiler.compile(shader_dir / "pipeline/text_selection"));
+
+    if (GpuCulling::isSupported()) {
+        add("culling", compiler.compile(shader_dir / "pipeline/culling"));
+        add("depth_pyramid", compiler.compile(shader_dir / "pipeline/depth_pyramid"));
+    }
 }
 
 void ShaderStorage::clearMaterialShaders() {
+    std::unique_lock lock(mutex);
     material_shaders.clear();
 }
 
 void ShaderStorage::clearEffectShaders() {
+    std::unique_lock lock(mutex);
     emitters.clear();
 }
 
+void ShaderStorage::outdateDependent(const std::vector<fs::path>& files) {
+    const auto outdate = [&] (const auto& pair) {
+        const auto& dependencies = pair.second->getDependencies();
+        if (std::any_of(files.begin(), files.end(), [&] (const auto& file) { return std::find(dependencies.begin(), dependencies.end(), file) != dependencies.end(); })) {
+            pair.second->outdate();
+        }
+    };
+
+    std::unique_lock lock(mutex);
+    std::for_each(material_shaders.begin(), material_shaders.end(), outdate);
+    std::for_each(emitters.begin(), emitters.end(), outdate);
+}
+
+void ShaderStorage::outdate(const std::vector<std::string>& defines) {
+    const auto outdate = [&] (const auto& pair) {
+        const auto& used = pair.second->getDefines();
+        if (std::any_of(defines.begin(), defines.end(), [&] (const auto& define) { return std::find(used.begin(), used.end(), define) != used.end(); })) {
+            pair.second->outdate();
+        }
+    };
+
+    std::unique_lock lock(mutex);
+    std::for_each(material_shaders.begin(), material_shaders.end(), outdate);
+    std::for_each(emitters.begin(), emitters.end(), outdate);
+}
+
 void ShaderStorage::add(const ShaderStorage& other) {
     for (auto&& [key, value] : other.shaders) {
         shaders.emplace(key, value);
@@ -30,7 +30,14 @@ Skybox::Skybox(Assets& assets, const fs::path& path, const TextureLoaderFlags& f
 }
 
 void Skybox::draw(Context& context, const Assets& assets) {
-    auto& shader = assets.shaders.get(ShaderPass::Skybox, ModelShader::Model, material->getShaderIndex());
+    auto* program = assets.shaders.find(ShaderPass::Skybox, ModelShader::Model, material->getShaderIndex());
+
+    // sky appears once its shader is compiled and linked
+    if (!program || !program->isReady()) {
+        return;
+    }
+
+    auto& shader = *program;
 
     context.enable(Capabilities::DepthTest);
     context.setDepthFunc(DepthFunc::Lequal);
@@ -11,6 +11,13 @@
 
 using namespace Limitless;
 
+namespace {
+    const UniformId bitmap_uniform {"bitmap"};
+    const UniformId model_uniform {"model"};
+    const UniformId proj_uniform {"proj"};
+    const UniformId color_uniform {"color"};
+}
+
 TextInstance::TextInstance(std::string _text, const glm::vec2& _position, std::shared_ptr<FontAtlas> _font)
     : text_model {_font->generate(_text)}
     , text {std::move(_text)}
@@ -81,9 +88,9 @@ void TextInstance::draw(Context& ctx, const Assets& assets) {
 
         auto& shader = assets.shaders.get("text_selection");
 
-        shader << UniformValue{"model", model_matrix}
-               << UniformValue{"proj", glm::ortho(0.0f, static_cast<float>(ctx.getSize().x), 0.0f, static_cast<float>(ctx.getSize().y))}
-               << UniformValue{"color", selection_color};
+        shader.setUniform(model_uniform, model_matrix)
+              .setUniform(proj_uniform, glm::ortho(0.0f, static_cast<float>(ctx.getSize().x), 0.0f, static_cast<float>(ctx.getSize().y)))
+              .setUniform(color_uniform, selection_color);
 
         shader.use();
 
@@ -96,10 +103,10 @@ void TextInstance::draw(Context& ctx, const Assets& assets) {
 
         setBlendingMode(ms::Blending::Text);
 
-        shader << UniformSampler{"bitmap", font->getTexture()}
-               << UniformValue{"model", model_matrix}
-               << UniformValue{"proj", glm::ortho(0.0f, static_cast<float>(ctx.getSize().x), 0.0f, static_cast<float>(ctx.getSize().y))}
-               << UniformValue{"color", color};
+        shader.setUniform(bitmap_uniform, font->getTexture())
+              .setUniform(model_uniform, model_matrix)
+              .setUniform(proj_uniform, glm::ortho(0.0f, static_cast<float>(ctx.getSize().x), 0.0f, static_cast<float>(ctx.getSize().y)))
+              .setUniform(color_uniform, color);
 
         shader.use();
 
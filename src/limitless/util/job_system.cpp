@@ -0,0 +1,229 @@
+#include <limitless/util/job_system.hpp>
+
+#include <iostream>
+
+using namespace Limitless;
+
+namespace {
+    // system and queue the current thread works for
+    thread_local const JobSystem* current_system {};
+    thread_local uint32_t current_index {};
+
+    // attempts to find a job before a worker goes to sleep
+    constexpr uint32_t idle_spin_count = 64;
+}
+
+void JobSystem::Queue::push(Job&& job) {
+    std::unique_lock lock(mutex);
+
+    if (count == jobs.size()) {
+        // unrolls ring into a bigger one
+        std::vector<Job> grown(std::max<size_t>(jobs.size() * 2, 64));
+        for (size_t i = 0; i < count; ++i) {
+            grown[i] = std::move(jobs[(head + i) % jobs.size()]);
+        }
+        jobs = std::move(grown);
+        head = 0;
+    }
+
+    jobs[(head + count) % jobs.size()] = std::move(job);
+    ++count;
+}
+
+bool JobSystem::Queue::popBack(Job& job) {
+    std::unique_lock lock(mutex);
+
+    if (count == 0) {
+        return false;
+    }
+
+    --count;
+    job = std::move(jobs[(head + count) % jobs.size()]);
+    return true;
+}
+
+bool JobSystem::Queue::popFront(Job& job) {
+    std::unique_lock lock(mutex);
+
+    if (count == 0) {
+        return false;
+    }
+
+    job = std::move(jobs[head]);
+    head = (head + 1) % jobs.size();
+    --count;
+    return true;
+}
+
+JobSystem::JobSystem(uint32_t thread_count)
+    : owner {std::this_thread::get_id()} {
+    thread_count = std::max(thread_count, 1u);
+
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        queues.emplace_back(std::make_unique<Queue>());
+    }
+
+    // creating thread owns the first queue
+    current_system = this;
+    current_index = 0;
+
+    for (uint32_t i = 1; i < thread_count; ++i) {
+        threads.emplace_back([this, i] { work(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::unique_lock lock(sleep_mutex);
+        stop = true;
+    }
+
+    sleep_condition.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // destructor cannot throw, the error is not lost silently though
+    if (detached_error) {
+        try {
+            std::rethrow_exception(detached_error);
+        } catch (const std::exception& e) {
+            std::cerr << "JobSystem: unhandled exception in job: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "JobSystem: unhandled exception in job" << std::endl;
+        }
+    }
+
+    if (current_system == this) {
+        current_system = nullptr;
+    }
+}
+
+uint32_t JobSystem::currentIndex() const noexcept {
+    return current_system == this ? current_index : next_foreign.load(std::memory_order_relaxed) % queues.size();
+}
+
+void JobSystem::run(Task task, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto index = current_system == this ? current_index : next_foreign.fetch_add(1, std::memory_order_relaxed) % getThreadCount();
+    queues[index]->push({std::move(task), counter});
+
+    queued.fetch_add(1);
+    if (sleeping.load() > 0) {
+        // lock makes sure that worker either sees the job or already waits for notification
+        { std::unique_lock lock(sleep_mutex); }
+        sleep_condition.notify_one();
+    }
+}
+
+bool JobSystem::take(uint32_t index, Job& job) {
+    if (queues[index]->popBack(job)) {
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    for (size_t i = 1; i < queues.size(); ++i) {
+        if (queues[(index + i) % queues.size()]->popFront(job)) {
+            queued.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void JobSystem::execute(Job& job) noexcept {
+    auto* counter = job.counter;
+
+    try {
+        job.task();
+    } catch (...) {
+        if (counter) {
+            if (!counter->failed.exchange(true)) {
+                counter->error = std::current_exception();
+            }
+        } else if (!detached_failed.load(std::memory_order_relaxed)) {
+            std::unique_lock lock(error_mutex);
+            if (!detached_error) {
+                detached_error = std::current_exception();
+                detached_failed.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    job.task = Task {};
+
+    if (counter) {
+        counter->pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void JobSystem::work(uint32_t index) {
+    current_system = this;
+    current_index = index;
+
+    Job job;
+    for (;;) {
+        uint32_t spins = 0;
+        while (spins < idle_spin_count) {
+            if (take(index, job)) {
+                execute(job);
+                spins = 0;
+            } else {
+                ++spins;
+                std::this_thread::yield();
+            }
+        }
+
+        std::unique_lock lock(sleep_mutex);
+        sleeping.fetch_add(1);
+        sleep_condition.wait(lock, [this] { return stop || queued.load() > 0; });
+        sleeping.fetch_sub(1);
+
+        if (stop) {
+            return;
+        }
+    }
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    const auto index = currentIndex();
+
+    Job job;
+    while (!counter.isDone()) {
+        if (take(index, job)) {
+            execute(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (counter.failed.exchange(false)) {
+        std::rethrow_exception(std::exchange(counter.error, nullptr));
+    }
+
+    if (std::this_thread::get_id() == owner) {
+        rethrowDetached();
+    }
+}
+
+void JobSystem::rethrowDetached() {
+    if (!detached_failed.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    std::exception_ptr error;
+    {
+        std::unique_lock lock(error_mutex);
+        error = std::exchange(detached_error, nullptr);
+        detached_failed.store(false, std::memory_order_relaxed);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
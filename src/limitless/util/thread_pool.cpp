@@ -36,7 +36,9 @@ void ThreadPool::joinAll() {
     condition.notify_all();
 
     for (auto& thread : threads) {
-        thread.join();
+        if (thread.joinable()) {
+            thread.join();
+        }
     }
 }
 
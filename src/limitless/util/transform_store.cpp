@@ -0,0 +1,270 @@
+#include <limitless/util/transform_store.hpp>
+
+#if defined(__SSE__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define LIMITLESS_TRANSFORM_SSE
+#endif
+
+using namespace Limitless;
+
+namespace {
+    // same layout as glm::toMat4(q) with columns scaled and translation in the last column
+    void composeTransform(float px, float py, float pz,
+                          float qx, float qy, float qz, float qw,
+                          float sx, float sy, float sz,
+                          glm::mat4& m) noexcept {
+        const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+        const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+        const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+        m[0] = glm::vec4{(1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f};
+        m[1] = glm::vec4{2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f};
+        m[2] = glm::vec4{2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f};
+        m[3] = glm::vec4{px, py, pz, 1.0f};
+    }
+
+    size_t roundUp(size_t size, size_t multiple) noexcept {
+        return (size + multiple - 1) / multiple * multiple;
+    }
+}
+
+void Limitless::composeTransforms(const float* px, const float* py, const float* pz,
+                                  const float* qx, const float* qy, const float* qz, const float* qw,
+                                  const float* sx, const float* sy, const float* sz,
+                                  glm::mat4* out, size_t count) noexcept {
+    size_t i = 0;
+
+#ifdef LIMITLESS_TRANSFORM_SSE
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    // four matrices at a time; each register holds one element of four matrices
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(qx + i);
+        const __m128 y = _mm_loadu_ps(qy + i);
+        const __m128 z = _mm_loadu_ps(qz + i);
+        const __m128 w = _mm_loadu_ps(qw + i);
+
+        const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        const __m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+        const __m128 scale_x = _mm_loadu_ps(sx + i);
+        const __m128 scale_y = _mm_loadu_ps(sy + i);
+        const __m128 scale_z = _mm_loadu_ps(sz + i);
+
+        __m128 c0r0 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), scale_x);
+        __m128 c0r1 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), scale_x);
+        __m128 c0r2 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), scale_x);
+        __m128 c0r3 = _mm_setzero_ps();
+
+        __m128 c1r0 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), scale_y);
+        __m128 c1r1 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), scale_y);
+        __m128 c1r2 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), scale_y);
+        __m128 c1r3 = _mm_setzero_ps();
+
+        __m128 c2r0 = _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), scale_z);
+        __m128 c2r1 = _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), scale_z);
+        __m128 c2r2 = _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), scale_z);
+        __m128 c2r3 = _mm_setzero_ps();
+
+        __m128 c3r0 = _mm_loadu_ps(px + i);
+        __m128 c3r1 = _mm_loadu_ps(py + i);
+        __m128 c3r2 = _mm_loadu_ps(pz + i);
+        __m128 c3r3 = one;
+
+        // after transposing register k holds the column of matrix k
+        _MM_TRANSPOSE4_PS(c0r0, c0r1, c0r2, c0r3);
+        _MM_TRANSPOSE4_PS(c1r0, c1r1, c1r2, c1r3);
+        _MM_TRANSPOSE4_PS(c2r0, c2r1, c2r2, c2r3);
+        _MM_TRANSPOSE4_PS(c3r0, c3r1, c3r2, c3r3);
+
+        const __m128 columns[4][4] = {
+            {c0r0, c1r0, c2r0, c3r0},
+            {c0r1, c1r1, c2r1, c3r1},
+            {c0r2, c1r2, c2r2, c3r2},
+            {c0r3, c1r3, c2r3, c3r3},
+        };
+
+        for (size_t k = 0; k < 4; ++k) {
+            auto* m = &out[i + k][0][0];
+            _mm_storeu_ps(m + 0, columns[k][0]);
+            _mm_storeu_ps(m + 4, columns[k][1]);
+            _mm_storeu_ps(m + 8, columns[k][2]);
+            _mm_storeu_ps(m + 12, columns[k][3]);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        composeTransform(px[i], py[i], pz[i], qx[i], qy[i], qz[i], qw[i], sx[i], sy[i], sz[i], out[i]);
+    }
+}
+
+void TransformStore::resize(size_t size) {
+    // padded to whole batches so that update never has to deal with partial ones
+    const auto padded = roundUp(size, batch);
+
+    for (auto* component : {&px, &py, &pz, &qx, &qy, &qz}) {
+        component->resize(padded, 0.0f);
+    }
+    for (auto* component : {&qw, &sx, &sy, &sz}) {
+        component->resize(padded, 1.0f);
+    }
+
+    matrices.resize(padded, glm::mat4{1.0f});
+    dirty.resize(padded, 0);
+}
+
+TransformStore::Handle TransformStore::allocate(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+    assert(!locked);
+
+    Handle handle;
+    if (free_handles.empty()) {
+        handle = static_cast<Handle>(sparse.size());
+        sparse.emplace_back();
+    } else {
+        handle = free_handles.back();
+        free_handles.pop_back();
+    }
+
+    const auto index = static_cast<uint32_t>(handles.size());
+    sparse[handle] = index;
+    handles.emplace_back(handle);
+
+    if (px.size() < handles.size()) {
+        resize(handles.size());
+    }
+
+    setPosition(handle, position);
+    setRotation(handle, rotation);
+    setScale(handle, scale);
+
+    return handle;
+}
+
+void TransformStore::release(Handle handle) noexcept {
+    assert(!locked);
+
+    const auto index = sparse[handle];
+    const auto last = static_cast<uint32_t>(handles.size() - 1);
+
+    // keeps entries dense by moving the last one into the gap
+    if (index != last) {
+        px[index] = px[last]; py[index] = py[last]; pz[index] = pz[last];
+        qx[index] = qx[last]; qy[index] = qy[last]; qz[index] = qz[last]; qw[index] = qw[last];
+        sx[index] = sx[last]; sy[index] = sy[last]; sz[index] = sz[last];
+        matrices[index] = matrices[last];
+
+        dirty[index] = dirty[last];
+        dirty[last] = 0;
+
+        handles[index] = handles[last];
+        sparse[handles[index]] = index;
+    }
+
+    handles.pop_back();
+    free_handles.emplace_back(handle);
+}
+
+void TransformStore::clear() noexcept {
+    assert(!locked);
+
+    px.clear(); py.clear(); pz.clear();
+    qx.clear(); qy.clear(); qz.clear(); qw.clear();
+    sx.clear(); sy.clear(); sz.clear();
+    matrices.clear();
+    dirty.clear();
+    sparse.clear();
+    handles.clear();
+    free_handles.clear();
+}
+
+void TransformStore::setPosition(Handle handle, const glm::vec3& position) noexcept {
+    assert(!locked);
+
+    const auto index = sparse[handle];
+    px[index] = position.x;
+    py[index] = position.y;
+    pz[index] = position.z;
+    markDirty(index);
+}
+
+void TransformStore::setRotation(Handle handle, const glm::quat& rotation) noexcept {
+    assert(!locked);
+
+    const auto index = sparse[handle];
+    qx[index] = rotation.x;
+    qy[index] = rotation.y;
+    qz[index] = rotation.z;
+    qw[index] = rotation.w;
+    markDirty(index);
+}
+
+void TransformStore::setScale(Handle handle, const glm::vec3& scale) noexcept {
+    assert(!locked);
+
+    const auto index = sparse[handle];
+    sx[index] = scale.x;
+    sy[index] = scale.y;
+    sz[index] = scale.z;
+    markDirty(index);
+}
+
+glm::vec3 TransformStore::getPosition(Handle handle) const noexcept {
+    const auto index = sparse[handle];
+    return {px[index], py[index], pz[index]};
+}
+
+glm::quat TransformStore::getRotation(Handle handle) const noexcept {
+    const auto index = sparse[handle];
+    return {qw[index], qx[index], qy[index], qz[index]};
+}
+
+glm::vec3 TransformStore::getScale(Handle handle) const noexcept {
+    const auto index = sparse[handle];
+    return {sx[index], sy[index], sz[index]};
+}
+
+size_t TransformStore::update() noexcept {
+    assert(!locked);
+
+    const auto used_batches = roundUp(handles.size(), batch) / batch;
+    size_t composed = 0;
+
+    // counts and clears dirty entries of a batch, returns whether there were any
+    const auto takeBatch = [&] (size_t index) noexcept {
+        size_t count = 0;
+        for (size_t i = index * batch; i < (index + 1) * batch; ++i) {
+            count += dirty[i];
+            dirty[i] = 0;
+        }
+        composed += count;
+        return count != 0;
+    };
+
+    // recomposes consecutive runs of dirty batches with one kernel call each
+    for (size_t begin = 0; begin < used_batches; ) {
+        if (!takeBatch(begin)) {
+            ++begin;
+            continue;
+        }
+
+        auto end = begin + 1;
+        while (end < used_batches && takeBatch(end)) {
+            ++end;
+        }
+
+        const auto first = begin * batch;
+        const auto count = (end - begin) * batch;
+
+        composeTransforms(&px[first], &py[first], &pz[first],
+                          &qx[first], &qy[first], &qz[first], &qw[first],
+                          &sx[first], &sy[first], &sz[first],
+                          &matrices[first], count);
+
+        begin = end;
+    }
+
+    return composed;
+}
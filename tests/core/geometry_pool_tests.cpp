@@ -0,0 +1,78 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/geometry_pool.hpp>
+
+using namespace Limitless;
+
+namespace {
+    std::vector<GLuint> readIndices(const GeometryPool& pool, const GeometryPool::Range& range) {
+        std::vector<GLuint> indices(range.count);
+
+        glBindBuffer(GL_COPY_READ_BUFFER, pool.getIndexBuffer()->getId());
+        glGetBufferSubData(GL_COPY_READ_BUFFER, range.offset * sizeof(GLuint), range.count * sizeof(GLuint), indices.data());
+
+        return indices;
+    }
+}
+
+TEST_CASE("GeometryPool reuses and merges freed ranges") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    GeometryPool pool {getVertexFormat(Vertex{}), 16, 16};
+
+    const std::vector<Vertex> vertices(4);
+    const std::vector<GLuint> indices = {0, 1, 2, 2, 3, 0};
+
+    const auto first = pool.allocate(vertices.data(), 4, indices.data(), 6);
+    const auto second = pool.allocate(vertices.data(), 4, indices.data(), 6);
+
+    REQUIRE(pool.get(first).vertices.offset == 0);
+    REQUIRE(pool.get(second).vertices.offset == 4);
+    REQUIRE(pool.get(second).indices.offset == 6);
+
+    pool.free(first);
+
+    // released range is reused by allocation of the same size
+    const auto third = pool.allocate(vertices.data(), 4, indices.data(), 6);
+    REQUIRE(pool.get(third).vertices.offset == 0);
+
+    pool.free(third);
+    pool.free(second);
+
+    const auto stats = pool.getStats();
+    REQUIRE(stats.allocation_count == 0);
+    REQUIRE(stats.vertex_used == 0);
+    REQUIRE(stats.free_range_count == 2);
+
+    check_opengl_state();
+}
+
+TEST_CASE("GeometryPool keeps geometry when compacted") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    GeometryPool pool {getVertexFormat(Vertex{}), 8, 8};
+
+    const std::vector<Vertex> vertices(4);
+    const std::vector<GLuint> first_indices = {0, 1, 2, 3};
+    const std::vector<GLuint> second_indices = {4, 5, 6, 7};
+
+    const auto first = pool.allocate(vertices.data(), 4, first_indices.data(), 4);
+    const auto second = pool.allocate(vertices.data(), 4, second_indices.data(), 4);
+
+    pool.free(first);
+    pool.defragment();
+
+    REQUIRE(pool.get(second).indices.offset == 0);
+    REQUIRE(readIndices(pool, pool.get(second).indices) == second_indices);
+
+    // does not fit into current storage, so it grows
+    const auto third = pool.allocate(vertices.data(), 8, first_indices.data(), 4);
+    REQUIRE(pool.getStats().vertex_capacity == 16 * sizeof(Vertex));
+    REQUIRE(readIndices(pool, pool.get(second).indices) == second_indices);
+    REQUIRE(readIndices(pool, pool.get(third).indices) == first_indices);
+
+    check_opengl_state();
+}
@@ -0,0 +1,170 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/ms/material_storage.hpp>
+#include <cstring>
+
+using namespace Limitless;
+using namespace Limitless::ms;
+
+namespace {
+    constexpr size_t block_size = sizeof(glm::vec4);
+
+    void write(MaterialStorage& storage, uint32_t slot, const glm::vec4& value) {
+        std::byte block[block_size];
+        std::memcpy(block, &value, block_size);
+        storage.write(slot, block);
+    }
+
+    glm::vec4 read(const MaterialStorage& storage, uint32_t slot) {
+        glm::vec4 value;
+        storage.getBuffer()->bindAs(Buffer::Type::Uniform);
+        glGetBufferSubData(GL_UNIFORM_BUFFER, static_cast<GLintptr>(slot * storage.getStride()), block_size, &value);
+        return value;
+    }
+}
+
+TEST_CASE("Context shares material storage between blocks of the same size") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    auto storage = context.getMaterialStorage(block_size);
+    REQUIRE(storage == context.getMaterialStorage(block_size));
+    REQUIRE(storage != context.getMaterialStorage(block_size * 2));
+
+    // stride keeps every block at valid offset of uniform buffer range
+    const auto alignment = static_cast<size_t>(ContextInitializer::limits.uniform_buffer_alignment);
+    REQUIRE(storage->getStride() >= block_size);
+    REQUIRE(storage->getStride() % alignment == 0);
+
+    // storage is released with its last block
+    const std::weak_ptr<MaterialStorage> released = storage;
+    storage.reset();
+    REQUIRE(released.expired());
+
+    check_opengl_state();
+}
+
+TEST_CASE("MaterialStorage fills freed slots before growing") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto storage = context.getMaterialStorage(block_size);
+
+    const auto first = storage->allocate();
+    const auto second = storage->allocate();
+    const auto third = storage->allocate();
+    REQUIRE(first == 0);
+    REQUIRE(second == 1);
+    REQUIRE(third == 2);
+    REQUIRE(storage->getSlotCount() == 3);
+
+    storage->free(second);
+    REQUIRE(storage->getSlotCount() == 2);
+
+    REQUIRE(storage->allocate() == second);
+    REQUIRE(storage->allocate() == 3);
+    REQUIRE(storage->getSlotCount() == 4);
+
+    {
+        MaterialBlock block {storage};
+        REQUIRE(block.getSlot() == 4);
+        REQUIRE(block.isChanged());
+        REQUIRE(storage->getSlotCount() == 5);
+    }
+
+    // slot of destroyed block is taken by the next one
+    REQUIRE(storage->getSlotCount() == 4);
+    MaterialBlock block {storage};
+    REQUIRE(block.getSlot() == 4);
+
+    check_opengl_state();
+}
+
+TEST_CASE("MaterialStorage uploads written blocks on bind") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto storage = context.getMaterialStorage(block_size);
+
+    const auto first = storage->allocate();
+    const auto second = storage->allocate();
+    const auto third = storage->allocate();
+
+    write(*storage, first, glm::vec4{1.0f});
+    write(*storage, third, glm::vec4{3.0f});
+    storage->bind(first, 0);
+
+    REQUIRE(read(*storage, first) == glm::vec4{1.0f});
+    REQUIRE(read(*storage, third) == glm::vec4{3.0f});
+
+    // blocks between written ones keep their data
+    write(*storage, second, glm::vec4{2.0f});
+    storage->bind(second, 0);
+
+    REQUIRE(read(*storage, first) == glm::vec4{1.0f});
+    REQUIRE(read(*storage, second) == glm::vec4{2.0f});
+    REQUIRE(read(*storage, third) == glm::vec4{3.0f});
+
+    // growing storage recreates buffer with all blocks
+    std::vector<uint32_t> slots;
+    for (int i = 0; i < 100; ++i) {
+        slots.emplace_back(storage->allocate());
+    }
+    write(*storage, slots.back(), glm::vec4{4.0f});
+    storage->bind(slots.back(), 0);
+
+    REQUIRE(storage->getBuffer()->getSize() >= (slots.back() + 1) * storage->getStride());
+    REQUIRE(read(*storage, first) == glm::vec4{1.0f});
+    REQUIRE(read(*storage, third) == glm::vec4{3.0f});
+    REQUIRE(read(*storage, slots.back()) == glm::vec4{4.0f});
+
+    check_opengl_state();
+}
+
+TEST_CASE("MaterialBlock commits mapped data to its slot") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto storage = context.getMaterialStorage(block_size);
+
+    MaterialBlock first {storage};
+    MaterialBlock second {storage};
+
+    const glm::vec4 value {0.5f, 0.25f, 0.125f, 1.0f};
+    std::memcpy(second.write(), &value, block_size);
+    REQUIRE_FALSE(second.isChanged());
+
+    second.commit();
+    second.bind(0);
+
+    REQUIRE(read(*storage, second.getSlot()) == value);
+    REQUIRE(read(*storage, first.getSlot()) == glm::vec4{0.0f});
+
+    check_opengl_state();
+}
+
+TEST_CASE("MaterialStorage binds batch of blocks from slot") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    auto storage = context.getMaterialStorage(block_size);
+
+    // batched shaders index blocks with std140 array stride
+    REQUIRE(storage->getStride() % 16 == 0);
+    REQUIRE(storage->getBatchSize() >= 1);
+    REQUIRE(storage->getBatchSize() * storage->getStride() <= static_cast<size_t>(ContextInitializer::limits.uniform_block_max_size));
+
+    const auto first = storage->allocate();
+    const auto second = storage->allocate();
+    write(*storage, first, glm::vec4{1.0f});
+    write(*storage, second, glm::vec4{2.0f});
+
+    // range of the last slot fits into buffer as well
+    storage->bindBatch(second, 0);
+
+    GLint64 start {}, size {};
+    glGetInteger64i_v(GL_UNIFORM_BUFFER_START, 0, &start);
+    glGetInteger64i_v(GL_UNIFORM_BUFFER_SIZE, 0, &size);
+
+    REQUIRE(static_cast<size_t>(start) == second * storage->getStride());
+    REQUIRE(static_cast<size_t>(size) == storage->getBatchSize() * storage->getStride());
+    REQUIRE(storage->getBuffer()->getSize() >= static_cast<size_t>(start + size));
+    REQUIRE(read(*storage, second) == glm::vec4{2.0f});
+
+    check_opengl_state();
+}
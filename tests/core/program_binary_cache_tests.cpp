@@ -0,0 +1,172 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/shader.hpp>
+#include <limitless/core/program_binary_cache.hpp>
+#include <fstream>
+
+using namespace Limitless;
+
+namespace {
+    const auto test_dir = fs::temp_directory_path() / "limitless_program_binary_cache_tests";
+
+    fs::path writeFile(const std::string& name, const std::string& text) {
+        fs::create_directories(test_dir);
+
+        const auto path = test_dir / name;
+        std::ofstream(path) << text;
+        return path;
+    }
+
+    std::vector<Shader> makeShaders(const std::string& color) {
+        const auto vertex = writeFile("cache_" + color + ".vs", "#version 330 core\nvoid main() { gl_Position = vec4(0.0); }\n");
+        const auto fragment = writeFile("cache_" + color + ".fs", "#version 330 core\nout vec4 color;\nvoid main() { color = vec4(" + color + "); }\n");
+
+        std::vector<Shader> shaders;
+        shaders.emplace_back(vertex, Shader::Type::Vertex);
+        shaders.emplace_back(fragment, Shader::Type::Fragment);
+        return shaders;
+    }
+
+    GLuint link(const std::vector<Shader>& shaders) {
+        const auto program_id = glCreateProgram();
+        for (const auto& shader : shaders) {
+            shader.compile();
+            glAttachShader(program_id, shader.getId());
+        }
+
+        glProgramParameteri(program_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        glLinkProgram(program_id);
+
+        for (const auto& shader : shaders) {
+            glDetachShader(program_id, shader.getId());
+        }
+        return program_id;
+    }
+
+    bool isLinked(GLuint program_id) {
+        GLint status = GL_FALSE;
+        glGetProgramiv(program_id, GL_LINK_STATUS, &status);
+        return status == GL_TRUE;
+    }
+
+    std::vector<fs::path> getBinaries(const ProgramBinaryCache& cache) {
+        std::vector<fs::path> binaries;
+        for (const auto& entry : fs::directory_iterator(cache.getDirectory())) {
+            if (entry.path().extension() == ".bin") {
+                binaries.emplace_back(entry.path());
+            }
+        }
+        return binaries;
+    }
+}
+
+TEST_CASE("ProgramBinaryCache keys programs by their sources") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    const ProgramBinaryCache cache {test_dir / "keys"};
+
+    const auto white = makeShaders("1.0");
+    const auto black = makeShaders("0.0");
+
+    REQUIRE(cache.getKey(white) == cache.getKey(makeShaders("1.0")));
+    REQUIRE(cache.getKey(white) != cache.getKey(black));
+
+    // the same source of another stage makes another program
+    std::vector<Shader> vertex;
+    vertex.emplace_back(test_dir / "cache_1.0.vs", Shader::Type::Vertex);
+    std::vector<Shader> fragment;
+    fragment.emplace_back(test_dir / "cache_1.0.vs", Shader::Type::Fragment);
+    REQUIRE(cache.getKey(vertex) != cache.getKey(fragment));
+
+    check_opengl_state();
+}
+
+TEST_CASE("ProgramBinaryCache restores stored program") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    if (!ProgramBinaryCache::isSupported()) {
+        WARN("Program binaries are not supported by context");
+        return;
+    }
+
+    const ProgramBinaryCache cache {test_dir / "restore"};
+    cache.clear();
+
+    const auto shaders = makeShaders("1.0");
+    const auto key = cache.getKey(shaders);
+    REQUIRE(cache.load(key) == 0);
+
+    const auto program_id = link(shaders);
+    REQUIRE(isLinked(program_id));
+    cache.store(key, program_id);
+    glDeleteProgram(program_id);
+    REQUIRE(getBinaries(cache).size() == 1);
+
+    const auto loaded = cache.load(key);
+    REQUIRE(loaded != 0);
+    REQUIRE(isLinked(loaded));
+    glDeleteProgram(loaded);
+
+    // cache of another directory does not see the binary
+    const ProgramBinaryCache other {test_dir / "other"};
+    other.clear();
+    REQUIRE(other.load(key) == 0);
+
+    cache.clear();
+    REQUIRE(getBinaries(cache).size() == 0);
+    REQUIRE(cache.load(key) == 0);
+
+    check_opengl_state();
+}
+
+TEST_CASE("ProgramBinaryCache removes binary stored for another key") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    if (!ProgramBinaryCache::isSupported()) {
+        WARN("Program binaries are not supported by context");
+        return;
+    }
+
+    const ProgramBinaryCache cache {test_dir / "mismatch"};
+    cache.clear();
+
+    const auto white = makeShaders("1.0");
+    const auto black = makeShaders("0.0");
+    const auto white_key = cache.getKey(white);
+    const auto black_key = cache.getKey(black);
+
+    const auto white_id = link(white);
+    cache.store(white_key, white_id);
+    glDeleteProgram(white_id);
+
+    REQUIRE(getBinaries(cache).size() == 1);
+    const auto white_path = getBinaries(cache).front();
+
+    const auto black_id = link(black);
+    cache.store(black_key, black_id);
+    glDeleteProgram(black_id);
+
+    const auto binaries = getBinaries(cache);
+    REQUIRE(binaries.size() == 2);
+    const auto black_path = binaries.front() == white_path ? binaries.back() : binaries.front();
+
+    // file of one key put in place of another one, as colliding or copied file would be
+    fs::copy_file(white_path, black_path, fs::copy_options::overwrite_existing);
+
+    REQUIRE(cache.load(black_key) == 0);
+    REQUIRE_FALSE(fs::exists(black_path));
+
+    // binary of matching key stays valid
+    const auto loaded = cache.load(white_key);
+    REQUIRE(loaded != 0);
+    glDeleteProgram(loaded);
+
+    // truncated binary is rejected and removed as well
+    fs::resize_file(white_path, 8);
+    REQUIRE(cache.load(white_key) == 0);
+    REQUIRE_FALSE(fs::exists(white_path));
+
+    check_opengl_state();
+}
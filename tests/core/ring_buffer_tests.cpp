@@ -0,0 +1,94 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/ring_buffer.hpp>
+#include <array>
+
+using namespace Limitless;
+
+namespace {
+    std::vector<int> readRange(const RingBuffer::Allocation& allocation, size_t count) {
+        std::vector<int> data(count);
+        allocation.buffer->bindAs(Buffer::Type::Array);
+        glGetBufferSubData(GL_ARRAY_BUFFER, allocation.offset, static_cast<GLsizeiptr>(count * sizeof(int)), data.data());
+        return data;
+    }
+}
+
+TEST_CASE("RingBuffer aligns uploads for their targets") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    RingBuffer ring;
+    ring.beginFrame();
+
+    const std::array<int, 3> data {1, 2, 3};
+
+    const auto first = ring.upload(Buffer::Type::Uniform, data.data(), sizeof(data));
+    const auto second = ring.upload(Buffer::Type::Uniform, data.data(), sizeof(data));
+    const auto third = ring.upload(Buffer::Type::ShaderStorage, data.data(), sizeof(data));
+
+    REQUIRE(first.offset % ContextInitializer::limits.uniform_buffer_alignment == 0);
+    REQUIRE(second.offset % ContextInitializer::limits.uniform_buffer_alignment == 0);
+    REQUIRE(third.offset % ContextInitializer::limits.shader_storage_alignment == 0);
+    REQUIRE(second.offset > first.offset);
+    REQUIRE(third.offset > second.offset);
+
+    REQUIRE(readRange(second, 3) == std::vector<int>{1, 2, 3});
+
+    ring.endFrame();
+
+    check_opengl_state();
+}
+
+TEST_CASE("RingBuffer keeps frames in separate segments") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    RingBuffer ring;
+    std::vector<RingBuffer::Allocation> allocations;
+
+    for (int frame = 0; frame < static_cast<int>(RingBuffer::segment_count) * 2; ++frame) {
+        ring.beginFrame();
+
+        const auto allocation = ring.upload(Buffer::Type::Uniform, &frame, sizeof(frame));
+        REQUIRE(ring.isValid(allocation));
+        REQUIRE(readRange(allocation, 1) == std::vector<int>{frame});
+
+        allocations.push_back(allocation);
+
+        ring.endFrame();
+
+        REQUIRE_FALSE(ring.isValid(allocation));
+    }
+
+    // segment is reused every segment_count frames
+    REQUIRE(allocations[0].offset == allocations[RingBuffer::segment_count].offset);
+    REQUIRE(allocations[0].offset != allocations[1].offset);
+
+    check_opengl_state();
+}
+
+TEST_CASE("RingBuffer grows when frame does not fit its segment") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    RingBuffer ring {1024};
+    ring.beginFrame();
+
+    const std::vector<int> small(16, 7);
+    const std::vector<int> large(1024, 9);
+
+    const auto first = ring.upload(Buffer::Type::ShaderStorage, small.data(), small.size() * sizeof(int));
+    const auto second = ring.upload(Buffer::Type::ShaderStorage, large.data(), large.size() * sizeof(int));
+
+    REQUIRE(ring.getSegmentSize() >= large.size() * sizeof(int));
+    REQUIRE(first.buffer != second.buffer);
+
+    // ranges uploaded before growth are still there until the end of frame
+    REQUIRE(readRange(first, small.size()) == small);
+    REQUIRE(readRange(second, large.size()) == large);
+
+    ring.endFrame();
+
+    check_opengl_state();
+}
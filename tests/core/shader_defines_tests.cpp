@@ -0,0 +1,73 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/ms/material_compiler.hpp>
+#include <limitless/pipeline/render_settings.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    bool has(const std::vector<std::string>& defines, const std::string& name) {
+        return std::find(defines.begin(), defines.end(), name) != defines.end();
+    }
+}
+
+TEST_CASE("Source refers to define only outside of its own definition") {
+    REQUIRE(ShaderCompiler::refersTo("#ifdef PBR\n#endif\n", "PBR"));
+    REQUIRE(ShaderCompiler::refersTo("#if defined(PBR) || defined(NORMAL_MAPPING)\n", "NORMAL_MAPPING"));
+    REQUIRE(ShaderCompiler::refersTo("float splits[DIRECTIONAL_SPLIT_COUNT];\n", "DIRECTIONAL_SPLIT_COUNT"));
+
+    // settings block defines every flag, that is not a use
+    REQUIRE_FALSE(ShaderCompiler::refersTo("#define PBR\n", "PBR"));
+    REQUIRE_FALSE(ShaderCompiler::refersTo("#define  DIRECTIONAL_SPLIT_COUNT 3\n", "DIRECTIONAL_SPLIT_COUNT"));
+
+    // names that only contain define are not counted
+    REQUIRE_FALSE(ShaderCompiler::refersTo("#ifdef PBR_TEXTURE\n", "PBR"));
+    REQUIRE_FALSE(ShaderCompiler::refersTo("#ifdef BLINN_PHONG_MODEL\n", "PHONG_MODEL"));
+    REQUIRE_FALSE(ShaderCompiler::refersTo("#define BLINN_PHONG_MODEL\n", "PHONG_MODEL"));
+
+    // definition does not hide later use
+    REQUIRE(ShaderCompiler::refersTo("#define PBR\n#ifdef PBR\n#endif\n", "PBR"));
+}
+
+TEST_CASE("MaterialCompiler reports defines changed between settings") {
+    RenderSettings previous;
+    RenderSettings settings;
+
+    REQUIRE(ms::MaterialCompiler::getChangedDefines(previous, settings).empty());
+
+    // settings that are not defines do not change any
+    settings.batching = !settings.batching;
+    settings.directional_shadow_resolution = {512, 512};
+    REQUIRE(ms::MaterialCompiler::getChangedDefines(previous, settings).empty());
+
+    settings = previous;
+    settings.directional_pcf = !previous.directional_pcf;
+    settings.shading_model = previous.shading_model == ShadingModel::Phong ? ShadingModel::BlinnPhong : ShadingModel::Phong;
+
+    auto changed = ms::MaterialCompiler::getChangedDefines(previous, settings);
+    REQUIRE(changed.size() == 3);
+    REQUIRE(has(changed, "DIRECTIONAL_PFC"));
+    REQUIRE(has(changed, "PHONG_MODEL"));
+    REQUIRE(has(changed, "BLINN_PHONG_MODEL"));
+
+    // value of define changes
+    settings = previous;
+    settings.directional_split_count = previous.directional_split_count + 1;
+    changed = ms::MaterialCompiler::getChangedDefines(previous, settings);
+    REQUIRE(changed == std::vector<std::string>{"DIRECTIONAL_SPLIT_COUNT"});
+
+    settings = previous;
+    settings.physically_based_render = !previous.physically_based_render;
+    changed = ms::MaterialCompiler::getChangedDefines(previous, settings);
+    REQUIRE(changed == std::vector<std::string>{"PBR"});
+
+    // cascades off remove split count and filtering with them
+    settings = previous;
+    settings.directional_csm = false;
+    changed = ms::MaterialCompiler::getChangedDefines(previous, settings);
+    REQUIRE(has(changed, "DIRECTIONAL_CSM"));
+    REQUIRE(has(changed, "DIRECTIONAL_SPLIT_COUNT"));
+    REQUIRE(changed == ms::MaterialCompiler::getChangedDefines(settings, previous));
+}
@@ -0,0 +1,112 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/shader.hpp>
+#include <limitless/core/shader_source_cache.hpp>
+#include <algorithm>
+#include <fstream>
+
+using namespace Limitless;
+
+namespace {
+    const auto shader_dir = (fs::temp_directory_path() / "limitless_shader_source_tests").lexically_normal();
+
+    fs::path writeFile(const std::string& name, const std::string& text) {
+        fs::create_directories(shader_dir);
+
+        const auto path = shader_dir / name;
+        std::ofstream(path) << text;
+        return path;
+    }
+
+    // file system time may be too coarse to notice quick edits
+    void touch(const fs::path& path) {
+        fs::last_write_time(path, fs::last_write_time(path) + std::chrono::hours(1));
+    }
+
+    bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+}
+
+TEST_CASE("Shader expands keys in one pass") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    ShaderSourceCache::clear();
+
+    writeFile("keys.glsl", "Limitless::ModelType\n");
+    const auto path = writeFile("keys.vs", "Limitless::GLSL_VERSION\n#include \"keys.glsl\"\nLimitless::Unknown\nLimitless::Nested\nvoid main() {}\n");
+
+    Shader shader {path, Shader::Type::Vertex, [] (Shader& s) {
+        s.replaceKey("Limitless::ModelType", "#define SIMPLE_MODEL\n");
+        // values are not scanned for keys again
+        s.replaceKey("Limitless::Nested", "Limitless::ModelType");
+    }};
+
+    const auto& source = shader.getSource();
+
+    // keys inside included files are expanded too
+    REQUIRE(contains(source, "#define SIMPLE_MODEL"));
+    REQUIRE_FALSE(contains(source, "#include"));
+    REQUIRE_FALSE(contains(source, "Limitless::GLSL_VERSION"));
+
+    // unknown keys are left for later replacement
+    REQUIRE(contains(source, "Limitless::Unknown"));
+    REQUIRE(contains(source, "Limitless::ModelType"));
+
+    // keys replaced after construction are expanded right away
+    shader.replaceKey("Limitless::Unknown", "#define LATE\n");
+    REQUIRE(contains(shader.getSource(), "#define LATE"));
+    REQUIRE_FALSE(contains(shader.getSource(), "Limitless::Unknown"));
+
+    const auto& dependencies = shader.getDependencies();
+    REQUIRE(dependencies.size() == 2);
+    REQUIRE(std::find(dependencies.begin(), dependencies.end(), (shader_dir / "keys.glsl").lexically_normal()) != dependencies.end());
+
+    check_opengl_state();
+}
+
+TEST_CASE("ShaderSourceCache invalidates sources that include changed file") {
+    ShaderSourceCache::clear();
+
+    const auto common = writeFile("common.glsl", "float common_value;\n");
+    const auto nested = writeFile("nested.glsl", "#include \"common.glsl\"\n");
+    const auto first = writeFile("first.vs", "#include \"nested.glsl\"\nvoid main() {}\n");
+    const auto second = writeFile("second.vs", "void main() {}\n");
+
+    REQUIRE(contains(ShaderSourceCache::get(first).text, "common_value"));
+    REQUIRE(ShaderSourceCache::get(first).files.size() == 3);
+    REQUIRE(ShaderSourceCache::get(second).files.size() == 1);
+
+    REQUIRE(ShaderSourceCache::update().empty());
+
+    // second.vs changes without its time, cached source of it stays
+    const auto second_time = fs::last_write_time(second);
+    writeFile("second.vs", "void main() { changed(); }\n");
+    fs::last_write_time(second, second_time);
+
+    writeFile("common.glsl", "float edited_value;\n");
+    touch(common);
+
+    const auto changed = ShaderSourceCache::update();
+    REQUIRE(changed.size() == 1);
+    REQUIRE(changed.front() == common.lexically_normal());
+
+    // nested include is invalidated as well
+    REQUIRE(contains(ShaderSourceCache::get(first).text, "edited_value"));
+    REQUIRE_FALSE(contains(ShaderSourceCache::get(second).text, "changed"));
+
+    // deleted file keeps its text until it appears again
+    fs::remove(nested);
+    REQUIRE(ShaderSourceCache::update().empty());
+    REQUIRE(contains(ShaderSourceCache::get(first).text, "edited_value"));
+
+    writeFile("nested.glsl", "float restored_value;\n");
+    touch(nested);
+
+    REQUIRE(ShaderSourceCache::update().size() == 1);
+    REQUIRE(contains(ShaderSourceCache::get(first).text, "restored_value"));
+
+    ShaderSourceCache::clear();
+}
@@ -0,0 +1,63 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/triple_buffer.hpp>
+#include <array>
+
+using namespace Limitless;
+
+TEST_CASE("Buffers used during frame share single fence") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    const std::array<int, 4> data {1, 2, 3, 4};
+
+    TripleBuffer first {Buffer::Type::Array, sizeof(data), data.data()};
+    TripleBuffer second {Buffer::Type::Array, sizeof(data), data.data()};
+
+    const auto& fence = context.getFrameFence();
+    REQUIRE_FALSE(fence->isPlaced());
+
+    first.fence();
+    second.fence();
+    first.fence();
+
+    // users keep fence alive until they wait for it
+    REQUIRE(fence.use_count() == 3);
+
+    context.fenceFrame();
+
+    REQUIRE(context.getFrameFence() != nullptr);
+    REQUIRE_FALSE(context.getFrameFence()->isPlaced());
+
+    check_opengl_state();
+}
+
+TEST_CASE("Waiting for fence of current frame places it") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    context.resetSyncStats();
+
+    const std::array<int, 4> data {1, 2, 3, 4};
+
+    TripleBuffer buffer {Buffer::Type::Array, sizeof(data), data.data()};
+
+    const auto fence = context.getFrameFence();
+
+    // every region is mapped once, so the next map waits for the first region
+    for (uint8_t i = 0; i <= TripleBuffer::region_count; ++i) {
+        buffer.mapData(data.data(), sizeof(data));
+        buffer.fence();
+    }
+
+    REQUIRE(fence->isPlaced());
+    REQUIRE(context.getFrameFence() != fence);
+
+    const auto& stats = context.getSyncStats();
+    REQUIRE(stats.waits == 1);
+    REQUIRE(stats.failures == 0);
+    REQUIRE(stats.stall_time >= std::chrono::nanoseconds{0});
+
+    check_opengl_state();
+}
@@ -3,6 +3,8 @@
 #include "../opengl_debug.hpp"
 
 #include <limitless/core/context.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/texture_binder.hpp>
 
 using namespace Limitless;
 
@@ -99,3 +101,61 @@ TEST_CASE("StateTexture bind") {
     check_opengl_state();
 }
 
+namespace {
+    std::shared_ptr<Texture> makeTexture() {
+        TextureBuilder builder;
+        return builder.setTarget(Texture::Type::Tex2D)
+                      .setInternalFormat(Texture::InternalFormat::RGBA8)
+                      .setSize(glm::uvec2{1})
+                      .setFormat(Texture::Format::RGBA)
+                      .setDataType(Texture::DataType::UnsignedByte)
+                      .build();
+    }
+}
+
+TEST_CASE("TextureBinder keeps units of bound textures") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    const auto first = makeTexture();
+    const auto second = makeTexture();
+
+    const auto units = TextureBinder::bind({first.get(), second.get()});
+    REQUIRE(units[0] != units[1]);
+    REQUIRE(context.getTextureBound().at(units[0]) == first->getId());
+    REQUIRE(context.getTextureBound().at(units[1]) == second->getId());
+
+    // bound textures stay on their units in any order
+    REQUIRE(TextureBinder::bind({second.get(), first.get()}) == std::vector<GLint>{units[1], units[0]});
+
+    check_opengl_state();
+}
+
+TEST_CASE("TextureBinder evicts least recently used unit") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    const auto unit_count = static_cast<size_t>(ContextInitializer::limits.max_texture_units);
+
+    std::vector<std::shared_ptr<Texture>> textures;
+    std::vector<Texture*> set;
+    for (size_t i = 0; i < unit_count; ++i) {
+        textures.emplace_back(makeTexture());
+        set.emplace_back(textures.back().get());
+    }
+    const auto extra = makeTexture();
+
+    const auto units = TextureBinder::bind(set);
+
+    // first texture is used again, so the second one is the least recently used
+    const auto first_unit = TextureBinder::bind({set[0]});
+    const auto extra_unit = TextureBinder::bind({extra.get()});
+
+    REQUIRE(first_unit[0] == units[0]);
+    REQUIRE(extra_unit[0] == units[1]);
+    REQUIRE(context.getTextureBound().at(units[0]) == set[0]->getId());
+
+    // set cannot use more textures than units
+    set.emplace_back(extra.get());
+    REQUIRE_THROWS(TextureBinder::bind(set));
+
+    check_opengl_state();
+}
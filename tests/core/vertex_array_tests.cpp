@@ -0,0 +1,79 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/context_initializer.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/vertex_array.hpp>
+
+using namespace Limitless;
+
+TEST_CASE("VertexArray sources vertex format from attached buffer") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    BufferBuilder builder;
+    auto buffer = builder.setTarget(Buffer::Type::Array)
+                         .setUsage(Buffer::Storage::Static)
+                         .setAccess(Buffer::ImmutableAccess::None)
+                         .setData(nullptr)
+                         .setDataSize(sizeof(VertexNormalTangent) * 4)
+                         .build();
+
+    GLint array_bound = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &array_bound);
+
+    VertexArray vertex_array;
+    vertex_array << std::pair<VertexNormalTangent, Buffer&>(VertexNormalTangent{}, *buffer);
+
+    // editing with direct state access does not touch bindings
+    if (ContextInitializer::isDirectStateAccessSupported()) {
+        GLint array_bound_after = 0;
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &array_bound_after);
+        REQUIRE(array_bound == array_bound_after);
+    }
+
+    vertex_array.bind();
+
+    for (const auto& attribute : getVertexFormat(VertexNormalTangent{}).attributes) {
+        GLint enabled = 0, source = 0;
+        glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &enabled);
+        glGetVertexAttribiv(attribute.index, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &source);
+
+        REQUIRE(enabled == GL_TRUE);
+        REQUIRE(static_cast<GLuint>(source) == buffer->getId());
+    }
+
+    check_opengl_state();
+}
+
+TEST_CASE("Vertex layouts share vertex array of context") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    auto& vertex_array = VertexArray::getShared({&getVertexFormat(VertexNormalTangent{})});
+
+    REQUIRE(&vertex_array == &VertexArray::getShared({&getVertexFormat(VertexNormalTangent{})}));
+    REQUIRE(&vertex_array != &VertexArray::getShared({&getVertexFormat(TextVertex{})}));
+
+    BufferBuilder builder;
+    builder.setTarget(Buffer::Type::Array)
+           .setUsage(Buffer::Storage::Static)
+           .setAccess(Buffer::ImmutableAccess::None)
+           .setData(nullptr)
+           .setDataSize(sizeof(VertexNormalTangent) * 4);
+
+    auto first = builder.build();
+    vertex_array.bind();
+    vertex_array.setVertexBuffer(0, *first);
+    first.reset();
+
+    // deleted buffer is forgotten, so buffer reusing its id is attached again
+    auto second = builder.build();
+    vertex_array.setVertexBuffer(0, *second);
+
+    GLint source = 0;
+    glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &source);
+    REQUIRE(static_cast<GLuint>(source) == second->getId());
+
+    check_opengl_state();
+}
@@ -5,7 +5,7 @@
 #include <limitless/core/state_texture.hpp>
 
 namespace Limitless {
-    void check_opengl_state() {
+    inline void check_opengl_state() {
         REQUIRE(gl_error_count == 0);
         gl_error_count = 0;
 
@@ -17,9 +17,10 @@ namespace Limitless {
             REQUIRE(state->getActiveTexture() == (query.geti(QueryState::ActiveTexture) - GL_TEXTURE0));
 
             const auto last_active_texture = state->getActiveTexture();
-            for (const auto& [unit, id] : state->getTextureBound()) {
+            const auto& texture_bound = state->getTextureBound();
+            for (GLuint unit = 0; unit < texture_bound.size(); ++unit) {
                 StateTexture::activate(unit);
-                REQUIRE(id == query.geti(QueryState::TextureBinding2D));
+                REQUIRE(texture_bound[unit] == query.geti(QueryState::TextureBinding2D));
             }
             StateTexture::activate(last_active_texture);
         }
@@ -0,0 +1,82 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context_observer.hpp>
+#include <limitless/pipeline/forward.hpp>
+#include <limitless/pipeline/shadow_pass.hpp>
+#include <limitless/pipeline/render_settings.hpp>
+#include <limitless/scene.hpp>
+
+using namespace Limitless;
+
+namespace {
+    std::vector<const RenderPass*> getPasses(const Pipeline& pipeline) {
+        std::vector<const RenderPass*> passes;
+        for (const auto& pass : pipeline.getPasses()) {
+            passes.emplace_back(pass.get());
+        }
+        return passes;
+    }
+
+    const DirectionalShadowPass* findShadowPass(const Pipeline& pipeline) {
+        for (const auto& pass : pipeline.getPasses()) {
+            if (const auto* shadow_pass = dynamic_cast<const DirectionalShadowPass*>(pass.get()); shadow_pass) {
+                return shadow_pass;
+            }
+        }
+        return nullptr;
+    }
+}
+
+TEST_CASE("Forward keeps passes when changed settings are used by shaders only") {
+    ContextEventObserver context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Scene scene {context};
+
+    RenderSettings settings;
+    Forward pipeline {context, settings};
+
+    const auto passes = getPasses(pipeline);
+
+    settings.directional_pcf = !settings.directional_pcf;
+    settings.normal_mapping = !settings.normal_mapping;
+    pipeline.update(context, scene, settings);
+
+    REQUIRE(getPasses(pipeline) == passes);
+
+    check_opengl_state();
+}
+
+TEST_CASE("Forward recreates only shadow pass when split count changes") {
+    ContextEventObserver context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Scene scene {context};
+
+    RenderSettings settings;
+    settings.directional_csm = true;
+    settings.directional_split_count = 3;
+    Forward pipeline {context, settings};
+
+    const auto passes = getPasses(pipeline);
+    const auto* shadow_pass = findShadowPass(pipeline);
+    REQUIRE(shadow_pass);
+    REQUIRE(shadow_pass->getShadows().getSplitCount() == 3);
+
+    settings.directional_split_count = 2;
+    pipeline.update(context, scene, settings);
+
+    const auto updated = getPasses(pipeline);
+    REQUIRE(updated.size() == passes.size());
+
+    // new pass may take address of the destroyed one, so it is told apart by its shadow maps
+    shadow_pass = findShadowPass(pipeline);
+    REQUIRE(shadow_pass);
+    REQUIRE(shadow_pass->getShadows().getSplitCount() == 2);
+
+    for (size_t i = 0; i < passes.size(); ++i) {
+        if (updated[i] != shadow_pass) {
+            REQUIRE(updated[i] == passes[i]);
+        }
+    }
+
+    check_opengl_state();
+}
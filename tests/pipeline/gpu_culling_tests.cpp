@@ -0,0 +1,161 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/buffer_builder.hpp>
+#include <limitless/core/texture_builder.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/pipeline/gpu_culling.hpp>
+#include <limitless/util/frustum.hpp>
+#include <limitless/assets.hpp>
+#include <limitless/camera.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    struct Command {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    template<typename T>
+    std::vector<T> readBuffer(const Buffer& buffer, size_t count) {
+        std::vector<T> data(count);
+        buffer.bindAs(Buffer::Type::ShaderStorage);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, count * sizeof(T), data.data());
+        return data;
+    }
+
+    std::unique_ptr<Buffer> makeCommands(const std::vector<Command>& commands) {
+        BufferBuilder builder;
+        return builder.setTarget(Buffer::Type::ShaderStorage)
+                      .setUsage(Buffer::Storage::Static)
+                      .setAccess(Buffer::ImmutableAccess::None)
+                      .setData(commands.data())
+                      .setDataSize(commands.size() * sizeof(Command))
+                      .build();
+    }
+
+    void compileCullingShaders(Context& context, Assets& assets) {
+        ShaderCompiler compiler {context};
+        assets.shaders.add("culling", compiler.compile(assets.getShaderDir() / "pipeline/culling"));
+        assets.shaders.add("depth_pyramid", compiler.compile(assets.getShaderDir() / "pipeline/depth_pyramid"));
+    }
+}
+
+TEST_CASE("GpuCulling compacts visible draws to the beginning of their runs") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    if (!GpuCulling::isSupported()) {
+        WARN("GpuCulling is not supported by context");
+        return;
+    }
+
+    Assets assets {ENGINE_ASSETS_DIR};
+    compileCullingShaders(context, assets);
+
+    Camera camera {{800, 600}};
+    const Frustum frustum {camera.getProjection() * camera.getView()};
+
+    constexpr uint32_t draw_count = 1024;
+    constexpr uint32_t run_size = draw_count / 2;
+
+    GpuCulling culling {false};
+    std::vector<Command> commands;
+    std::array<std::vector<GLuint>, 2> expected;
+
+    // grid of boxes around camera, every command is marked by its count
+    for (uint32_t i = 0; i < draw_count; ++i) {
+        const auto position = glm::vec3{i % 16, (i / 16) % 8, i / 128} - glm::vec3{8.0f, 4.0f, 4.0f};
+        const BoundingBox box {position * 10.0f, glm::vec3{2.0f}};
+        const auto run = i / run_size;
+
+        culling.add(box, run, run * run_size);
+        commands.push_back({i + 1, 1, 0, 0, i});
+
+        if (frustum.intersects(box)) {
+            expected[run].push_back(i + 1);
+        }
+    }
+
+    REQUIRE(!expected[0].empty());
+    REQUIRE(expected[0].size() + expected[1].size() < draw_count);
+
+    const auto command_buffer = makeCommands(commands);
+    culling.cull(context, assets, camera, *command_buffer, 2);
+
+    const auto counts = readBuffer<GLuint>(culling.getCounts(), 2);
+    const auto output = readBuffer<Command>(culling.getOutput(), draw_count);
+
+    for (uint32_t run = 0; run < 2; ++run) {
+        REQUIRE(counts[run] == expected[run].size());
+
+        std::vector<GLuint> visible;
+        for (uint32_t i = 0; i < run_size; ++i) {
+            const auto& command = output[run * run_size + i];
+            if (i < counts[run]) {
+                visible.push_back(command.count);
+                REQUIRE(command.base_instance == command.count - 1);
+            } else {
+                REQUIRE(command.count == 0);
+                REQUIRE(command.instance_count == 0);
+            }
+        }
+
+        std::sort(visible.begin(), visible.end());
+        REQUIRE(visible == expected[run]);
+    }
+
+    check_opengl_state();
+}
+
+TEST_CASE("GpuCulling rejects draws behind depth of previous frame") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+
+    if (!GpuCulling::isSupported()) {
+        WARN("GpuCulling is not supported by context");
+        return;
+    }
+
+    Assets assets {ENGINE_ASSETS_DIR};
+    compileCullingShaders(context, assets);
+
+    Camera camera {{64, 64}};
+
+    // depth of a wall a few units in front of camera
+    std::vector<float> depth_data(64 * 64, 0.995f);
+
+    TextureBuilder builder;
+    const auto depth = builder.setTarget(Texture::Type::Tex2D)
+                              .setInternalFormat(Texture::InternalFormat::Depth32F)
+                              .setSize({64, 64})
+                              .setFormat(Texture::Format::DepthComponent)
+                              .setDataType(Texture::DataType::Float)
+                              .setData(depth_data.data())
+                              .setMinFilter(Texture::Filter::Nearest)
+                              .setMagFilter(Texture::Filter::Nearest)
+                              .build();
+
+    GpuCulling culling {true};
+    culling.updateDepthPyramid(context, assets, depth, camera);
+
+    culling.add({camera.getPosition() + camera.getFront(), glm::vec3{0.2f}}, 0, 0);
+    culling.add({camera.getPosition() + camera.getFront() * 50.0f, glm::vec3{2.0f}}, 0, 0);
+
+    const auto command_buffer = makeCommands({{1, 1, 0, 0, 0}, {2, 1, 0, 0, 1}});
+    culling.cull(context, assets, camera, *command_buffer, 1);
+
+    const auto counts = readBuffer<GLuint>(culling.getCounts(), 1);
+    const auto output = readBuffer<Command>(culling.getOutput(), 2);
+
+    REQUIRE(counts[0] == 1);
+    REQUIRE(output[0].count == 1);
+    REQUIRE(output[1].count == 0);
+
+    check_opengl_state();
+}
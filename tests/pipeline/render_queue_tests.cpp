@@ -0,0 +1,183 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/pipeline/render_queue.hpp>
+#include <limitless/instances/model_instance.hpp>
+#include <limitless/instances/mesh_instance.hpp>
+#include <limitless/ms/material_builder.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/models/model.hpp>
+#include <limitless/assets.hpp>
+#include <limitless/camera.hpp>
+#include <algorithm>
+
+using namespace Limitless;
+
+namespace {
+    // model without meshes, items only need bounds of their instance
+    class BoxModel : public Model {
+    public:
+        BoxModel()
+            : Model({}, {}, "box") {
+            bounding_box = {glm::vec3{0.0f}, glm::vec3{1.0f}};
+        }
+    };
+
+    struct QueueScene {
+        Context& context;
+        Camera camera {{1, 1}};
+        std::shared_ptr<BoxModel> model = std::make_shared<BoxModel>();
+        std::vector<std::unique_ptr<ModelInstance>> instances;
+        std::vector<std::unique_ptr<MeshInstance>> meshes;
+
+        explicit QueueScene(Context& _context)
+            : context {_context} {
+            camera.setPosition(glm::vec3{0.0f});
+            camera.setFront({1.0f, 0.0f, 0.0f});
+        }
+
+        // item at depth along camera view direction
+        void add(RenderQueue& queue, const std::shared_ptr<ms::Material>& material, float depth) {
+            auto& instance = *instances.emplace_back(std::make_unique<ModelInstance>(model, glm::vec3{depth, 0.0f, 0.0f}));
+            instance.update(context, camera);
+
+            auto& mesh = *meshes.emplace_back(std::make_unique<MeshInstance>(nullptr, material));
+            queue.add(instance, mesh, 0, *material);
+        }
+    };
+
+    float getDepth(const DrawItem& item) {
+        return item.instance->getBoundingBox().center.x;
+    }
+
+    std::shared_ptr<ms::Material> withBlending(const std::shared_ptr<ms::Material>& material, ms::Blending blending) {
+        auto copy = std::make_shared<ms::Material>(*material);
+        copy->getBlending() = blending;
+        return copy;
+    }
+}
+
+TEST_CASE("RenderQueue puts every blending into its own bucket") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {ENGINE_ASSETS_DIR};
+    QueueScene scene {context};
+
+    ms::MaterialBuilder builder {assets};
+    const auto opaque = builder.setName("opaque").add(ms::Property::Color, glm::vec4{1.0f}).build();
+    const auto translucent = withBlending(opaque, ms::Blending::Translucent);
+    const auto additive = withBlending(opaque, ms::Blending::Additive);
+
+    RenderQueue queue;
+    queue.begin(scene.camera);
+    scene.add(queue, translucent, 3.0f);
+    scene.add(queue, opaque, 2.0f);
+    scene.add(queue, additive, 1.0f);
+    scene.add(queue, opaque, 4.0f);
+    scene.add(queue, translucent, 5.0f);
+    queue.sort();
+
+    REQUIRE(queue.size() == 5);
+    REQUIRE(queue.getBucket(ms::Blending::Opaque).size() == 2);
+    REQUIRE(queue.getBucket(ms::Blending::Translucent).size() == 2);
+    REQUIRE(queue.getBucket(ms::Blending::Additive).size() == 1);
+    REQUIRE(queue.getBucket(ms::Blending::Modulate).empty());
+
+    for (const auto blending : {ms::Blending::Opaque, ms::Blending::Translucent, ms::Blending::Additive}) {
+        for (const auto& item : queue.getBucket(blending)) {
+            REQUIRE(item.material->getBlending() == blending);
+        }
+    }
+
+    // queue is emptied by the next frame
+    queue.begin(scene.camera);
+    queue.sort();
+    REQUIRE(queue.size() == 0);
+    REQUIRE(queue.getBucket(ms::Blending::Opaque).empty());
+
+    check_opengl_state();
+}
+
+TEST_CASE("RenderQueue orders opaque items by program, material and then front to back") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {ENGINE_ASSETS_DIR};
+    QueueScene scene {context};
+
+    ms::MaterialBuilder builder {assets};
+    const auto first = builder.setName("first").add(ms::Property::Color, glm::vec4{1.0f}).build();
+    const auto second = builder.setName("second").add(ms::Property::Color, glm::vec4{0.5f}).build();
+    const auto emissive = builder.setName("emissive").add(ms::Property::Color, glm::vec4{1.0f}).add(ms::Property::EmissiveColor, glm::vec4{1.0f}).build();
+    REQUIRE(first->getShaderIndex() == second->getShaderIndex());
+    REQUIRE(first->getShaderIndex() != emissive->getShaderIndex());
+
+    RenderQueue queue;
+    queue.begin(scene.camera);
+
+    const std::vector<std::pair<std::shared_ptr<ms::Material>, float>> items = {
+        {first, 5.0f}, {emissive, 2.0f}, {second, 0.5f}, {first, 1.0f}, {emissive, 9.0f},
+        {second, 7.0f}, {first, 3.0f}, {emissive, 0.25f}, {second, 1.5f}, {first, 0.75f},
+    };
+    for (const auto& [material, depth] : items) {
+        scene.add(queue, material, depth);
+    }
+
+    // item behind the camera is drawn first of its material
+    scene.add(queue, first, -4.0f);
+    queue.sort();
+
+    const auto bucket = queue.getBucket(ms::Blending::Opaque);
+    REQUIRE(bucket.size() == items.size() + 1);
+
+    std::vector<const ms::Material*> seen;
+    for (auto it = bucket.begin(); it != bucket.end(); ++it) {
+        if (it != bucket.begin()) {
+            const auto& previous = *(it - 1);
+
+            // programs are switched once
+            REQUIRE(previous.material->getShaderIndex() <= it->material->getShaderIndex());
+
+            if (previous.material == it->material) {
+                REQUIRE(getDepth(previous) <= getDepth(*it));
+                continue;
+            }
+        }
+
+        // materials are not switched back
+        REQUIRE(std::find(seen.begin(), seen.end(), it->material) == seen.end());
+        seen.emplace_back(it->material);
+    }
+    REQUIRE(seen.size() == 3);
+
+    check_opengl_state();
+}
+
+TEST_CASE("RenderQueue orders translucent items back to front across programs") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {ENGINE_ASSETS_DIR};
+    QueueScene scene {context};
+
+    ms::MaterialBuilder builder {assets};
+    const auto plain = builder.setName("plain").add(ms::Property::Color, glm::vec4{1.0f}).setBlending(ms::Blending::Translucent).build();
+    const auto emissive = builder.setName("emissive").add(ms::Property::Color, glm::vec4{1.0f}).add(ms::Property::EmissiveColor, glm::vec4{1.0f}).setBlending(ms::Blending::Translucent).build();
+    REQUIRE(plain->getShaderIndex() != emissive->getShaderIndex());
+
+    RenderQueue queue;
+    queue.begin(scene.camera);
+
+    // depths close to each other still keep their order
+    for (const auto depth : {2.0f, 30.0f, 2.001f, 0.5f, 12.0f, 100.0f, 7.0f}) {
+        scene.add(queue, plain, depth);
+        scene.add(queue, emissive, depth + 0.25f);
+    }
+    queue.sort();
+
+    const auto bucket = queue.getBucket(ms::Blending::Translucent);
+    REQUIRE(bucket.size() == 14);
+
+    for (auto it = bucket.begin() + 1; it != bucket.end(); ++it) {
+        REQUIRE(getDepth(*(it - 1)) > getDepth(*it));
+    }
+
+    check_opengl_state();
+}
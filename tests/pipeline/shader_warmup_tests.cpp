@@ -0,0 +1,185 @@
+#include "../catch_amalgamated.hpp"
+
+#include "../opengl_debug.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/core/shader_program.hpp>
+#include <limitless/core/shader_compiler.hpp>
+#include <limitless/pipeline/shader_warmup.hpp>
+#include <limitless/pipeline/render_settings.hpp>
+#include <limitless/ms/material_builder.hpp>
+#include <limitless/ms/material.hpp>
+#include <limitless/models/cube.hpp>
+#include <limitless/assets.hpp>
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+using namespace Limitless;
+
+namespace {
+    struct Order {
+        const ms::Material* material;
+        ShaderPass pass;
+        ModelShader model;
+
+        bool operator==(const Order& rhs) const noexcept {
+            return material == rhs.material && pass == rhs.pass && model == rhs.model;
+        }
+    };
+
+    // program that only takes place of stored variants, it is not drawn
+    std::shared_ptr<ShaderProgram> compileProgram(Context& context) {
+        const auto dir = fs::temp_directory_path() / "limitless_shader_warmup_tests";
+        fs::create_directories(dir);
+
+        std::ofstream(dir / "order.vs") << "#version 330 core\nvoid main() { gl_Position = vec4(0.0); }\n";
+        std::ofstream(dir / "order.fs") << "#version 330 core\nout vec4 color;\nvoid main() { color = vec4(1.0); }\n";
+
+        ShaderCompiler compiler {context};
+        return compiler.compile(dir / "order");
+    }
+
+    std::vector<Order> getOrder(const ShaderWarmUp& warm_up, const Assets& assets) {
+        std::vector<Order> order;
+        for (const auto& entry : warm_up.getEntries(assets)) {
+            order.emplace_back(Order{entry.material, entry.pass, entry.model});
+        }
+        return order;
+    }
+}
+
+TEST_CASE("ShaderStats count first uses that were not warmed") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    context.resetShaderStats();
+
+    context.beginFirstUse(false);
+    context.endFirstUse();
+    context.beginFirstUse(true);
+    context.endFirstUse();
+
+    // nothing is timed after use has ended
+    context.endFirstUse();
+
+    const auto& stats = context.getShaderStats();
+    REQUIRE(stats.first_uses == 2);
+    REQUIRE(stats.cold_uses == 1);
+    REQUIRE(stats.max_first_use <= stats.first_use_time);
+    REQUIRE(stats.warmed == 0);
+
+    context.resetShaderStats();
+    REQUIRE(context.getShaderStats().first_uses == 0);
+    REQUIRE(context.getShaderStats().cold_uses == 0);
+
+    check_opengl_state();
+}
+
+TEST_CASE("ShaderWarmUp orders programs by listed materials, then passes, then model shaders") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {ENGINE_ASSETS_DIR};
+
+    ms::MaterialBuilder builder {assets};
+    const auto first = builder.setName("first").add(ms::Property::Color, glm::vec4{1.0f}).build();
+    const auto second = builder.setName("second").add(ms::Property::Color, glm::vec4{1.0f}).add(ms::Property::EmissiveColor, glm::vec4{1.0f}).build();
+    REQUIRE(first->getShaderIndex() != second->getShaderIndex());
+
+    const auto program = compileProgram(context);
+    const auto add = [&] (ShaderPass pass, ModelShader model, uint64_t index) {
+        assets.shaders.add(pass, model, index, program);
+    };
+
+    // program without material of its index is still warmed
+    const auto unknown_index = std::max(first->getShaderIndex(), second->getShaderIndex()) + 1;
+
+    add(ShaderPass::Forward, ModelShader::Model, first->getShaderIndex());
+    add(ShaderPass::DirectionalShadow, ModelShader::Instanced, first->getShaderIndex());
+    add(ShaderPass::Forward, ModelShader::Skeletal, unknown_index);
+    add(ShaderPass::DirectionalShadow, ModelShader::Model, second->getShaderIndex());
+    add(ShaderPass::Forward, ModelShader::Instanced, second->getShaderIndex());
+    add(ShaderPass::Forward, ModelShader::Model, second->getShaderIndex());
+
+    ShaderWarmUp warm_up;
+    warm_up.setMaterials({"second"});
+
+    REQUIRE(getOrder(warm_up, assets) == std::vector<Order>{
+        {second.get(), ShaderPass::Forward, ModelShader::Model},
+        {second.get(), ShaderPass::Forward, ModelShader::Instanced},
+        {second.get(), ShaderPass::DirectionalShadow, ModelShader::Model},
+        {first.get(), ShaderPass::Forward, ModelShader::Model},
+        {nullptr, ShaderPass::Forward, ModelShader::Skeletal},
+        {first.get(), ShaderPass::DirectionalShadow, ModelShader::Instanced},
+    });
+
+    // passes are ranked in listed order, unlisted passes and model shaders are skipped
+    warm_up.setPasses({ShaderPass::DirectionalShadow, ShaderPass::Forward});
+    warm_up.setModelShaders({ModelShader::Model});
+
+    REQUIRE(getOrder(warm_up, assets) == std::vector<Order>{
+        {second.get(), ShaderPass::DirectionalShadow, ModelShader::Model},
+        {second.get(), ShaderPass::Forward, ModelShader::Model},
+        {first.get(), ShaderPass::Forward, ModelShader::Model},
+    });
+
+    check_opengl_state();
+}
+
+TEST_CASE("ShaderWarmUp warms compiled programs and restores context state") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Assets assets {ENGINE_ASSETS_DIR};
+
+    assets.models.add("cube", std::make_shared<Cube>());
+    assets.meshes.add("cube", assets.models.at("cube")->getMeshes().at(0));
+
+    ms::MaterialBuilder builder {assets};
+    const auto material = builder.setName("warmed").add(ms::Property::Color, glm::vec4{1.0f}).build();
+
+    RenderSettings settings;
+    settings.batching = false;
+    assets.compileMaterial(context, settings, material);
+
+    context.enable(Capabilities::ProgramPointSize);
+    context.disable(Capabilities::CullFace);
+    context.disable(Capabilities::DepthTest);
+    context.setDepthFunc(DepthFunc::Gequal);
+    context.setDepthMask(DepthMask::False);
+    context.setBlendFunc(BlendFactor::One, BlendFactor::One);
+    context.resetShaderStats();
+
+    ShaderWarmUp warm_up;
+    warm_up.setModelShaders({ModelShader::Model});
+
+    // programs may still be linked by driver threads
+    bool done = false;
+    for (int i = 0; i < 1000 && !done; ++i) {
+        done = warm_up.warm(context, assets);
+        if (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    REQUIRE(done);
+
+    const auto warmed = context.getShaderStats().warmed;
+    REQUIRE(warmed == warm_up.getEntries(assets).size());
+    REQUIRE(warmed > 0);
+
+    REQUIRE(glIsEnabled(GL_PROGRAM_POINT_SIZE));
+    REQUIRE_FALSE(glIsEnabled(GL_CULL_FACE));
+    REQUIRE_FALSE(glIsEnabled(GL_DEPTH_TEST));
+    REQUIRE(context.getDepthFunc() == DepthFunc::Gequal);
+    REQUIRE(context.getDepthMask() == DepthMask::False);
+    REQUIRE(context.getBlendFunc() == std::pair{BlendFactor::One, BlendFactor::One});
+
+    // warmed programs are skipped by next warm-up and their first use is not cold
+    REQUIRE(warm_up.warm(context, assets));
+    REQUIRE(context.getShaderStats().warmed == warmed);
+
+    auto* program = assets.shaders.find(ShaderPass::Forward, ModelShader::Model, material->getShaderIndex());
+    REQUIRE(program);
+    program->use();
+    context.endFirstUse();
+
+    REQUIRE(context.getShaderStats().first_uses == 1);
+    REQUIRE(context.getShaderStats().cold_uses == 0);
+
+    check_opengl_state();
+}
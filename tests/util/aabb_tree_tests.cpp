@@ -0,0 +1,253 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/aabb_tree.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace Limitless;
+
+namespace {
+    struct Leaf {
+        int32_t proxy;
+        int id;
+    };
+
+    class Boxes {
+    private:
+        std::mt19937 generator {42};
+    public:
+        float uniform(float min, float max) {
+            return std::uniform_real_distribution<float>{min, max}(generator);
+        }
+
+        glm::vec3 point(float extent) {
+            return {uniform(-extent, extent), uniform(-extent, extent), uniform(-extent, extent)};
+        }
+
+        BoundingBox box() {
+            return {point(50.0f), {uniform(0.1f, 4.0f), uniform(0.1f, 4.0f), uniform(0.1f, 4.0f)}};
+        }
+    };
+
+    glm::vec3 getMin(const BoundingBox& box) { return box.center - box.size * 0.5f; }
+    glm::vec3 getMax(const BoundingBox& box) { return box.center + box.size * 0.5f; }
+
+    bool overlaps(const BoundingBox& lhs, const BoundingBox& rhs) {
+        const auto lhs_min = getMin(lhs), lhs_max = getMax(lhs);
+        const auto rhs_min = getMin(rhs), rhs_max = getMax(rhs);
+
+        for (int i = 0; i < 3; ++i) {
+            if (lhs_min[i] > rhs_max[i] || lhs_max[i] < rhs_min[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // distance to the box along the ray, negative if ray misses it within max_distance
+    float intersect(const BoundingBox& box, const glm::vec3& origin, const glm::vec3& direction, float max_distance) {
+        const auto min = getMin(box), max = getMax(box);
+        auto enter = 0.0f;
+        auto exit = max_distance;
+
+        for (int i = 0; i < 3; ++i) {
+            if (direction[i] == 0.0f) {
+                if (origin[i] < min[i] || origin[i] > max[i]) {
+                    return -1.0f;
+                }
+                continue;
+            }
+
+            auto t0 = (min[i] - origin[i]) / direction[i];
+            auto t1 = (max[i] - origin[i]) / direction[i];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            enter = std::max(enter, t0);
+            exit = std::min(exit, t1);
+        }
+
+        return enter <= exit ? enter : -1.0f;
+    }
+
+    std::vector<int> sorted(std::vector<int> ids) {
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    std::vector<int> queryBox(const AABBTree<int>& tree, const BoundingBox& box) {
+        std::vector<int> ids;
+        tree.query(box, [&] (int id) { ids.emplace_back(id); });
+        return sorted(ids);
+    }
+
+    std::vector<int> queryBruteForce(const AABBTree<int>& tree, const std::vector<Leaf>& leaves, const BoundingBox& box) {
+        std::vector<int> ids;
+        for (const auto& leaf : leaves) {
+            if (overlaps(tree.getFatBox(leaf.proxy), box)) {
+                ids.emplace_back(leaf.id);
+            }
+        }
+        return sorted(ids);
+    }
+
+    // scene of random boxes, a part of them removed and moved, so the tree is rebuilt in places
+    std::vector<Leaf> populate(AABBTree<int>& tree, Boxes& boxes, int count) {
+        std::vector<Leaf> leaves;
+        for (int i = 0; i < count; ++i) {
+            leaves.push_back({tree.insert(boxes.box(), i), i});
+        }
+
+        for (size_t i = 0; i < leaves.size(); i += 3) {
+            tree.remove(leaves[i].proxy);
+        }
+        leaves.erase(std::remove_if(leaves.begin(), leaves.end(), [] (const Leaf& leaf) { return leaf.id % 3 == 0; }), leaves.end());
+
+        for (size_t i = 0; i < leaves.size(); i += 2) {
+            tree.update(leaves[i].proxy, boxes.box());
+        }
+
+        return leaves;
+    }
+}
+
+TEST_CASE("AABBTree box and sphere queries match brute force") {
+    AABBTree<int> tree;
+    Boxes boxes;
+    const auto leaves = populate(tree, boxes, 600);
+
+    REQUIRE(tree.size() == leaves.size());
+
+    for (int i = 0; i < 50; ++i) {
+        const BoundingBox box {boxes.point(50.0f), glm::vec3{boxes.uniform(1.0f, 30.0f)}};
+        REQUIRE(queryBox(tree, box) == queryBruteForce(tree, leaves, box));
+    }
+
+    for (int i = 0; i < 50; ++i) {
+        const auto center = boxes.point(50.0f);
+        const auto radius = boxes.uniform(1.0f, 20.0f);
+
+        std::vector<int> ids;
+        tree.query(center, radius, [&] (int id) { ids.emplace_back(id); });
+
+        std::vector<int> expected;
+        for (const auto& leaf : leaves) {
+            const auto fat = tree.getFatBox(leaf.proxy);
+            const auto d = glm::clamp(center, getMin(fat), getMax(fat)) - center;
+            if (glm::dot(d, d) <= radius * radius) {
+                expected.emplace_back(leaf.id);
+            }
+        }
+
+        REQUIRE(sorted(ids) == sorted(expected));
+    }
+}
+
+TEST_CASE("AABBTree frustum query matches brute force") {
+    AABBTree<int> tree;
+    Boxes boxes;
+    const auto leaves = populate(tree, boxes, 600);
+
+    // frustum covers a part of the scene, so subtrees are culled, split and collected whole
+    const Frustum frustum {glm::ortho(-20.0f, 10.0f, -15.0f, 25.0f, -30.0f, 40.0f)};
+
+    std::vector<int> ids;
+    tree.query(frustum, [&] (int id) { ids.emplace_back(id); });
+
+    std::vector<int> expected;
+    for (const auto& leaf : leaves) {
+        if (frustum.intersects(tree.getFatBox(leaf.proxy))) {
+            expected.emplace_back(leaf.id);
+        }
+    }
+
+    REQUIRE_FALSE(expected.empty());
+    REQUIRE(expected.size() < leaves.size());
+    REQUIRE(sorted(ids) == sorted(expected));
+}
+
+TEST_CASE("AABBTree raycast matches brute force") {
+    AABBTree<int> tree;
+    Boxes boxes;
+    const auto leaves = populate(tree, boxes, 600);
+
+    const auto cast = [&] (const glm::vec3& origin, const glm::vec3& direction, float max_distance) {
+        std::vector<std::pair<int, float>> hits;
+        tree.raycast(origin, direction, max_distance, [&] (int id, float distance) { hits.emplace_back(id, distance); });
+        std::sort(hits.begin(), hits.end());
+
+        std::vector<std::pair<int, float>> expected;
+        for (const auto& leaf : leaves) {
+            if (const auto distance = intersect(tree.getFatBox(leaf.proxy), origin, direction, max_distance); distance >= 0.0f) {
+                expected.emplace_back(leaf.id, distance);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        REQUIRE(hits.size() == expected.size());
+        for (size_t i = 0; i < hits.size(); ++i) {
+            REQUIRE(hits[i].first == expected[i].first);
+            REQUIRE(std::abs(hits[i].second - expected[i].second) < 1e-3f);
+        }
+        return hits.size();
+    };
+
+    size_t hit_count = 0;
+    for (int i = 0; i < 50; ++i) {
+        hit_count += cast(boxes.point(60.0f), glm::normalize(boxes.point(1.0f)), boxes.uniform(10.0f, 200.0f));
+    }
+    REQUIRE(hit_count > 0);
+
+    // rays parallel to axes divide by zero in the slab test
+    for (const auto& direction : {glm::vec3{1.0f, 0.0f, 0.0f}, glm::vec3{0.0f, -1.0f, 0.0f}, glm::vec3{0.0f, 0.0f, 1.0f}, glm::normalize(glm::vec3{1.0f, 1.0f, 0.0f})}) {
+        for (int i = 0; i < 20; ++i) {
+            const auto& leaf = leaves[static_cast<size_t>(i) * 7 % leaves.size()];
+            const auto fat = tree.getFatBox(leaf.proxy);
+
+            // ray through the leaf center from outside of the scene
+            const auto origin = fat.center - direction * 100.0f;
+            REQUIRE(cast(origin, direction, 200.0f) > 0);
+        }
+    }
+}
+
+TEST_CASE("AABBTree keeps fattened leaves and stays balanced") {
+    AABBTree<int> tree {0.5f};
+
+    const auto proxy = tree.insert({glm::vec3{0.0f}, glm::vec3{2.0f}}, 7);
+    REQUIRE(tree.getData(proxy) == 7);
+    REQUIRE(tree.getFatBox(proxy).size == glm::vec3{3.0f});
+
+    // movement inside the margin does not reinsert the leaf
+    REQUIRE_FALSE(tree.update(proxy, {glm::vec3{0.4f, 0.0f, -0.4f}, glm::vec3{2.0f}}));
+    REQUIRE(tree.update(proxy, {glm::vec3{5.0f, 0.0f, 0.0f}, glm::vec3{2.0f}}));
+    REQUIRE(tree.getFatBox(proxy).center == glm::vec3{5.0f, 0.0f, 0.0f});
+
+    tree.remove(proxy);
+    REQUIRE(tree.empty());
+    REQUIRE(tree.getHeight() == 0);
+
+    // boxes inserted in sorted order would make a list of an unbalanced tree
+    std::vector<int32_t> proxies;
+    for (int i = 0; i < 1024; ++i) {
+        proxies.emplace_back(tree.insert({glm::vec3{static_cast<float>(i) * 2.0f, 0.0f, 0.0f}, glm::vec3{1.0f}}, i));
+    }
+    REQUIRE(tree.size() == 1024);
+    REQUIRE(tree.getHeight() <= 20);
+
+    for (size_t i = 0; i < proxies.size(); i += 2) {
+        tree.remove(proxies[i]);
+    }
+    REQUIRE(tree.size() == 512);
+    REQUIRE(tree.getHeight() <= 18);
+
+    // nodes of removed leaves are reused
+    const auto reused = tree.insert({glm::vec3{-10.0f}, glm::vec3{1.0f}}, -1);
+    REQUIRE(reused < static_cast<int32_t>(proxies.size() * 2));
+    REQUIRE(queryBox(tree, {glm::vec3{-10.0f}, glm::vec3{1.0f}}) == std::vector<int>{-1});
+
+    tree.clear();
+    REQUIRE(tree.empty());
+    REQUIRE(queryBox(tree, {glm::vec3{0.0f}, glm::vec3{1000.0f}}).empty());
+}
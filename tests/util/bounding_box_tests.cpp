@@ -0,0 +1,97 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/core/context.hpp>
+#include <limitless/instances/model_instance.hpp>
+#include <limitless/models/model.hpp>
+#include <limitless/util/bounding_box.hpp>
+#include <limitless/camera.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <array>
+#include <limits>
+
+using namespace Limitless;
+
+namespace {
+    // model without meshes that only carries its bounds
+    class BoxModel : public Model {
+    public:
+        explicit BoxModel(const BoundingBox& box)
+            : Model({}, {}, "box") {
+            bounding_box = box;
+        }
+    };
+
+    // box enclosing all eight transformed corners
+    BoundingBox transformCorners(const BoundingBox& box, const glm::mat4& matrix) {
+        auto min = glm::vec3{std::numeric_limits<float>::max()};
+        auto max = glm::vec3{std::numeric_limits<float>::lowest()};
+
+        for (int i = 0; i < 8; ++i) {
+            const auto sign = glm::vec3{i & 1 ? 0.5f : -0.5f, i & 2 ? 0.5f : -0.5f, i & 4 ? 0.5f : -0.5f};
+            const auto corner = glm::vec3{matrix * glm::vec4{box.center + sign * box.size, 1.0f}};
+            min = glm::min(min, corner);
+            max = glm::max(max, corner);
+        }
+
+        return {(min + max) * 0.5f, max - min};
+    }
+
+    bool equal(const glm::vec3& lhs, const glm::vec3& rhs) {
+        for (int i = 0; i < 3; ++i) {
+            if (std::abs(lhs[i] - rhs[i]) > 1e-4f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool equal(const BoundingBox& lhs, const BoundingBox& rhs) {
+        return equal(lhs.center, rhs.center) && equal(lhs.size, rhs.size);
+    }
+
+    glm::mat4 compose(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+        return glm::translate(glm::mat4{1.0f}, position) * glm::toMat4(rotation) * glm::scale(glm::mat4{1.0f}, scale);
+    }
+}
+
+TEST_CASE("transformBoundingBox encloses transformed corners tightly") {
+    const BoundingBox box {{1.0f, -2.0f, 0.5f}, {2.0f, 4.0f, 1.0f}};
+
+    const std::array<glm::mat4, 4> matrices = {
+        glm::mat4{1.0f},
+        compose({3.0f, 0.0f, -4.0f}, glm::quat{1.0f, 0.0f, 0.0f, 0.0f}, glm::vec3{1.0f}),
+        compose(glm::vec3{0.0f}, glm::angleAxis(0.7f, glm::vec3{0.0f, 1.0f, 0.0f}), {2.0f, 0.5f, 1.0f}),
+        compose({-5.0f, 2.0f, 7.0f}, glm::angleAxis(1.2f, glm::normalize(glm::vec3{1.0f, 1.0f, 0.3f})), {1.5f, 3.0f, 0.25f}),
+    };
+
+    for (const auto& matrix : matrices) {
+        REQUIRE(equal(transformBoundingBox(box, matrix), transformCorners(box, matrix)));
+    }
+}
+
+TEST_CASE("ModelInstance bounds are world-space box of model bounds") {
+    Context context = {"Title", {1, 1}, {{WindowHint::Visible, false}}};
+    Camera camera {{1, 1}};
+
+    // box off the model origin, so position applied twice or on the wrong side of the matrix shows up
+    const BoundingBox box {{1.0f, 2.0f, 3.0f}, {2.0f, 4.0f, 6.0f}};
+    ModelInstance instance {std::make_shared<BoxModel>(box), glm::vec3{10.0f, 0.0f, -5.0f}};
+
+    instance.update(context, camera);
+    REQUIRE(equal(instance.getBoundingBox(), {{11.0f, 2.0f, -2.0f}, {2.0f, 4.0f, 6.0f}}));
+
+    const auto rotation = glm::angleAxis(0.9f, glm::normalize(glm::vec3{0.2f, 1.0f, -0.4f}));
+    const glm::vec3 scale {2.0f, 0.5f, 1.5f};
+    instance.setRotation(rotation);
+    instance.setScale(scale);
+    instance.update(context, camera);
+
+    const auto matrix = compose({10.0f, 0.0f, -5.0f}, rotation, scale);
+    REQUIRE(equal(instance.getBoundingBox(), transformCorners(box, matrix)));
+
+    // bounds follow the instance on next update
+    instance.setPosition({-3.0f, 1.0f, 4.0f});
+    instance.update(context, camera);
+    REQUIRE(equal(instance.getBoundingBox(), transformCorners(box, compose({-3.0f, 1.0f, 4.0f}, rotation, scale))));
+}
@@ -0,0 +1,153 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/job_system.hpp>
+#include <stdexcept>
+#include <array>
+
+using namespace Limitless;
+
+namespace {
+    // spawns two children into the same counter until depth runs out
+    void spawn(JobSystem& jobs, JobCounter& counter, std::atomic<uint32_t>& done, uint32_t depth) {
+        done.fetch_add(1);
+
+        if (depth == 0) {
+            return;
+        }
+
+        for (int i = 0; i < 2; ++i) {
+            jobs.run([&jobs, &counter, &done, depth] { spawn(jobs, counter, done, depth - 1); }, &counter);
+        }
+    }
+}
+
+TEST_CASE("Task keeps small and large functors") {
+    auto value = std::make_unique<int>(3);
+    int result {};
+
+    // move-only capture fits the inline storage
+    Task small {[value = std::move(value), &result] { result = *value; }};
+    Task moved {std::move(small)};
+    REQUIRE_FALSE(small);
+    REQUIRE(moved);
+    moved();
+    REQUIRE(result == 3);
+
+    // large capture is kept on the heap
+    std::array<int, 64> values {};
+    values.back() = 7;
+    Task large {[values, &result] { result = values.back(); }};
+    Task assigned;
+    assigned = std::move(large);
+    assigned();
+    REQUIRE(result == 7);
+}
+
+TEST_CASE("JobSystem waits for every job of counter") {
+    for (const auto thread_count : {1u, 4u}) {
+        JobSystem jobs {thread_count};
+        REQUIRE(jobs.getThreadCount() == thread_count);
+
+        std::atomic<uint32_t> done {};
+        JobCounter counter;
+        for (int i = 0; i < 1000; ++i) {
+            jobs.run([&done] { done.fetch_add(1); }, &counter);
+        }
+
+        jobs.wait(counter);
+        REQUIRE(counter.isDone());
+        REQUIRE(done == 1000);
+
+        // counter is reused for the next group
+        jobs.run([&done] { done.fetch_add(1); }, &counter);
+        jobs.wait(counter);
+        REQUIRE(done == 1001);
+    }
+}
+
+TEST_CASE("JobSystem waits for nested jobs") {
+    JobSystem jobs {4};
+
+    // children spawned into the counter of their parent extend its group
+    std::atomic<uint32_t> done {};
+    JobCounter counter;
+    jobs.run([&] { spawn(jobs, counter, done, 9); }, &counter);
+    jobs.wait(counter);
+    REQUIRE(done == (1u << 10) - 1);
+
+    // jobs wait for counters of their own jobs, the waiting worker executes queued jobs meanwhile
+    std::atomic<uint32_t> inner_done {};
+    JobCounter outer;
+    for (int i = 0; i < 16; ++i) {
+        jobs.run([&jobs, &inner_done] {
+            JobCounter inner;
+            for (int j = 0; j < 16; ++j) {
+                jobs.run([&inner_done] { inner_done.fetch_add(1); }, &inner);
+            }
+            jobs.wait(inner);
+        }, &outer);
+    }
+    jobs.wait(outer);
+    REQUIRE(inner_done == 256);
+}
+
+TEST_CASE("JobSystem parallel_for visits every index once") {
+    JobSystem jobs {4};
+
+    std::vector<std::atomic<uint32_t>> visits(1000);
+    jobs.parallel_for(0, visits.size(), 16, [&] (size_t i) { visits[i].fetch_add(1); });
+
+    for (const auto& visit : visits) {
+        REQUIRE(visit == 1);
+    }
+
+    // empty range calls nothing
+    jobs.parallel_for(5, 5, 1, [] (size_t) { FAIL("called for empty range"); });
+}
+
+TEST_CASE("JobSystem rethrows exceptions of jobs") {
+    JobSystem jobs {4};
+
+    // exception of one job does not stop the others of its group
+    std::atomic<uint32_t> done {};
+    JobCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        jobs.run([&done, i] {
+            done.fetch_add(1);
+            if (i == 50) {
+                throw std::runtime_error{"job"};
+            }
+        }, &counter);
+    }
+
+    REQUIRE_THROWS_AS(jobs.wait(counter), std::runtime_error);
+    REQUIRE(done == 100);
+
+    // error is cleared once it is rethrown
+    jobs.run([] {}, &counter);
+    REQUIRE_NOTHROW(jobs.wait(counter));
+
+    // exception of a parallel_for chunk reaches the caller after all chunks are done
+    std::atomic<uint32_t> visited {};
+    REQUIRE_THROWS_AS(jobs.parallel_for(0, 256, 1, [&] (size_t i) {
+        visited.fetch_add(1);
+        if (i == 200) {
+            throw std::runtime_error{"chunk"};
+        }
+    }), std::runtime_error);
+    REQUIRE(visited >= 200);
+}
+
+TEST_CASE("JobSystem rethrows exceptions of jobs run without counter") {
+    // the creating thread is the only worker, it takes the last queued job first
+    JobSystem jobs {1};
+
+    JobCounter counter;
+    jobs.run([] {}, &counter);
+    jobs.run([] { throw std::logic_error{"detached"}; });
+
+    // group itself succeeded, error of the detached job is rethrown on the creating thread
+    REQUIRE_THROWS_AS(jobs.wait(counter), std::logic_error);
+    REQUIRE(counter.isDone());
+    REQUIRE_NOTHROW(jobs.rethrowDetached());
+}
@@ -0,0 +1,152 @@
+#include "../catch_amalgamated.hpp"
+
+#include <limitless/util/transform_store.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtx/quaternion.hpp>
+
+using namespace Limitless;
+
+namespace {
+    struct Transform {
+        glm::vec3 position;
+        glm::quat rotation;
+        glm::vec3 scale;
+    };
+
+    Transform makeTransform(size_t i) {
+        const auto f = static_cast<float>(i);
+        const auto axis = glm::normalize(glm::vec3{1.0f + f, 2.0f - f, 0.5f * f + 1.0f});
+        return {
+            {f * 3.0f - 7.0f, f * 0.5f, -f},
+            glm::angleAxis(0.3f * f + 0.1f, axis),
+            {1.0f + 0.25f * f, 2.0f, 0.5f + 0.1f * f}
+        };
+    }
+
+    glm::mat4 compose(const Transform& transform) {
+        return glm::translate(glm::mat4{1.0f}, transform.position) * glm::toMat4(transform.rotation) * glm::scale(glm::mat4{1.0f}, transform.scale);
+    }
+
+    bool equal(const glm::mat4& lhs, const glm::mat4& rhs) {
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 4; ++row) {
+                if (std::abs(lhs[column][row] - rhs[column][row]) > 1e-4f) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST_CASE("composeTransforms matches glm for full batches and the remainder") {
+    // nine matrices take two four-wide batches and one scalar tail
+    constexpr size_t count = 9;
+
+    std::vector<float> px, py, pz, qx, qy, qz, qw, sx, sy, sz;
+    std::vector<Transform> transforms;
+    for (size_t i = 0; i < count; ++i) {
+        const auto& t = transforms.emplace_back(makeTransform(i));
+        px.emplace_back(t.position.x); py.emplace_back(t.position.y); pz.emplace_back(t.position.z);
+        qx.emplace_back(t.rotation.x); qy.emplace_back(t.rotation.y); qz.emplace_back(t.rotation.z); qw.emplace_back(t.rotation.w);
+        sx.emplace_back(t.scale.x); sy.emplace_back(t.scale.y); sz.emplace_back(t.scale.z);
+    }
+
+    // every count ends up in the scalar path for some of its matrices
+    for (size_t n = 1; n <= count; ++n) {
+        std::vector<glm::mat4> out(count, glm::mat4{0.0f});
+        composeTransforms(px.data(), py.data(), pz.data(),
+                          qx.data(), qy.data(), qz.data(), qw.data(),
+                          sx.data(), sy.data(), sz.data(),
+                          out.data(), n);
+
+        for (size_t i = 0; i < n; ++i) {
+            REQUIRE(equal(out[i], compose(transforms[i])));
+        }
+
+        // nothing is written past count
+        for (size_t i = n; i < count; ++i) {
+            REQUIRE(equal(out[i], glm::mat4{0.0f}));
+        }
+    }
+}
+
+TEST_CASE("TransformStore composes matrices of changed entries") {
+    TransformStore store;
+
+    std::vector<TransformStore::Handle> handles;
+    for (size_t i = 0; i < 6; ++i) {
+        const auto t = makeTransform(i);
+        handles.emplace_back(store.allocate(t.position, t.rotation, t.scale));
+    }
+
+    REQUIRE(store.size() == 6);
+    REQUIRE(store.update() == 6);
+    REQUIRE(store.update() == 0);
+
+    for (size_t i = 0; i < handles.size(); ++i) {
+        REQUIRE_FALSE(store.isDirty(handles[i]));
+        REQUIRE(equal(store.getMatrix(handles[i]), compose(makeTransform(i))));
+    }
+
+    // only changed entries are dirty and counted, even when they share a batch with clean ones
+    auto moved = makeTransform(1);
+    moved.position = {10.0f, 20.0f, 30.0f};
+    store.setPosition(handles[1], moved.position);
+    store.setScale(handles[1], moved.scale);
+
+    REQUIRE(store.isDirty(handles[1]));
+    REQUIRE_FALSE(store.isDirty(handles[0]));
+    REQUIRE(store.getPosition(handles[1]) == moved.position);
+
+    REQUIRE(store.update() == 1);
+    REQUIRE_FALSE(store.isDirty(handles[1]));
+    REQUIRE(equal(store.getMatrix(handles[1]), compose(moved)));
+    REQUIRE(equal(store.getMatrix(handles[0]), compose(makeTransform(0))));
+
+    auto rotated = makeTransform(5);
+    rotated.rotation = glm::angleAxis(1.0f, glm::vec3{0.0f, 1.0f, 0.0f});
+    store.setRotation(handles[5], rotated.rotation);
+    store.setRotation(handles[0], makeTransform(0).rotation);
+
+    REQUIRE(store.update() == 2);
+    REQUIRE(equal(store.getMatrix(handles[5]), compose(rotated)));
+}
+
+TEST_CASE("TransformStore keeps handles valid when entries are released") {
+    TransformStore store;
+
+    std::vector<TransformStore::Handle> handles;
+    for (size_t i = 0; i < 5; ++i) {
+        const auto t = makeTransform(i);
+        handles.emplace_back(store.allocate(t.position, t.rotation, t.scale));
+    }
+    store.update();
+
+    // last entry is moved into the gap along with its dirty flag
+    auto moved = makeTransform(4);
+    moved.position = {-1.0f, -2.0f, -3.0f};
+    store.setPosition(handles[4], moved.position);
+    store.release(handles[1]);
+
+    REQUIRE(store.size() == 4);
+    REQUIRE(store.isDirty(handles[4]));
+    REQUIRE_FALSE(store.isDirty(handles[0]));
+    REQUIRE(store.update() == 1);
+
+    REQUIRE(equal(store.getMatrix(handles[0]), compose(makeTransform(0))));
+    REQUIRE(equal(store.getMatrix(handles[2]), compose(makeTransform(2))));
+    REQUIRE(equal(store.getMatrix(handles[3]), compose(makeTransform(3))));
+    REQUIRE(equal(store.getMatrix(handles[4]), compose(moved)));
+
+    // released handle is reused
+    const auto t = makeTransform(7);
+    const auto handle = store.allocate(t.position, t.rotation, t.scale);
+    REQUIRE(handle == handles[1]);
+    REQUIRE(store.update() == 1);
+    REQUIRE(equal(store.getMatrix(handle), compose(t)));
+
+    store.clear();
+    REQUIRE(store.size() == 0);
+    REQUIRE(store.update() == 0);
+}